@@ -14,6 +14,20 @@ CPMAddPackage(
     OPTIONS "INSTALL_GTEST OFF"
 )
 
+############################################################################################################################
+# google benchmark
+############################################################################################################################
+CPMAddPackage(
+    NAME benchmark
+    GITHUB_REPOSITORY google/benchmark
+    GIT_TAG v1.7.1
+    VERSION 1.7.1
+    OPTIONS
+        "BENCHMARK_ENABLE_TESTING OFF"
+        "BENCHMARK_ENABLE_GTEST_TESTS OFF"
+        "BENCHMARK_ENABLE_INSTALL OFF"
+)
+
 ############################################################################################################################
 # yaml-cpp
 ############################################################################################################################
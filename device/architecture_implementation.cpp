@@ -20,4 +20,14 @@ std::unique_ptr<architecture_implementation> architecture_implementation::create
     }
 }
 
+const tlb_operations* architecture_implementation::get_tlb_operations(architecture architecture) {
+    switch (architecture) {
+        case architecture::blackhole: return &specialised_tlb_operations<blackhole_implementation>;
+        case architecture::grayskull: return &specialised_tlb_operations<grayskull_implementation>;
+        case architecture::wormhole:
+        case architecture::wormhole_b0: return &specialised_tlb_operations<wormhole_implementation>;
+        default: return nullptr;
+    }
+}
+
 }  // namespace tt::umd
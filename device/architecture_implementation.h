@@ -17,6 +17,18 @@
 
 namespace tt::umd {
 
+//! TLB routines specialised for one architecture, so the per-access path makes no virtual calls.
+/*!
+    Each routine is a plain function calling into a concrete (final) implementation. Resolve the table once per device
+    with architecture_implementation::get_tlb_operations.
+*/
+struct tlb_operations {
+    tlb_setup (*get_dynamic_tlb_setup)(std::uint32_t tlb_index, std::uint64_t address, const tlb_data& data);
+    std::optional<std::tuple<std::uint64_t, std::uint64_t>> (*describe_tlb)(std::int32_t tlb_index);
+    std::pair<std::uint64_t, std::uint64_t> (*get_tlb_data)(std::uint32_t tlb_index, const tlb_data& data);
+    std::tuple<xy_pair, xy_pair> (*multicast_workaround)(xy_pair start, xy_pair end);
+};
+
 class architecture_implementation {
    public:
     virtual ~architecture_implementation() = default;
@@ -63,6 +75,74 @@ class architecture_implementation {
     virtual std::pair<std::uint64_t, std::uint64_t> get_tlb_data(std::uint32_t tlb_index, const tlb_data& data) const = 0;
 
     static std::unique_ptr<architecture_implementation> create(architecture architecture);
+    /**
+     * @brief Get the TLB routines specialised for an architecture, or nullptr if it isn't supported.
+     * Meant to be resolved once per device so the per-access path makes no virtual calls.
+     */
+    static const tlb_operations* get_tlb_operations(architecture architecture);
+};
+
+/**
+ * @brief Compute the config register, register value and BAR window for pointing a dynamic TLB at an address.
+ * Instantiated with a concrete (final) implementation the TLB geometry is folded at compile time; instantiated
+ * with architecture_implementation itself it goes through the vtable.
+ * \param impl Architecture implementation
+ * \param tlb_index Dynamic TLB index
+ * \param address Device address the window should start at
+ * \param data NOC coordinates, ordering and flags. local_offset is overwritten.
+ */
+template <typename arch_impl_t>
+tlb_setup get_dynamic_tlb_setup(
+    const arch_impl_t& impl, std::uint32_t tlb_index, std::uint64_t address, const tlb_data& data) {
+    const tlb_configuration config = impl.get_tlb_configuration(tlb_index);
+    const std::uint32_t cfg_reg_size = impl.get_tlb_cfg_reg_size_bytes();
+    const std::uint64_t local_offset = address % config.size;
+    const std::uint64_t tlb_base = config.base + (config.size * config.index_offset);
+
+    tlb_data cfg = data;
+    cfg.local_offset = address / config.size;
+    return tlb_setup{
+        .bar_offset = tlb_base + local_offset,
+        .remaining_size = config.size - local_offset,
+        .cfg_reg = config.cfg_addr + (cfg_reg_size * config.index_offset),
+        .cfg_reg_size = cfg_reg_size,
+        .cfg_data = cfg.apply_offset(config.offset),
+    };
+}
+
+template <typename arch_impl_t>
+const arch_impl_t& get_static_implementation() {
+    static const arch_impl_t impl{};
+    return impl;
+}
+
+template <typename arch_impl_t>
+tlb_setup get_dynamic_tlb_setup(std::uint32_t tlb_index, std::uint64_t address, const tlb_data& data) {
+    return get_dynamic_tlb_setup(get_static_implementation<arch_impl_t>(), tlb_index, address, data);
+}
+
+template <typename arch_impl_t>
+std::optional<std::tuple<std::uint64_t, std::uint64_t>> describe_tlb(std::int32_t tlb_index) {
+    return get_static_implementation<arch_impl_t>().describe_tlb(tlb_index);
+}
+
+template <typename arch_impl_t>
+std::pair<std::uint64_t, std::uint64_t> get_tlb_data(std::uint32_t tlb_index, const tlb_data& data) {
+    return get_static_implementation<arch_impl_t>().get_tlb_data(tlb_index, data);
+}
+
+template <typename arch_impl_t>
+std::tuple<xy_pair, xy_pair> multicast_workaround(xy_pair start, xy_pair end) {
+    return get_static_implementation<arch_impl_t>().multicast_workaround(start, end);
+}
+
+// Instantiated with a concrete (final) implementation, for architecture_implementation::get_tlb_operations
+template <typename arch_impl_t>
+inline constexpr tlb_operations specialised_tlb_operations = {
+    .get_dynamic_tlb_setup = &get_dynamic_tlb_setup<arch_impl_t>,
+    .describe_tlb = &describe_tlb<arch_impl_t>,
+    .get_tlb_data = &get_tlb_data<arch_impl_t>,
+    .multicast_workaround = &multicast_workaround<arch_impl_t>,
 };
 
 }  // namespace tt::umd
@@ -167,7 +167,7 @@ static constexpr uint32_t MSG_TYPE_SETUP_IATU_FOR_PEER_TO_PEER = 0x97;
 
 }  // namespace blackhole
 
-class blackhole_implementation : public architecture_implementation {
+class blackhole_implementation final : public architecture_implementation {
    public:
     architecture get_architecture() const override { return architecture::blackhole; }
     uint32_t get_arc_message_arc_get_harvesting() const override {
@@ -228,4 +228,37 @@ class blackhole_implementation : public architecture_implementation {
     std::pair<std::uint64_t, std::uint64_t> get_tlb_data(std::uint32_t tlb_index, const tlb_data& data) const override;
 };
 
+inline std::tuple<xy_pair, xy_pair> blackhole_implementation::multicast_workaround(xy_pair start, xy_pair end) const {
+    // TODO: This is copied from wormhole_implementation. It should be implemented properly.
+
+    // When multicasting there is a rare case where including the multicasting node in the box can result in a backup
+    // and the multicasted data not reaching all endpoints specified. As a workaround we exclude the pci endpoint from
+    // the multicast. This doesn't cause any problems with making some tensix cores inaccessible because column 0 (which
+    // we are excluding) doesn't have tensix.
+    start.x = start.x == 0 ? 1 : start.x;
+    return std::make_tuple(start, end);
+}
+
+inline tlb_configuration blackhole_implementation::get_tlb_configuration(uint32_t tlb_index) const {
+
+    // If TLB index is in range for 4GB tlbs (8 TLBs after 202 TLBs for 2MB)
+    if (tlb_index >= blackhole::TLB_COUNT_2M && tlb_index < blackhole::TLB_COUNT_2M + blackhole::TLB_COUNT_4G) {
+        return tlb_configuration {
+            .size = blackhole::DYNAMIC_TLB_4G_SIZE,
+            .base = blackhole::DYNAMIC_TLB_4G_BASE,
+            .cfg_addr = blackhole::DYNAMIC_TLB_4G_CFG_ADDR,
+            .index_offset = tlb_index - blackhole::TLB_BASE_INDEX_4G,
+            .offset = blackhole::TLB_4G_OFFSET,
+        };
+    }
+    
+    return tlb_configuration{
+        .size = blackhole::DYNAMIC_TLB_2M_SIZE,
+        .base = blackhole::DYNAMIC_TLB_2M_BASE,
+        .cfg_addr = blackhole::DYNAMIC_TLB_2M_CFG_ADDR,
+        .index_offset = tlb_index - blackhole::TLB_BASE_INDEX_2M,
+        .offset = blackhole::TLB_2M_OFFSET,
+    };
+}
+
 }  // namespace tt::umd
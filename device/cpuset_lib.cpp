@@ -39,6 +39,51 @@ int get_allowed_num_threads(){
     return num_threads;
 }
 
+std::vector<int> get_io_worker_cpus(hwloc_topology_t topology, hwloc_obj_t pci_device_obj, int num_workers){
+    std::vector<int> cpus = {};
+    if (num_workers <= 0){
+        return cpus;
+    }
+
+    hwloc_obj_t local_obj = pci_device_obj ? hwloc_get_non_io_ancestor_obj(topology, pci_device_obj) : nullptr;
+    hwloc_bitmap_t local_cpuset = hwloc_bitmap_dup(local_obj ? local_obj->cpuset : hwloc_topology_get_topology_cpuset(topology));
+    hwloc_bitmap_and(local_cpuset, local_cpuset, hwloc_topology_get_allowed_cpuset(topology));
+
+    // CPU domains sharing an L3, or all local CPUs if there is no L3 in the topology.
+    std::vector<hwloc_const_cpuset_t> domains = {};
+    int num_l3 = hwloc_get_nbobjs_inside_cpuset_by_type(topology, local_cpuset, HWLOC_OBJ_L3CACHE);
+    for (int l3_idx = 0; l3_idx < num_l3; l3_idx++){
+        domains.push_back(hwloc_get_obj_inside_cpuset_by_type(topology, local_cpuset, HWLOC_OBJ_L3CACHE, l3_idx)->cpuset);
+    }
+    if (domains.empty()){
+        domains.push_back(local_cpuset);
+    }
+
+    // First PU of each core in every domain.
+    std::vector<std::vector<int>> cores_per_domain = {};
+    for (auto domain : domains){
+        std::vector<int> cores = {};
+        int num_cores = hwloc_get_nbobjs_inside_cpuset_by_type(topology, domain, HWLOC_OBJ_CORE);
+        for (int core_idx = 0; core_idx < num_cores; core_idx++){
+            auto core = hwloc_get_obj_inside_cpuset_by_type(topology, domain, HWLOC_OBJ_CORE, core_idx);
+            cores.push_back(hwloc_bitmap_first(core->cpuset));
+        }
+        if (!cores.empty()){
+            cores_per_domain.push_back(cores);
+        }
+    }
+    hwloc_bitmap_free(local_cpuset);
+
+    if (cores_per_domain.empty()){
+        return cpus;
+    }
+    for (int worker = 0; worker < num_workers; worker++){
+        const auto& cores = cores_per_domain.at(worker % cores_per_domain.size());
+        cpus.push_back(cores.at((worker / cores_per_domain.size()) % cores.size()));
+    }
+    return cpus;
+}
+
 
 /////////////////////////////////////////////////////////////////////////
 // Initialization Functions /////////////////////////////////////////////
@@ -101,6 +146,7 @@ bool tt_cpuset_allocator::init_topology_init_and_load(){
         return false;
     }
 
+    m_topology_loaded = true;
     return true; // Success
 }
 
@@ -588,6 +634,38 @@ void tt_cpuset_allocator::_set_main_thread_id(){
     log_debug(LogSiliconDriver,"Captured main_thread_id: {}", m_main_thread_id);
 }
 
+std::vector<int> tt_cpuset_allocator::_get_io_worker_cpus_for_device(chip_id_t physical_device_id, int num_workers){
+
+    if (!m_topology_loaded || m_physical_device_id_to_pci_bus_id_map.count(physical_device_id) == 0){
+        log_debug(LogSiliconDriver, "get_io_worker_cpus_for_device(): physical_device_id: {} not found in topology, I/O workers won't be pinned.", physical_device_id);
+        return {};
+    }
+
+    auto pci_device_obj = hwloc_get_pcidev_by_busidstring(m_topology, m_physical_device_id_to_pci_bus_id_map.at(physical_device_id).c_str());
+    auto cpus = get_io_worker_cpus(m_topology, pci_device_obj, num_workers);
+    log_debug(LogSiliconDriver, "get_io_worker_cpus_for_device(): physical_device_id: {} num_workers: {} => PU's {}", physical_device_id, num_workers, cpus);
+    return cpus;
+}
+
+bool tt_cpuset_allocator::_bind_thread_to_cpu(int cpu){
+
+    if (!m_topology_loaded){
+        return false;
+    }
+
+    auto tid = std::this_thread::get_id();
+    hwloc_cpuset_t cpuset = hwloc_bitmap_alloc();
+    hwloc_bitmap_only(cpuset, cpu);
+    bool success = hwloc_set_cpubind(m_topology, cpuset, HWLOC_CPUBIND_THREAD | HWLOC_CPUBIND_STRICT) == 0;
+    if (!success){
+        log_warning(LogSiliconDriver,"bind_thread_to_cpu() binding failed (errno: {}) to PU: {} (pid: {} tid: {})", strerror(errno), cpu, m_pid, tid);
+    }else{
+        log_debug(LogSiliconDriver,"bind_thread_to_cpu() binding success to PU: {} (pid: {} tid: {})", cpu, m_pid, tid);
+    }
+    hwloc_bitmap_free(cpuset);
+    return success;
+}
+
 int tt_cpuset_allocator::_get_num_tt_pci_devices() {
 
     for (auto &d : m_physical_device_id_to_package_id_map) {
@@ -26,6 +26,15 @@ namespace cpuset {
 
 int get_allowed_num_threads();
 
+/**
+ * @brief CPUs (PU os indices) to pin the I/O worker threads of a PCI device to, one per worker.
+ * Workers are placed on the allowed CPUs local to the device's root complex (the cpuset of its closest non-IO ancestor,
+ * ex: its package or NUMA node), one core per worker, round robin over the L3 caches of those CPUs so that workers only
+ * share an L3 once every L3 has one. Only the first PU of each core is used, so workers never share a core through SMT.
+ * Wraps around if there are more workers than cores. If pci_device_obj is null, all allowed CPUs are used.
+ */
+std::vector<int> get_io_worker_cpus(hwloc_topology_t topology, hwloc_obj_t pci_device_obj, int num_workers);
+
 // CPU ID allocator for pinning threads to cpu_ids
 // It's a singleton that should be retrieved via get()
 struct tt_cpuset_allocator {
@@ -55,6 +64,12 @@ struct tt_cpuset_allocator {
             return instance.bind_area_memory_nodeset(physical_device_id, addr, len);
         }
 
+        // Whether the NUMA node of a device is known, so that memory can be bound to it with bind_area_to_memory_nodeset
+        static bool has_memory_nodeset(chip_id_t physical_device_id){
+            auto& instance = tt_cpuset_allocator::get();
+            return instance.m_physical_device_id_to_numa_nodeset_map.count(physical_device_id) != 0;
+        }
+
         // Store process' main thread_id (not required, mainly for checking purposes to ensure no cpubinds on it occur).
         static void set_main_thread_id(){
             auto& instance = tt_cpuset_allocator::get();
@@ -67,6 +82,19 @@ struct tt_cpuset_allocator {
             return num_cores;
         }
 
+        // CPUs close to a device to pin its I/O worker threads to (see get_io_worker_cpus). Doesn't depend on the cpuset
+        // allocation slots, so it works whenever the device was found in the topology. Empty otherwise.
+        static std::vector<int> get_io_worker_cpus_for_device(chip_id_t physical_device_id, int num_workers){
+            auto& instance = tt_cpuset_allocator::get();
+            return instance._get_io_worker_cpus_for_device(physical_device_id, num_workers);
+        }
+
+        // Pin the calling thread to a single CPU. Threads pinned this way are not tracked for unbinding.
+        static bool bind_thread_to_cpu(int cpu){
+            auto& instance = tt_cpuset_allocator::get();
+            return instance._bind_thread_to_cpu(cpu);
+        }
+
         static int get_num_tt_pci_devices(){
             auto& instance = tt_cpuset_allocator::get();
             return instance._get_num_tt_pci_devices();
@@ -94,6 +122,8 @@ struct tt_cpuset_allocator {
         bool bind_area_memory_nodeset(chip_id_t physical_device_id, const void * addr, size_t len);
         void _set_main_thread_id();
         int _get_num_tt_pci_devices();
+        std::vector<int> _get_io_worker_cpus_for_device(chip_id_t physical_device_id, int num_workers);
+        bool _bind_thread_to_cpu(int cpu);
         int _get_num_tt_pci_devices_by_pci_device_id(uint16_t device_id, uint16_t revision_id);
 
         void clear_state();
@@ -121,6 +151,7 @@ struct tt_cpuset_allocator {
         std::vector<int> get_hwloc_cpuset_vector(hwloc_obj_t &obj);
         std::vector<int> get_hwloc_nodeset_vector(hwloc_obj_t &obj);
         hwloc_topology_t m_topology;
+        bool m_topology_loaded = false;
         bool m_debug;
         bool m_skip_singlify;
         pid_t m_pid;
@@ -6,38 +6,6 @@
 
 namespace tt::umd {
 
-std::tuple<xy_pair, xy_pair> grayskull_implementation::multicast_workaround(xy_pair start, xy_pair end) const {
-    return std::make_tuple(start, end);
-}
-
-tlb_configuration grayskull_implementation::get_tlb_configuration(uint32_t tlb_index) const {
-    if (tlb_index >= grayskull::TLB_BASE_INDEX_16M) {
-        return tlb_configuration{
-            .size = grayskull::DYNAMIC_TLB_16M_SIZE,
-            .base = grayskull::DYNAMIC_TLB_16M_BASE,
-            .cfg_addr = grayskull::DYNAMIC_TLB_16M_CFG_ADDR,
-            .index_offset = tlb_index - grayskull::TLB_BASE_INDEX_16M,
-            .offset = grayskull::TLB_16M_OFFSET,
-        };
-    } else if (tlb_index >= grayskull::TLB_BASE_INDEX_2M) {
-        return tlb_configuration{
-            .size = grayskull::DYNAMIC_TLB_2M_SIZE,
-            .base = grayskull::DYNAMIC_TLB_2M_BASE,
-            .cfg_addr = grayskull::DYNAMIC_TLB_2M_CFG_ADDR,
-            .index_offset = tlb_index - grayskull::TLB_BASE_INDEX_2M,
-            .offset = grayskull::TLB_2M_OFFSET,
-        };
-    } else {
-        return tlb_configuration{
-            .size = grayskull::DYNAMIC_TLB_1M_SIZE,
-            .base = grayskull::DYNAMIC_TLB_1M_BASE,
-            .cfg_addr = grayskull::DYNAMIC_TLB_1M_CFG_ADDR,
-            .index_offset = tlb_index - grayskull::TLB_BASE_INDEX_1M,
-            .offset = grayskull::TLB_1M_OFFSET,
-        };
-    }
-}
-
 std::optional<std::tuple<std::uint64_t, std::uint64_t>> grayskull_implementation::describe_tlb(
     std::int32_t tlb_index) const {
     std::uint32_t TLB_COUNT_1M = 156;
@@ -171,7 +171,7 @@ static constexpr uint32_t TENSIX_SOFT_RESET_ADDR = 0xFFB121B0;
 
 }  // namespace grayskull
 
-class grayskull_implementation : public architecture_implementation {
+class grayskull_implementation final : public architecture_implementation {
    public:
     architecture get_architecture() const override { return architecture::grayskull; }
     uint32_t get_arc_message_arc_get_harvesting() const override {
@@ -232,4 +232,36 @@ class grayskull_implementation : public architecture_implementation {
     std::pair<std::uint64_t, std::uint64_t> get_tlb_data(std::uint32_t tlb_index, const tlb_data& data) const override;
 };
 
+inline std::tuple<xy_pair, xy_pair> grayskull_implementation::multicast_workaround(xy_pair start, xy_pair end) const {
+    return std::make_tuple(start, end);
+}
+
+inline tlb_configuration grayskull_implementation::get_tlb_configuration(uint32_t tlb_index) const {
+    if (tlb_index >= grayskull::TLB_BASE_INDEX_16M) {
+        return tlb_configuration{
+            .size = grayskull::DYNAMIC_TLB_16M_SIZE,
+            .base = grayskull::DYNAMIC_TLB_16M_BASE,
+            .cfg_addr = grayskull::DYNAMIC_TLB_16M_CFG_ADDR,
+            .index_offset = tlb_index - grayskull::TLB_BASE_INDEX_16M,
+            .offset = grayskull::TLB_16M_OFFSET,
+        };
+    } else if (tlb_index >= grayskull::TLB_BASE_INDEX_2M) {
+        return tlb_configuration{
+            .size = grayskull::DYNAMIC_TLB_2M_SIZE,
+            .base = grayskull::DYNAMIC_TLB_2M_BASE,
+            .cfg_addr = grayskull::DYNAMIC_TLB_2M_CFG_ADDR,
+            .index_offset = tlb_index - grayskull::TLB_BASE_INDEX_2M,
+            .offset = grayskull::TLB_2M_OFFSET,
+        };
+    } else {
+        return tlb_configuration{
+            .size = grayskull::DYNAMIC_TLB_1M_SIZE,
+            .base = grayskull::DYNAMIC_TLB_1M_BASE,
+            .cfg_addr = grayskull::DYNAMIC_TLB_1M_CFG_ADDR,
+            .index_offset = tlb_index - grayskull::TLB_BASE_INDEX_1M,
+            .offset = grayskull::TLB_1M_OFFSET,
+        };
+    }
+}
+
 }  // namespace tt::umd
@@ -14,6 +14,17 @@ DEVICE_SRCS = \
   device/blackhole_implementation.cpp \
   device/grayskull_implementation.cpp \
   device/tlb.cpp \
+  device/tt_arc_msg.cpp \
+  device/tt_device_bringup.cpp \
+  device/tt_eth_queue.cpp \
+  device/tt_host_buffer.cpp \
+  device/tt_hugepage_channel.cpp \
+  device/tt_io_worker_pool.cpp \
+  device/tt_membar.cpp \
+  device/tt_sysmem_allocator.cpp \
+  device/tt_sysmem_map.cpp \
+  device/tt_sysmem_ring.cpp \
+  device/tt_sysmem_streaming.cpp \
   device/wormhole_implementation.cpp \
 
 DEVICE_INCLUDES=      	\
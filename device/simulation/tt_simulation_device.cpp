@@ -51,6 +51,10 @@ tt_SimulationDevice::~tt_SimulationDevice() {
 
 // Setup/Teardown Functions
 std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_SimulationDevice::get_virtual_soc_descriptors() {
+    return get_soc_descriptor_copies();
+}
+
+const tt_soc_descriptor_map& tt_SimulationDevice::get_virtual_soc_descriptor_map() {
     return soc_descriptor_per_chip;
 }
 
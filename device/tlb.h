@@ -56,4 +56,13 @@ struct tlb_configuration {
     tlb_offsets offset;
 };
 
+// Everything needed to program one dynamic TLB and access the window it opens.
+struct tlb_setup {
+    uint64_t bar_offset;
+    uint64_t remaining_size;
+    uint32_t cfg_reg;
+    uint32_t cfg_reg_size;
+    std::pair<uint64_t, uint64_t> cfg_data;
+};
+
 }  // namespace tt::umd
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_arc_msg.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include "common/logger.hpp"
+
+tt_arc_mailbox::tt_arc_mailbox() : tt_arc_mailbox(getpid()) {}
+
+tt_arc_mailbox::tt_arc_mailbox(int process_id) : process_id(process_id) {}
+
+tt_arc_msg_token tt_arc_mailbox::post(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, chip_id_t chip, std::uint32_t msg_code,
+                                      std::uint32_t arg0, std::uint32_t arg1, int timeout) {
+    tt_arc_msg_token token = {};
+    tt_arc_msg_backoff backoff = {};
+    while (!try_post(io, regs, chip, msg_code, arg0, arg1, timeout, token)) {
+        backoff.wait();
+    }
+    return token;
+}
+
+bool tt_arc_mailbox::is_marked_by_other_process(const tt_arc_msg_in_flight_marker& marker) const {
+    if (marker.owner_pid == 0 || marker.owner_pid == process_id) {
+        return false;
+    }
+    if (std::chrono::steady_clock::now().time_since_epoch() >= std::chrono::nanoseconds(marker.deadline_ns)) {
+        return false;
+    }
+    // A process that exited with a message in flight doesn't hold the mailbox
+    return kill(marker.owner_pid, 0) == 0 || errno == EPERM;
+}
+
+bool tt_arc_mailbox::try_post(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, chip_id_t chip, std::uint32_t msg_code,
+                              std::uint32_t arg0, std::uint32_t arg1, int timeout, tt_arc_msg_token& token) {
+    if ((msg_code & 0xff00) != 0xaa00) {
+        log_error("Malformed message. msg_code is 0x{:x} but should be 0xaa..", msg_code);
+    }
+    log_assert(arg0 <= 0xffff and arg1 <= 0xffff, "Only 16 bits allowed in arc_msg args"); // Only 16 bits are allowed
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    // Writing the message would overwrite the reply of the one in flight.
+    if (in_flight && !poll_in_flight(io, regs)) {
+        return false;
+    }
+    tt_arc_msg_in_flight_marker* marker = io.get_in_flight_marker();
+    if (marker != nullptr && is_marked_by_other_process(*marker)) {
+        return false;
+    }
+
+    token = {};
+    token.chip = chip;
+    token.msg_code = msg_code;
+    token.timeout = timeout;
+    token.reply = std::make_shared<tt_arc_msg_reply>();
+
+    const std::uint32_t fw_arg = arg0 | (arg1 << 16);
+    io.write_reg(regs.scratch + 3 * 4, fw_arg);
+    io.write_reg(regs.scratch + 5 * 4, msg_code);
+    io.flush_writes();
+
+    const std::uint32_t misc = io.read_reg(regs.misc_cntl);
+    if (misc & (1 << 16)) {
+        log_error("trigger_fw_int failed on device {}", chip);
+        token.complete = true;
+        token.exit_code = 1;
+        return true;
+    }
+    io.write_reg(regs.misc_cntl, misc | (1 << 16));
+
+    token.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout);
+    if (marker != nullptr) {
+        marker->owner_pid = process_id;
+        marker->deadline_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(token.deadline.time_since_epoch()).count();
+    }
+    in_flight = token;
+    return true;
+}
+
+bool tt_arc_mailbox::poll_in_flight(tt_arc_msg_io& io, const tt_arc_msg_regs& regs) {
+    tt_arc_msg_reply& reply = *in_flight->reply;
+    const std::uint32_t status = io.read_reg(regs.scratch + 5 * 4);
+    if ((status & 0xffff) == (in_flight->msg_code & 0xff)) {
+        reply.return_3 = io.read_reg(regs.scratch + 3 * 4);
+        reply.return_4 = io.read_reg(regs.scratch + 4 * 4);
+        reply.exit_code = (status & 0xffff0000) >> 16;
+        reply.received = true;
+    } else if (status == TT_ARC_MSG_ERROR_REPLY) {
+        log_warning(tt::LogSiliconDriver, "On device {}, message code 0x{:x} not recognized by FW", in_flight->chip, in_flight->msg_code);
+        reply.exit_code = TT_ARC_MSG_ERROR_REPLY;
+        reply.received = true;
+    } else if (std::chrono::steady_clock::now() > in_flight->deadline) {
+        reply.timed_out = true;
+    } else {
+        return false;
+    }
+    in_flight.reset();
+    tt_arc_msg_in_flight_marker* marker = io.get_in_flight_marker();
+    if (marker != nullptr && marker->owner_pid == process_id) {
+        *marker = {};
+    }
+    return true;
+}
+
+bool tt_arc_mailbox::test(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, tt_arc_msg_token& token) {
+    if (token.complete) {
+        return true;
+    }
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (in_flight && in_flight->reply == token.reply) {
+        poll_in_flight(io, regs);
+    }
+    const tt_arc_msg_reply& reply = *token.reply;
+    if (reply.timed_out) {
+        std::stringstream ss;
+        ss << std::hex << token.msg_code;
+        throw std::runtime_error("Timed out after waiting " + std::to_string(token.timeout) + " seconds for device " + std::to_string(token.chip) + " ARC to respond to message 0x" + ss.str());
+    }
+    if (!reply.received) {
+        return false;
+    }
+    token.complete = true;
+    token.exit_code = reply.exit_code;
+    token.return_3 = reply.return_3;
+    token.return_4 = reply.return_4;
+    return true;
+}
+
+bool tt_arc_mailbox::has_message_in_flight() const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    return in_flight.has_value();
+}
+
+int tt_send_arc_msg(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, chip_id_t chip, std::uint32_t msg_code, bool wait_for_done,
+                    std::uint32_t arg0, std::uint32_t arg1, int timeout, std::uint32_t* return_3, std::uint32_t* return_4) {
+    tt_arc_mailbox mailbox = {};
+    tt_arc_msg_token token = mailbox.post(io, regs, chip, msg_code, arg0, arg1, timeout);
+    if (!wait_for_done) {
+        return token.exit_code;
+    }
+    tt_arc_msg_backoff backoff = {};
+    while (!mailbox.test(io, regs, token)) {
+        backoff.wait();
+    }
+    if (return_3 != nullptr) {
+        *return_3 = token.return_3;
+    }
+    if (return_4 != nullptr) {
+        *return_4 = token.return_4;
+    }
+    return token.exit_code;
+}
+
+void tt_arc_msg_backoff::wait() {
+    if (num_polls++ < NUM_SPINS) {
+        return;
+    }
+    std::this_thread::sleep_for(sleep);
+    sleep = std::min(sleep * 2, MAX_SLEEP);
+}
+
+tt_telemetry_cache::tt_telemetry_cache(std::chrono::milliseconds ttl) : ttl(ttl) {}
+
+std::uint32_t tt_telemetry_cache::get(chip_id_t device, std::uint32_t key, const read_fn& read) {
+    std::uint64_t generation = 0;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (ttl.count() <= 0) {
+            generation = CACHING_DISABLED;
+        } else {
+            auto cached = entries.find({device, key});
+            if (cached != entries.end() && std::chrono::steady_clock::now() - cached->second.read_time < ttl) {
+                return cached->second.value;
+            }
+            generation = generations[device];
+        }
+    }
+    if (generation == CACHING_DISABLED) {
+        return read();
+    }
+
+    const auto read_time = std::chrono::steady_clock::now();
+    const std::uint32_t value = read();
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (generations[device] == generation) {
+        entries[{device, key}] = {value, read_time};
+    }
+    return value;
+}
+
+void tt_telemetry_cache::invalidate(chip_id_t device) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    generations[device]++;
+    for (auto it = entries.begin(); it != entries.end();) {
+        it = it->first.first == device ? entries.erase(it) : std::next(it);
+    }
+}
+
+void tt_telemetry_cache::invalidate() {
+    const std::lock_guard<std::mutex> lock(mutex);
+    for (auto& generation : generations) {
+        generation.second++;
+    }
+    entries.clear();
+}
+
+void tt_telemetry_cache::set_ttl(std::chrono::milliseconds ttl) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    this->ttl = ttl;
+    entries.clear();
+}
+
+std::chrono::milliseconds tt_telemetry_cache::get_ttl() const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    return ttl;
+}
+
+std::chrono::milliseconds tt_telemetry_cache::get_default_ttl() {
+    const char* ttl_ms = std::getenv("TT_PCI_TELEMETRY_CACHE_TTL_MS");
+    if (ttl_ms) {
+        return std::chrono::milliseconds(std::max(std::atoi(ttl_ms), 0));
+    }
+    return std::chrono::milliseconds(0);
+}
@@ -0,0 +1,199 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "device/tt_cluster_descriptor_types.h"
+
+// Status ARC firmware writes to the message scratch register for message codes it doesn't recognize.
+static constexpr std::uint32_t TT_ARC_MSG_ERROR_REPLY = 0xFFFFFFFF;
+
+//! Marks a chip's mailbox as busy while a process has a message in flight, for the processes that share the chip.
+/*!
+    Lives in memory shared by those processes, and is only accessed under their cross-process lock. A mark is stale once
+    its deadline passed or the process that set it exited, and is then ignored.
+*/
+struct tt_arc_msg_in_flight_marker {
+    std::int32_t owner_pid = 0; // 0 if no message is in flight
+    std::int64_t deadline_ns = 0; // steady_clock, which is CLOCK_MONOTONIC and shared by all processes
+};
+
+//! Register accessors used to send ARC messages to one chip.
+/*!
+    The driver implements this through BAR reads/writes for MMIO chips and through the ethernet queues for remote chips.
+    Tests implement it with a model of the ARC firmware.
+*/
+class tt_arc_msg_io {
+    public:
+    virtual ~tt_arc_msg_io() = default;
+    virtual std::uint32_t read_reg(std::uint64_t address) = 0;
+    virtual void write_reg(std::uint64_t address, std::uint32_t value) = 0;
+    // Called once the message and its arguments are written, before the firmware interrupt is triggered.
+    virtual void flush_writes() {}
+    // Cross-process marker of the chip's mailbox, or nullptr if the chip isn't shared with other processes.
+    virtual tt_arc_msg_in_flight_marker* get_in_flight_marker() { return nullptr; }
+};
+
+// Addresses of the ARC reset unit registers used for messaging.
+struct tt_arc_msg_regs {
+    std::uint64_t scratch; // ARC_RESET.SCRATCH[0]
+    std::uint64_t misc_cntl; // ARC_RESET.ARC_MISC_CNTL
+};
+
+struct tt_arc_msg_reply {
+    bool received = false;
+    bool timed_out = false;
+    int exit_code = 0;
+    std::uint32_t return_3 = 0;
+    std::uint32_t return_4 = 0;
+};
+
+//! A message posted to ARC firmware, returned by tt_arc_mailbox::post (and tt_SiliconDevice::post_arc_msg).
+struct tt_arc_msg_token {
+    chip_id_t chip = 0;
+    std::uint32_t msg_code = 0;
+    int timeout = 0;
+    std::chrono::steady_clock::time_point deadline = {};
+    // Set once the reply was read, or if the firmware was busy and the message wasn't sent (exit code 1)
+    bool complete = false;
+    int exit_code = 0;
+    std::uint32_t return_3 = 0; // SCRATCH[3] once the message is handled
+    std::uint32_t return_4 = 0; // SCRATCH[4] once the message is handled
+    // Shared with the mailbox while the message is in flight, which fills it in when it reads the reply
+    std::shared_ptr<tt_arc_msg_reply> reply = nullptr;
+
+    bool is_complete() const { return complete; }
+};
+
+//! The ARC message mailbox of one chip, shared by everything in the process that messages the chip.
+/*!
+    The firmware has a single mailbox, so a chip has at most one message in flight. Posting while another message of the
+    process is in flight first waits for that message's reply, and keeps it for the other message's token (which can be
+    dropped, for fire and forget messages). Accesses to the mailbox are serialized here. Callers that share the chip
+    with other processes additionally hold their cross-process lock around each post and test, and pass the chip's
+    in-flight marker through the io: posting waits until no other process has a message in flight, so its reply can't
+    be overwritten. A fire and forget message of another process holds the mailbox until its timeout, unless that
+    process posts or tests on the chip again.
+*/
+class tt_arc_mailbox {
+    public:
+    tt_arc_mailbox();
+    // process_id identifies the process in in-flight markers (getpid() by default)
+    explicit tt_arc_mailbox(int process_id);
+
+    /**
+     * @brief Write the message and its argument to the mailbox and raise the firmware interrupt, waiting for the mailbox
+     * to be free first.
+     * \param msg_code Message code, 0xaa.. for firmware messages
+     * \param arg0 Lower 16 bits of the firmware argument
+     * \param arg1 Upper 16 bits of the firmware argument
+     * \param timeout Seconds (from now) to wait for the reply before test throws
+     */
+    tt_arc_msg_token post(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, chip_id_t chip, std::uint32_t msg_code,
+                          std::uint32_t arg0, std::uint32_t arg1, int timeout);
+    /**
+     * @brief Post the message only if the mailbox is free: the reply of this process's message in flight (polled once)
+     * was read, and no other process has a message in flight. Lets callers release their cross-process lock between
+     * tries, so the process owning the mailbox can read its reply.
+     * \returns false if the mailbox is busy and nothing was written.
+     */
+    bool try_post(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, chip_id_t chip, std::uint32_t msg_code,
+                  std::uint32_t arg0, std::uint32_t arg1, int timeout, tt_arc_msg_token& token);
+    /**
+     * @brief Check (once) whether the firmware replied to the token's message, and fill in the token if it did.
+     * The exit code is TT_ARC_MSG_ERROR_REPLY if the firmware didn't recognize the message. Throws every time it is
+     * called once the message timed out.
+     */
+    bool test(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, tt_arc_msg_token& token);
+    bool has_message_in_flight() const;
+
+    private:
+    // Read the reply of the message in flight once. Returns true once it is no longer in flight.
+    bool poll_in_flight(tt_arc_msg_io& io, const tt_arc_msg_regs& regs);
+    bool is_marked_by_other_process(const tt_arc_msg_in_flight_marker& marker) const;
+
+    const int process_id;
+    mutable std::mutex mutex;
+    std::optional<tt_arc_msg_token> in_flight = std::nullopt;
+};
+
+//! Paces a loop polling the ARC mailbox. The first polls run back to back, since most messages are handled within
+//! microseconds, after which each poll sleeps twice as long as the previous one, up to a millisecond.
+class tt_arc_msg_backoff {
+    public:
+    void wait();
+
+    private:
+    static constexpr int NUM_SPINS = 16;
+    static constexpr std::chrono::microseconds MAX_SLEEP = std::chrono::microseconds(1000);
+
+    int num_polls = 0;
+    std::chrono::microseconds sleep = std::chrono::microseconds(1);
+};
+
+/**
+ * @brief Send a message through a mailbox of its own, and optionally wait for its reply.
+ * For callers that have exclusive access to the chip's ARC registers.
+ * \param return_3 If not null, receives SCRATCH[3] once the message is handled
+ * \param return_4 If not null, receives SCRATCH[4] once the message is handled
+ * \returns The exit code of the message, TT_ARC_MSG_ERROR_REPLY if the firmware didn't recognize it, or 1 if the
+ * firmware interrupt is still pending from an earlier message.
+ */
+int tt_send_arc_msg(tt_arc_msg_io& io, const tt_arc_msg_regs& regs, chip_id_t chip, std::uint32_t msg_code, bool wait_for_done,
+                    std::uint32_t arg0, std::uint32_t arg1, int timeout, std::uint32_t* return_3, std::uint32_t* return_4);
+
+//! Recently read telemetry (ex: clocks) of each device.
+/*!
+    Telemetry is read from ARC through a message round trip, which costs milliseconds per device. Values are served from
+    the cache until they are older than the TTL. A TTL of zero disables caching. Reads happen outside of the cache lock,
+    so different devices (and keys) are read concurrently. A value read while the device was invalidated (ex: by a power
+    state change) isn't cached.
+*/
+class tt_telemetry_cache {
+    public:
+    using read_fn = std::function<std::uint32_t()>;
+
+    explicit tt_telemetry_cache(std::chrono::milliseconds ttl = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Cached value of key on device, calls read to refresh it if it is missing or expired.
+     * Exceptions thrown by read are propagated, and nothing is cached.
+     */
+    std::uint32_t get(chip_id_t device, std::uint32_t key, const read_fn& read);
+    void invalidate(chip_id_t device);
+    void invalidate();
+
+    void set_ttl(std::chrono::milliseconds ttl);
+    std::chrono::milliseconds get_ttl() const;
+
+    /**
+     * @brief TTL to use for the driver's telemetry. Disabled unless set through TT_PCI_TELEMETRY_CACHE_TTL_MS.
+     */
+    static std::chrono::milliseconds get_default_ttl();
+
+    private:
+    struct entry {
+        std::uint32_t value;
+        std::chrono::steady_clock::time_point read_time;
+    };
+
+    static constexpr std::uint64_t CACHING_DISABLED = ~std::uint64_t(0);
+
+    mutable std::mutex mutex;
+    std::chrono::milliseconds ttl;
+    std::map<std::pair<chip_id_t, std::uint32_t>, entry> entries = {};
+    // Bumped by every invalidation of a device, so reads that started before it aren't cached.
+    std::map<chip_id_t, std::uint64_t> generations = {};
+};
@@ -28,3 +28,13 @@ tt_device::~tt_device() {
 }
 
 const tt_SocDescriptor *tt_device::get_soc_descriptor(chip_id_t chip) const { return &soc_descriptor_per_chip.at(chip); }
+
+std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_device::get_soc_descriptor_copies() {
+  if (soc_descriptor_copies.size() != soc_descriptor_per_chip.size()) {
+    soc_descriptor_copies.clear();
+    for (const auto& chip : soc_descriptor_per_chip) {
+      soc_descriptor_copies.insert({chip.first, *chip.second});
+    }
+  }
+  return soc_descriptor_copies;
+}
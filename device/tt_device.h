@@ -5,13 +5,18 @@
  */
 
 #pragma once
+#include <atomic>
 #include <cassert>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
 #include <set>
+#include <stdexcept>
 
 #include "tt_soc_descriptor.h"
 #include "tt_xy_pair.h"
@@ -19,6 +24,13 @@
 #include "device/tt_cluster_descriptor_types.h"
 #include "device/tlb.h"
 #include "device/tt_io.hpp"
+#include "device/tt_arc_msg.h"
+#include "device/tt_host_buffer.h"
+#include "device/tt_membar.h"
+#include "device/tt_sysmem_allocator.h"
+#include "device/tt_sysmem_map.h"
+#include "device/tt_sysmem_streaming.h"
+#include "device/tt_sysmem_ring.h"
 
 using TLB_OFFSETS = tt::umd::tlb_offsets;
 using TLB_DATA = tt::umd::tlb_data;
@@ -26,6 +38,7 @@ using TLB_DATA = tt::umd::tlb_data;
 
 namespace boost::interprocess{
     class named_mutex;
+    class mapped_region;
 }
 
 class PCIDevice;
@@ -472,6 +485,14 @@ class tt_device
     virtual std::unordered_map<chip_id_t, tt_SocDescriptor>& get_virtual_soc_descriptors() {
         throw std::runtime_error("---- tt_device:get_virtual_soc_descriptors is not implemented\n");
     }
+    /**
+    * @brief Query post harvesting SOC descriptors from UMD in virtual coordinates, without copying them.
+    * Same descriptors as get_virtual_soc_descriptors(), but chips with the same layout share one immutable descriptor.
+    * \returns A map of shared SOC Descriptors per chip.
+    */
+    virtual const tt_soc_descriptor_map& get_virtual_soc_descriptor_map() {
+        throw std::runtime_error("---- tt_device:get_virtual_soc_descriptor_map is not implemented\n");
+    }
    
     /**
     * @brief Determine if UMD performed harvesting on SOC descriptors.
@@ -673,7 +694,14 @@ class tt_device
     bool tlbs_init = false;
 
     protected:
-    std::unordered_map<chip_id_t, tt_SocDescriptor> soc_descriptor_per_chip = {};
+    // Per chip copies of soc_descriptor_per_chip, handed out by get_virtual_soc_descriptors(). Built on first use, and
+    // rebuilt when chips are added or removed.
+    std::unordered_map<chip_id_t, tt_SocDescriptor>& get_soc_descriptor_copies();
+
+    tt_soc_descriptor_map soc_descriptor_per_chip = {};
+
+    private:
+    std::unordered_map<chip_id_t, tt_SocDescriptor> soc_descriptor_copies = {};
 };
 
 class c_versim_core;
@@ -694,6 +722,7 @@ class tt_VersimDevice: public tt_device
     virtual void set_device_dram_address_params(const tt_device_dram_address_params& dram_address_params_);
     tt_VersimDevice(const std::string &sdesc_path, const std::string &ndesc_path);
     virtual std::unordered_map<chip_id_t, tt_SocDescriptor>& get_virtual_soc_descriptors();
+    virtual const tt_soc_descriptor_map& get_virtual_soc_descriptor_map();
     virtual void start(std::vector<std::string> plusargs, std::vector<std::string> dump_cores, bool no_checkers, bool init_device, bool skip_driver_allocs);
     virtual void start_device(const tt_device_params &device_params);
     virtual void close_device();
@@ -738,11 +767,142 @@ class tt_VersimDevice: public tt_device
 };
 
 #include "device/architecture_implementation.h"
+#include "device/tt_device_bringup.h"
+#include "device/tt_hugepage_channel.h"
+#include "device/tt_io_worker_pool.h"
+
+/**
+ * @brief Flat lookup table translating the NOC coordinates of a single chip to the coordinates programmed into TLBs.
+ * Translated coordinates are stored row major (y * grid_size.x + x). Identity tables (unharvested chips or chips without
+ * NOC translation) store no entries and only bounds check the input.
+*/
+struct tt_coord_translation_table {
+    tt_xy_pair grid_size = tt_xy_pair(0, 0);
+    bool identity = true;
+    std::vector<tt_xy_pair> translated_coords = {};
+
+    bool in_grid(const tt_xy_pair& core) const {
+        return core.x < grid_size.x && core.y < grid_size.y;
+    }
+    tt_xy_pair translate(const tt_xy_pair& core) const {
+        if (!in_grid(core)) {
+            throw std::out_of_range("Core " + core.str() + " is outside of the " + grid_size.str() + " coordinate translation grid");
+        }
+        return identity ? core : translated_coords[core.y * grid_size.x + core.x];
+    }
+    /**
+     * @brief Translate a batch of cores up front, so that callers issuing many transactions can skip per access lookups.
+     * \param cores Cores to translate. May alias translated.
+     * \param translated Output buffer holding at least num_cores entries.
+    */
+    void translate(const tt_xy_pair* cores, tt_xy_pair* translated, std::size_t num_cores) const {
+        for (std::size_t i = 0; i < num_cores; i++) {
+            translated[i] = translate(cores[i]);
+        }
+    }
+};
+
+/**
+ * @brief Static TLB mapped to a single core. The TLB window is resolved when static TLBs are setup,
+ * so accesses through it don't need to query the core to TLB mapping or the architecture.
+*/
+struct tt_static_tlb_entry {
+    std::int32_t tlb_index = -1;
+    std::uint64_t bar_offset = 0;
+    std::uint64_t size = 0;
+    // Device address the TLB window starts at. Only valid once the TLB has been configured.
+    std::uint64_t mapped_base = 0;
+    bool configured = false;
+
+    bool contains(std::uint64_t address, std::uint64_t size_in_bytes) const {
+        return configured && address >= mapped_base && address + size_in_bytes <= mapped_base + size;
+    }
+};
+
+/**
+ * @brief Dense per chip table holding the static TLB entry for each core in the NOC grid, stored row major (y * grid_size.x + x).
+*/
+struct tt_static_tlb_table {
+    tt_xy_pair grid_size = tt_xy_pair(0, 0);
+    std::vector<tt_static_tlb_entry> entries = {};
+
+    /**
+     * @brief Build the table by resolving the TLB window of every core in the grid.
+     * \param architecture_implementation Architecture used to describe the TLB windows.
+     * \param mapping_function Function mapping a core to its static TLB index, or -1 if the core does not have a static TLB.
+     * \param configured_tlbs Map of TLB index to the device address base each TLB was already configured to.
+    */
+    static tt_static_tlb_table create(const tt::umd::architecture_implementation* architecture_implementation, const std::function<std::int32_t(tt_xy_pair)>& mapping_function,
+                                      const std::unordered_map<std::int32_t, std::uint64_t>& configured_tlbs = {});
+    // Record that tlb_index now maps the device address window starting at mapped_base.
+    void configure(std::int32_t tlb_index, std::uint64_t mapped_base);
+
+    // Returns the static TLB entry for a core, or nullptr if the core does not have a static TLB.
+    const tt_static_tlb_entry* get(const tt_xy_pair& core) const {
+        if (core.x >= grid_size.x || core.y >= grid_size.y) {
+            return nullptr;
+        }
+        const tt_static_tlb_entry& entry = entries[core.y * grid_size.x + core.x];
+        return entry.tlb_index < 0 ? nullptr : &entry;
+    }
+};
+
+/**
+ * @brief Cores of one chip written directly over PCIe (or through write_to_device) by a broadcast.
+*/
+struct tt_broadcast_chip_targets {
+    chip_id_t chip = 0;
+    // Rectangles written with one multicast each
+    std::vector<tt_multicast_grid> grids = {};
+    std::vector<tt_xy_pair> unicast_cores = {};
+};
+
+/**
+ * @brief Precomputed broadcast to a fixed set of chips, rows and columns. Created by tt_SiliconDevice::create_broadcast_plan.
+ * Holds the ethernet broadcast headers (with the row/col exclusion masks applied) and the grids/cores written by the
+ * software fallback, so repeated broadcasts to the same targets skip all per call setup.
+*/
+struct tt_broadcast_plan {
+    // Chips reached by the broadcast
+    std::set<chip_id_t> target_chips = {};
+    // Ethernet broadcasts issued in order. Each one maps an MMIO chip to the headers sent through it.
+    std::vector<std::unordered_map<chip_id_t, std::vector<std::vector<int>>>> ethernet_broadcasts = {};
+    // Chips written directly, grouped by the MMIO chip they are reached through
+    std::map<chip_id_t, std::vector<tt_broadcast_chip_targets>> direct_writes_per_gateway = {};
+};
+
+//! Writes of one broadcast, issued by tt_issue_broadcast. Implemented by the driver, and by tests and benchmarks that
+//! run broadcast plans without hardware.
+class tt_broadcast_io {
+    public:
+    virtual ~tt_broadcast_io() = default;
+    // Send the payload through the ethernet queues of an MMIO chip, to the chips and cores selected by header
+    virtual void write_ethernet_broadcast(chip_id_t mmio_chip, const std::vector<int>& header) = 0;
+    // Write the payload to every core of the [start, end] rectangle of chip with one multicast
+    virtual void multicast_write(chip_id_t chip, const tt_xy_pair& start, const tt_xy_pair& end) = 0;
+    virtual void write(chip_id_t chip, const tt_xy_pair& core) = 0;
+};
+
+/**
+ * @brief Issue the writes of a broadcast plan through io.
+ * Each MMIO group of an ethernet broadcast is sent through its own gateway's queues, so groups are written
+ * concurrently (through fan_out). Headers within a group stay ordered, and each ethernet broadcast completes before the
+ * next one is issued. Chips written directly are written concurrently across their gateways.
+ */
+void tt_issue_broadcast(tt_broadcast_io& io, tt_mmio_fan_out& fan_out, const tt_broadcast_plan& plan);
 
 /**
  * @brief Silicon Driver Class, derived from the tt_device class
  * Implements APIs to communicate with a physical Tenstorrent Device.
 */ 
+//! One write of a batch passed to tt_SiliconDevice::write_to_device_async.
+struct tt_device_write {
+    const void* mem_ptr;
+    std::uint32_t size_in_bytes;
+    tt_cxy_pair core;
+    std::uint64_t addr;
+};
+
 class tt_SiliconDevice: public tt_device
 {
     public:
@@ -765,6 +925,7 @@ class tt_SiliconDevice: public tt_device
     
     //Setup/Teardown Functions
     virtual std::unordered_map<chip_id_t, tt_SocDescriptor>& get_virtual_soc_descriptors();
+    virtual const tt_soc_descriptor_map& get_virtual_soc_descriptor_map();
     virtual void set_device_l1_address_params(const tt_device_l1_address_params& l1_address_params_);
     virtual void set_device_dram_address_params(const tt_device_dram_address_params& dram_address_params_);
     virtual void set_driver_host_address_params(const tt_driver_host_address_params& host_address_params_);
@@ -778,12 +939,29 @@ class tt_SiliconDevice: public tt_device
     virtual void deassert_risc_reset();
     virtual void deassert_risc_reset_at_core(tt_cxy_pair core);
     virtual void assert_risc_reset_at_core(tt_cxy_pair core);
+    /**
+     * @brief Set the soft reset state of a set of Tensix and Ethernet cores on one chip.
+     * On MMIO chips, rectangles of Tensix cores are reset through a single multicast, and all writes are posted back to back.
+     * Remote chips can't be multicast to, so each core still costs one ethernet round trip.
+     * \param cores Cores to reset. Must be Tensix or Ethernet cores that are not harvested.
+     * \param soft_resets Reset state to set for the RISCs of each core
+     */
+    void set_risc_reset_state(chip_id_t chip, const std::unordered_set<tt_xy_pair>& cores, const TensixSoftResetOptions& soft_resets);
     virtual void close_device();
 
     // Runtime Functions
     virtual void write_to_device(const void *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair core, uint64_t addr, const std::string& tlb_to_use, bool send_epoch_cmd = false, bool last_send_epoch_cmd = true, bool ordered_with_prev_remote_write = false);
     virtual void write_to_device(std::vector<uint32_t> &vec, tt_cxy_pair core, uint64_t addr, const std::string& tlb_to_use, bool send_epoch_cmd = false, bool last_send_epoch_cmd = true, bool ordered_with_prev_remote_write = false);
     void broadcast_write_to_cluster(const void *mem_ptr, uint32_t size_in_bytes, uint64_t address, const std::set<chip_id_t>& chips_to_exclude,  std::set<uint32_t>& rows_to_exclude,  std::set<uint32_t>& columns_to_exclude, const std::string& fallback_tlb);
+    /**
+     * @brief Precompute a broadcast to all chips, rows and columns that aren't excluded.
+     * Performs the same checks as broadcast_write_to_cluster. The plan stays valid for the lifetime of the driver.
+     */
+    tt_broadcast_plan create_broadcast_plan(const std::set<chip_id_t>& chips_to_exclude, const std::set<uint32_t>& rows_to_exclude, const std::set<uint32_t>& columns_to_exclude);
+    /**
+     * @brief Broadcast a buffer to the targets of a plan returned by create_broadcast_plan.
+     */
+    void broadcast_write_to_cluster(const void *mem_ptr, uint32_t size_in_bytes, uint64_t address, const tt_broadcast_plan& plan, const std::string& fallback_tlb);
     virtual void write_epoch_cmd_to_device(const uint32_t *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair core, uint64_t addr, const std::string& tlb_to_use, bool last_send_epoch_cmd, bool ordered_with_prev_remote_write);
     virtual void write_epoch_cmd_to_device(std::vector<uint32_t> &vec, tt_cxy_pair core, uint64_t addr, const std::string& tlb_to_use, bool last_send_epoch_cmd, bool ordered_with_prev_remote_write);
 
@@ -795,10 +973,88 @@ class tt_SiliconDevice: public tt_device
     virtual void write_to_sysmem(const void* mem_ptr, std::uint32_t size,  uint64_t addr, uint16_t channel, chip_id_t src_device_id);
     virtual void read_from_sysmem(std::vector<uint32_t> &vec, uint64_t addr, uint16_t channel, uint32_t size, chip_id_t src_device_id);
     virtual void read_from_sysmem(void* mem_ptr, uint64_t addr, uint16_t channel, uint32_t size, chip_id_t src_device_id);
+    // Vector APIs for buffers with other allocators (ex: tt::numa_vector, from get_numa_allocator). Reads resize vec to
+    // hold size bytes, like the std::vector APIs.
+    template <typename Allocator>
+    void write_to_device(std::vector<uint32_t, Allocator>& vec, tt_cxy_pair core, uint64_t addr, const std::string& tlb_to_use, bool send_epoch_cmd = false, bool last_send_epoch_cmd = true, bool ordered_with_prev_remote_write = false) {
+        write_to_device(vec.data(), vec.size() * sizeof(uint32_t), core, addr, tlb_to_use, send_epoch_cmd, last_send_epoch_cmd, ordered_with_prev_remote_write);
+    }
+    template <typename Allocator>
+    void rolled_write_to_device(std::vector<uint32_t, Allocator>& vec, uint32_t unroll_count, tt_cxy_pair core, uint64_t addr, const std::string& tlb_to_use) {
+        rolled_write_to_device(vec.data(), vec.size() * sizeof(uint32_t), unroll_count, core, addr, tlb_to_use);
+    }
+    template <typename Allocator>
+    void read_from_device(std::vector<uint32_t, Allocator>& vec, tt_cxy_pair core, uint64_t addr, uint32_t size, const std::string& tlb_to_use) {
+        vec.resize((size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+        read_from_device(vec.data(), core, addr, size, tlb_to_use);
+    }
+    template <typename Allocator>
+    void write_to_sysmem(std::vector<uint32_t, Allocator>& vec, uint64_t addr, uint16_t channel, chip_id_t src_device_id) {
+        write_to_sysmem(vec.data(), vec.size() * sizeof(uint32_t), addr, channel, src_device_id);
+    }
+    template <typename Allocator>
+    void read_from_sysmem(std::vector<uint32_t, Allocator>& vec, uint64_t addr, uint16_t channel, uint32_t size, chip_id_t src_device_id) {
+        vec.resize((size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+        read_from_sysmem(vec.data(), addr, channel, size, src_device_id);
+    }
     virtual void wait_for_non_mmio_flush();
     void l1_membar(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores = {});
     void dram_membar(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<uint32_t>& channels);
     void dram_membar(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores = {});
+    /**
+     * @brief Track which cores of each MMIO chip were written since their last memory barrier.
+     * When enabled, l1_membar and dram_membar called without cores or channels only insert barriers on cores written
+     * since their last barrier. Every driver write to device memory marks the cores it writes (before and after issuing
+     * it). Cores handed out through get_static_tlb_writer are written outside of the driver, so they always get a
+     * barrier. Barriers on explicit cores or channels are unchanged. All cores start out dirty.
+     * Must not be called concurrently with writes or memory barriers.
+     */
+    void set_membar_dirty_tracking(bool enable);
+    /**
+     * @brief Post a memory barrier and return without waiting for it to be acknowledged.
+     * Each barrier writes its own flag value, so several barriers can be in flight at once. The flags are posted under
+     * the same interprocess lock as l1_membar/dram_membar, but the lock isn't held until the barrier completes.
+     * The blocking l1_membar/dram_membar overwrite flags with SET/RESET, so they throw while a split phase barrier on the
+     * same chip is in flight in this process. Another process can still overwrite the flags, in which case
+     * test_membar/wait_membar throw once the timeout expires instead of waiting forever.
+     * With dirty tracking enabled, the cores the barrier flushes are marked dirty again if it fails to post, times out
+     * or is dropped before completing.
+     * Barriers on remote chips are not split phase: nothing is posted, and test_membar blocks until the non-MMIO
+     * queues are flushed (like l1_membar/dram_membar).
+     * \param cores Tensix, ethernet or DRAM cores to insert the barrier on. Defaults to all of them (or all dirty ones
+     * if dirty tracking is enabled). Ignored for remote chips.
+     * \param timeout Seconds after posting at which test_membar/wait_membar give up on the barrier and throw
+     */
+    tt_membar_token begin_membar(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores = {}, int timeout = 1);
+    /**
+     * @brief Check (once) whether all cores acknowledged the barrier. For remote chips this blocks until the non-MMIO
+     * queues are flushed, and always returns true.
+     * Throws once the barrier timed out.
+     */
+    bool test_membar(tt_membar_token& token);
+    /**
+     * @brief Poll the barrier until all cores acknowledged it, backing off between polls like ARC message replies.
+     */
+    void wait_membar(tt_membar_token& token);
+    /**
+     * @brief Post a message to ARC and return without waiting for it to be handled. Works for MMIO and remote chips.
+     * The ARC mutex is only held while the mailbox is written or read, so messages to different chips are in flight at the
+     * same time. A chip has a single mailbox: posting while another message to the chip is in flight first waits for
+     * that message's reply, which is kept for its token. Tokens of fire and forget messages can be dropped.
+     * For MMIO chips, a marker in shared memory makes other processes wait until the reply was read (or the message
+     * timed out) before they post. Remote chips have no such marker, so processes that message the same remote chip at
+     * the same time can overwrite each other's replies.
+     * \param timeout Seconds after posting at which test_arc_msg/wait_arc_msg give up on the reply and throw
+     */
+    tt_arc_msg_token post_arc_msg(int logical_device_id, uint32_t msg_code, uint32_t arg0 = 0, uint32_t arg1 = 0, int timeout = 1);
+    /**
+     * @brief Check (once) whether ARC handled the message. The token holds the exit code and return values once it did.
+     */
+    bool test_arc_msg(tt_arc_msg_token& token);
+    /**
+     * @brief Wait for ARC to handle the message, polling with a growing backoff. \returns The exit code of the message.
+     */
+    int wait_arc_msg(tt_arc_msg_token& token);
     // These functions are used by Debuda, so make them public
     void bar_write32 (int logical_device_id, uint32_t addr, uint32_t data);
     uint32_t bar_read32 (int logical_device_id, uint32_t addr);
@@ -847,12 +1103,153 @@ class tt_SiliconDevice: public tt_device
     virtual void *channel_address(std::uint32_t offset, const tt_cxy_pair& target);
     virtual void *host_dma_address(std::uint64_t offset, chip_id_t src_device_id, uint16_t channel) const;
     virtual std::uint64_t get_pcie_base_addr_from_device() const;
+    /**
+     * @brief Place a single producer/single consumer ring in a host memory channel of an MMIO chip.
+     * Devices access the ring at get_pcie_base_addr_from_device() + the channel's base + offset.
+     * \param offset Offset of the ring in the channel. Must be cache line aligned.
+     * \param size Bytes of the channel reserved for the ring, including its counters
+     * \param initialize Reset the ring's counters. Only the side that creates the ring first should do this.
+     */
+    tt_sysmem_ring create_sysmem_ring(chip_id_t mmio_chip, uint16_t channel, std::uint64_t offset, std::uint64_t size, bool initialize = true);
+    /**
+     * @brief Allocator shared by all users of the host memory channels of an MMIO chip.
+     * Created on first use, with every channel set up when the device was started. The driver's scratch region of
+     * channel 0 (ethernet routing buffers and perf scratch, see get_sysmem_arena_size) is never handed out.
+     */
+    tt_sysmem_allocator& get_sysmem_allocator(chip_id_t mmio_chip);
+    /**
+     * @brief Bytes at the start of a host memory channel that get_sysmem_allocator can hand out.
+     * Channel 0 stops at the driver's scratch region, which starts with the ethernet routing buffers and runs to the end
+     * of the channel. Other channels are handed out whole.
+     */
+    static std::uint64_t get_sysmem_arena_size(std::uint16_t channel, std::uint64_t channel_size, const tt_driver_host_address_params& host_address_params);
+    /**
+     * @brief Host view of size bytes at offset in a host memory channel of an MMIO chip, to read or write in place.
+     * The range is bounds checked against the channel once, here. The view is valid until the device is closed.
+     */
+    tt_sysmem_span map_sysmem(chip_id_t mmio_chip, uint16_t channel, std::uint64_t offset, std::uint32_t size) const;
+    /**
+     * @brief Writes to sysmem (write_to_sysmem, write_dma_buffer) of at least threshold bytes bypass the CPU caches with
+     * streaming stores. Defaults to TT_SYSMEM_STREAMING_THRESHOLD, or TT_PCI_SYSMEM_STREAMING_THRESHOLD if set.
+     */
+    void set_sysmem_streaming_threshold(std::size_t threshold) { sysmem_streaming_threshold = threshold; }
+    /**
+     * @brief Clocks (get_clock, get_clocks) read from ARC in the last ttl are reused instead of messaging ARC again.
+     * Disabled (0) by default, or set through TT_PCI_TELEMETRY_CACHE_TTL_MS. Power state changes drop cached values.
+     */
+    void set_telemetry_cache_ttl(std::chrono::milliseconds ttl) { telemetry_cache.set_ttl(ttl); }
+    /**
+     * @brief Start a pool of I/O worker threads for each MMIO chip, pinned to CPUs close to the chip's PCIe root complex.
+     * A chip gets as many workers as cores allocated to it by tt_cpuset_allocator, up to max_workers_per_device (and at
+     * least one). Once started, per-device fan-outs (ex: get_clocks, broadcast_write_to_cluster) and the *_async
+     * transfers and barriers run on the pools.
+     * Called by the constructor if TT_PCI_IO_WORKERS_PER_DEVICE is set. Must not run concurrently with I/O.
+     */
+    void start_io_workers(std::size_t max_workers_per_device);
+    // Run the work queued on the I/O workers and join them. Must not run concurrently with I/O.
+    void stop_io_workers();
+    /**
+     * @brief Run task on an I/O worker of chip (or of its closest MMIO chip, for remote chips).
+     * Runs task in place if I/O workers aren't started, or if called from an I/O worker.
+     * \returns A future that becomes ready once the task ran, and rethrows its exception if it threw.
+     */
+    std::future<void> submit_io(chip_id_t chip, std::function<void()> task);
+    /**
+     * @brief Issue a batch of writes (like write_to_device) on the I/O workers.
+     * Writes are grouped by MMIO chip (remote chips by their closest MMIO chip). Each group runs in order as one task on
+     * its chip's workers, so the groups of different chips are written concurrently. The data must stay valid until the
+     * future is ready. No memory barrier is inserted.
+     * \returns A future that becomes ready once every write was issued, and rethrows the first exception of the batch.
+     */
+    std::future<void> write_to_device_async(std::vector<tt_device_write> writes, const std::string& tlb_to_use);
+    // Read from a core (like read_from_device) on an I/O worker of the chip. mem_ptr must stay valid until the future is ready.
+    std::future<void> read_from_device_async(void* mem_ptr, tt_cxy_pair core, uint64_t addr, uint32_t size, const std::string& fallback_tlb);
+    /**
+     * @brief Run l1_membar (or dram_membar) on an I/O worker of the chip, so the calling thread isn't blocked while the
+     * cores acknowledge the barrier.
+     */
+    std::future<void> l1_membar_async(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores = {});
+    std::future<void> dram_membar_async(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<uint32_t>& channels);
+    /**
+     * @brief Stage data into (or read it back from) a host memory channel of an MMIO chip, like write_to_sysmem and
+     * read_from_sysmem, on one of the chip's I/O workers. They run close to the chip, so the copy stays on its NUMA node.
+     * mem_ptr must stay valid until the future is ready.
+     */
+    std::future<void> write_to_sysmem_async(const void* mem_ptr, std::uint32_t size, uint64_t addr, uint16_t channel, chip_id_t src_device_id);
+    std::future<void> read_from_sysmem_async(void* mem_ptr, uint64_t addr, uint16_t channel, uint32_t size, chip_id_t src_device_id);
+    // Number of I/O workers of an MMIO chip, 0 if I/O workers aren't started.
+    std::size_t get_num_io_workers(chip_id_t mmio_chip) const;
+    /**
+     * @brief Allocate a host buffer to stage transfers to or from chip, bound to the NUMA node closest to the chip's PCIe
+     * device (that of its closest MMIO chip, for remote chips). Left unbound if the node isn't known.
+     * \param use_hugepages Back the buffer with 2MB hugepages, or transparent hugepages if none are reserved
+     */
+    tt_host_buffer allocate_host_buffer(chip_id_t chip, std::size_t size, bool use_hugepages = false);
+    /**
+     * @brief Allocator placing memory like allocate_host_buffer, for vectors (tt::numa_vector) passed to the vector APIs.
+     */
+    tt::numa_allocator get_numa_allocator(chip_id_t chip, bool use_hugepages = false);
+    /**
+     * @brief Hugepages backing a host memory channel of an MMIO chip (1GB, or 2MB if 1GB hugepages are not available
+     * and the device is behind an IOMMU), and the IOVA the channel was pinned at.
+     */
+    const tt_hugepage_channel& get_hugepage_channel(chip_id_t mmio_chip, uint16_t channel) const;
     static std::vector<int> extract_rows_to_remove(const tt::ARCH &arch, const int worker_grid_rows, const int harvested_rows);
     static void remove_worker_row_from_descriptor(tt_SocDescriptor& full_soc_descriptor, const std::vector<int>& row_coordinates_to_remove);
     static void harvest_rows_in_soc_descriptor(tt::ARCH arch, tt_SocDescriptor& sdesc, uint32_t harvested_rows);
-    static std::unordered_map<tt_xy_pair, tt_xy_pair> create_harvested_coord_translation(const tt::ARCH arch, bool identity_map);
+    /**
+     * @brief Build the SOC descriptors for a set of chips. Chips with the same arch and harvesting mask share one descriptor.
+     * \param arch Architecture of the chips
+     * \param sdesc_path Path to the unharvested SOC descriptor
+     * \param harvested_rows_per_chip Harvesting mask of each chip
+     * \param perform_harvesting Remove harvested rows from the descriptors. When false, all chips share the unharvested descriptor.
+     */
+    static tt_soc_descriptor_map create_soc_descriptors(tt::ARCH arch, const std::string& sdesc_path, const std::unordered_map<chip_id_t, uint32_t>& harvested_rows_per_chip, const bool perform_harvesting);
+    /**
+     * @brief Split the cores of a chip whose reset state is set into Tensix rectangles that can be multicast to, and cores
+     * that have to be written one by one. Throws if a core isn't a Tensix or ethernet core of the chip.
+     * \param workers Tensix cores of the chip that are not harvested
+     * \param use_multicast Whether the chip can be multicast to (MMIO chips). When false, all cores are unicast.
+     */
+    static void get_risc_reset_targets(chip_id_t chip, const std::unordered_set<tt_xy_pair>& workers, const std::unordered_set<tt_xy_pair>& eth_cores,
+                                       const std::unordered_set<tt_xy_pair>& cores, bool use_multicast,
+                                       std::vector<tt_multicast_grid>& grids, std::vector<tt_xy_pair>& unicast_cores);
+    /**
+     * @brief Split the cores of a chip reached by a software broadcast into Tensix rectangles that can be multicast to,
+     * and cores that have to be written one by one.
+     * \param use_multicast Whether the chip can be multicast to (MMIO chips). When false, all cores are unicast.
+     */
+    static void get_broadcast_targets(const tt_SocDescriptor& sdesc, const std::set<uint32_t>& rows_to_exclude, const std::set<uint32_t>& cols_to_exclude, bool use_multicast,
+                                      std::vector<tt_multicast_grid>& grids, std::vector<tt_xy_pair>& unicast_cores);
+    /**
+     * @brief Lay out all slots of a rolled write back to back, with the first word of each slot replaced by its slot id.
+     * \param mem_ptr Data of a single slot. Not modified.
+     * \param staging Resized to hold unroll_count slots. Its capacity is kept, so a reused buffer is only reallocated when
+     * a write needs more room than all earlier ones.
+     */
+    static void stage_rolled_write(const uint32_t* mem_ptr, uint32_t size_in_bytes, uint32_t unroll_count, std::vector<uint32_t>& staging);
+    /**
+     * @brief Staging buffer for rolled writes issued by the calling thread, reused across calls.
+     */
+    static std::vector<uint32_t>& get_rolled_write_staging();
+    /**
+     * @brief Split a rolled write to a remote chip into ethernet write commands, each carrying as many slots as fit in max_block_size.
+     * \returns The number of slots carried by each command, in order.
+     */
+    static std::vector<uint32_t> get_rolled_write_commands(uint32_t size_in_bytes, uint32_t unroll_count, uint32_t max_block_size);
+    static tt_coord_translation_table create_harvested_coord_translation(const tt::ARCH arch, bool identity_map);
     static std::unordered_map<chip_id_t, uint32_t> get_harvesting_masks_from_harvested_rows(std::unordered_map<chip_id_t, std::vector<uint32_t>> harvested_rows); 
     std::unordered_map<tt_xy_pair, tt_xy_pair> get_harvested_coord_translation_map(chip_id_t logical_device_id);
+    /**
+     * @brief Get the flat coordinate translation table used by the driver for a chip.
+     * Callers issuing many transactions can use this to translate cores in bulk, instead of relying on per access translation.
+    */
+    const tt_coord_translation_table& get_coord_translation_table(chip_id_t logical_device_id) const;
+    /**
+     * @brief Get the time spent in each phase of device bring-up (in the constructor and start_device).
+     * Per-device phases run concurrently across MMIO devices, so their duration is that of the slowest device.
+    */
+    const std::vector<tt_bringup_phase_timing>& get_bringup_phase_timings() const { return bringup_phase_timings; }
     virtual std::uint32_t get_num_dram_channels(std::uint32_t device_id);
     virtual std::uint64_t get_dram_channel_size(std::uint32_t device_id, std::uint32_t channel);
     virtual std::uint32_t get_num_host_channels(std::uint32_t device_id);
@@ -873,13 +1270,12 @@ class tt_SiliconDevice: public tt_device
     void initialize_pcie_devices();
     void broadcast_pcie_tensix_risc_reset(struct PCIdevice *device, const TensixSoftResetOptions &cores);
     void broadcast_tensix_risc_reset_to_cluster(const TensixSoftResetOptions &soft_resets);
-    void send_remote_tensix_risc_reset_to_core(const tt_cxy_pair &core, const TensixSoftResetOptions &soft_resets);
-    void send_tensix_risc_reset_to_core(const tt_cxy_pair &core, const TensixSoftResetOptions &soft_resets);
     void perform_harvesting_and_populate_soc_descriptors(const std::string& sdesc_path, const bool perform_harvesting);
     void populate_cores();
     void init_pcie_iatus();
     void init_pcie_iatus_no_p2p();
-    bool init_hugepage(chip_id_t device_id);
+    bool init_hugepage(chip_id_t device_id, uint16_t channel);
+    void init_host_channel(chip_id_t device_id, uint16_t channel);
     bool init_dmabuf(chip_id_t device_id);
     void check_pcie_device_initialized(int device_id);
     bool init_dma_turbo_buf(struct PCIdevice* pci_device);
@@ -902,7 +1298,9 @@ class tt_SiliconDevice: public tt_device
     // Communication Functions
     void read_dma_buffer(void* mem_ptr, std::uint32_t address, std::uint16_t channel, std::uint32_t size_in_bytes, chip_id_t src_device_id);
     void write_dma_buffer(const void *mem_ptr, std::uint32_t size, std::uint32_t address, std::uint16_t channel, chip_id_t src_device_id);
-    void write_device_memory(const void *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair target, std::uint32_t address, const std::string& fallback_tlb);
+    // Every memory write to an MMIO chip goes through write_device_memory or pcie_broadcast_write, which mark the cores
+    // written for membar dirty tracking. Only barrier flags are written with mark_membar_dirty = false.
+    void write_device_memory(const void *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair target, std::uint32_t address, const std::string& fallback_tlb, bool mark_membar_dirty = true);
     void write_to_non_mmio_device(const void *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair core, uint64_t address, bool broadcast = false, std::vector<int> broadcast_header = {});
     void read_device_memory(void *mem_ptr, tt_cxy_pair target, std::uint32_t address, std::uint32_t size_in_bytes, const std::string& fallback_tlb);
     void write_to_non_mmio_device_send_epoch_cmd(const uint32_t *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair core, uint64_t address, bool last_send_epoch_cmd, bool ordered_with_prev_remote_write);
@@ -910,18 +1308,34 @@ class tt_SiliconDevice: public tt_device
     void read_from_non_mmio_device(void* mem_ptr, tt_cxy_pair core, uint64_t address, uint32_t size_in_bytes);
     void read_mmio_device_register(void* mem_ptr, tt_cxy_pair core, uint64_t addr, uint32_t size, const std::string& fallback_tlb);
     void write_mmio_device_register(const void* mem_ptr, tt_cxy_pair core, uint64_t addr, uint32_t size, const std::string& fallback_tlb);
-    void pcie_broadcast_write(chip_id_t chip, const void* mem_ptr, uint32_t size_in_bytes, std::uint32_t addr, const tt_xy_pair& start, const tt_xy_pair& end, const std::string& fallback_tlb);
-    void ethernet_broadcast_write(const void *mem_ptr, uint32_t size_in_bytes, uint64_t address, const std::set<chip_id_t>& chips_to_exclude, const std::set<uint32_t>& rows_to_exclude, 
-                                  std::set<uint32_t>& cols_to_exclude, const std::string& fallback_tlb, bool use_virtual_coords);
+    void pcie_broadcast_write(chip_id_t chip, const void* mem_ptr, uint32_t size_in_bytes, std::uint32_t addr, const tt_xy_pair& start, const tt_xy_pair& end, const std::string& fallback_tlb, bool mark_membar_dirty = true);
+    void plan_ethernet_broadcast(tt_broadcast_plan& plan, const std::set<chip_id_t>& chips_to_exclude, const std::set<uint32_t>& rows_to_exclude,
+                                 const std::set<uint32_t>& cols_to_exclude, bool use_virtual_coords);
+    tt_io_worker_pool* get_io_worker_pool(chip_id_t mmio_chip) const;
+    void pin_fan_out_worker(chip_id_t mmio_chip);
+    class broadcast_io;
+    class membar_io;
+    class eth_queue_io;
     void set_membar_flag(const chip_id_t chip, const std::unordered_set<tt_xy_pair>& cores, const uint32_t barrier_value, const uint32_t barrier_addr, const std::string& fallback_tlb);
+    void insert_dram_barrier_on_all_cores(const chip_id_t chip, const std::string& fallback_tlb);
     void insert_host_to_device_barrier(const chip_id_t chip, const std::unordered_set<tt_xy_pair>& cores, const uint32_t barrier_addr, const std::string& fallback_tlb);
     void init_membars();
     uint64_t get_sys_addr(uint32_t chip_x, uint32_t chip_y, uint32_t noc_x, uint32_t noc_y, uint64_t offset);
     uint16_t get_sys_rack(uint32_t rack_x, uint32_t rack_y);
     bool is_non_mmio_cmd_q_full(uint32_t curr_wptr, uint32_t curr_rptr);
-    int pcie_arc_msg(int logical_device_id, uint32_t msg_code, bool wait_for_done = true, uint32_t arg0 = 0, uint32_t arg1 = 0, int timeout=1, uint32_t *return_3 = nullptr, uint32_t *return_4 = nullptr);
-    int remote_arc_msg(int logical_device_id, uint32_t msg_code, bool wait_for_done = true, uint32_t arg0 = 0, uint32_t arg1 = 0, int timeout=1, uint32_t *return_3 = nullptr, uint32_t *return_4 = nullptr);
-    bool address_in_tlb_space(uint32_t address, uint32_t size_in_bytes, int32_t tlb_index, uint64_t tlb_size, uint32_t chip);
+    class pcie_arc_msg_io;
+    class remote_arc_msg_io;
+    tt_arc_mailbox& get_arc_mailbox(chip_id_t chip);
+    tt_host_memory_placement get_host_memory_placement(chip_id_t chip, bool use_hugepages) const;
+    // Run access on the chip's ARC mailbox, through BAR accesses (under the ARC_MSG mutex) or the ethernet queues.
+    void access_arc_mailbox(chip_id_t chip, const std::function<void(tt_arc_mailbox&, tt_arc_msg_io&, const tt_arc_msg_regs&)>& access);
+    int send_arc_msg(int logical_device_id, uint32_t msg_code, bool wait_for_done = true, uint32_t arg0 = 0, uint32_t arg1 = 0, int timeout=1, uint32_t *return_3 = nullptr, uint32_t *return_4 = nullptr);
+    const tt_static_tlb_entry* get_static_tlb_entry(const tt_cxy_pair& target) const {
+        return target.chip < static_tlb_tables.size() ? static_tlb_tables[target.chip].get(target) : nullptr;
+    }
+    tt_membar_dirty_cores* get_membar_dirty_cores(chip_id_t chip) const {
+        return static_cast<std::size_t>(chip) < membar_dirty_cores.size() ? membar_dirty_cores[chip].get() : nullptr;
+    }
     struct PCIdevice* get_pci_device(int pci_intf_id) const;
     std::shared_ptr<boost::interprocess::named_mutex> get_mutex(const std::string& tlb_name, int pci_interface_id);
     virtual uint32_t get_harvested_noc_rows_for_chip(int logical_device_id); // Returns one-hot encoded harvesting mask for PCIe mapped chips
@@ -942,7 +1356,7 @@ class tt_SiliconDevice: public tt_device
     std::vector<tt::ARCH> archs_in_cluster = {};
     std::set<chip_id_t> target_devices_in_cluster = {};
     std::set<chip_id_t> target_remote_chips = {};
-    tt_SocDescriptor& get_soc_descriptor(chip_id_t chip_id);
+    const tt_SocDescriptor& get_soc_descriptor(chip_id_t chip_id);
     tt::ARCH arch_name;
     std::map<chip_id_t, struct PCIdevice*> m_pci_device_map;    // Map of enabled pci devices
     int m_num_pci_devices;                                      // Number of pci devices in system (enabled or disabled)
@@ -961,13 +1375,14 @@ class tt_SiliconDevice: public tt_device
     static constexpr std::uint32_t EPOCH_ETH_CORES_START_ID = NON_EPOCH_ETH_CORES_START_ID + NON_EPOCH_ETH_CORES_FOR_NON_MMIO_TRANSFERS;
     static constexpr std::uint32_t EPOCH_ETH_CORES_MASK = (EPOCH_ETH_CORES_FOR_NON_MMIO_TRANSFERS-1);
 
-    int active_core = NON_EPOCH_ETH_CORES_START_ID;
+    // Index of the ethernet core used for non-MMIO transfers, per MMIO chip. Only modified under the NON_MMIO mutex of the chip.
+    std::unordered_map<chip_id_t, int> active_core = {};
     int active_core_epoch = EPOCH_ETH_CORES_START_ID;
     bool erisc_q_ptrs_initialized = false;
     std::vector<std::uint32_t> erisc_q_ptrs_epoch[NUM_ETH_CORES_FOR_NON_MMIO_TRANSFERS];
     bool erisc_q_wrptr_updated[NUM_ETH_CORES_FOR_NON_MMIO_TRANSFERS];
     std::vector< std::vector<tt_cxy_pair> > remote_transfer_ethernet_cores;
-    bool flush_non_mmio = false;
+    std::atomic<bool> flush_non_mmio = false;
     bool non_mmio_transfer_cores_customized = false;
     std::unordered_map<chip_id_t, int> active_eth_core_idx_per_chip = {};
     // Size of the PCIE DMA buffer
@@ -975,7 +1390,10 @@ class tt_SiliconDevice: public tt_device
     std::uint32_t m_dma_buf_size;
     std::unordered_map<chip_id_t, bool> noc_translation_enabled_for_chip = {};
     std::map<std::string, std::shared_ptr<boost::interprocess::named_mutex>> hardware_resource_mutex_map = {};
-    std::unordered_map<chip_id_t, std::unordered_map<tt_xy_pair, tt_xy_pair>> harvested_coord_translation = {};
+    // Shared memory holding the tt_arc_msg_in_flight_marker of each PCI interface, guarded by its ARC_MSG mutex
+    std::map<std::string, std::shared_ptr<boost::interprocess::mapped_region>> arc_msg_in_flight_markers = {};
+    std::unordered_map<chip_id_t, tt_coord_translation_table> harvested_coord_translation = {};
+    std::vector<tt_bringup_phase_timing> bringup_phase_timings = {};
     std::unordered_map<chip_id_t, std::uint32_t> num_rows_harvested = {};
     std::unordered_map<chip_id_t, std::unordered_set<tt_xy_pair>> workers_per_chip = {};
     std::unordered_set<tt_xy_pair> eth_cores = {};
@@ -984,10 +1402,42 @@ class tt_SiliconDevice: public tt_device
     std::unordered_map<chip_id_t, std::unordered_map<int, void *>> hugepage_mapping;
     std::unordered_map<chip_id_t, std::unordered_map<int, std::size_t>> hugepage_mapping_size;
     std::unordered_map<chip_id_t, std::unordered_map<int, std::uint64_t>> hugepage_physical_address;
-    std::map<chip_id_t, std::unordered_map<std::int32_t, std::int32_t>> tlb_config_map = {};
+    // Chunks each hugepage channel was pinned as, to translate device addresses to host pointers and IOVAs
+    std::unordered_map<chip_id_t, std::unordered_map<int, tt_hugepage_channel>> hugepage_channels;
+    // Maps the channels above, in the background or on first use unless TT_PCI_HUGEPAGE_INIT=eager
+    tt_hugepage_channel_loader hugepage_loader;
+    // Serializes the DMA buffer fallback and registering channels with sysmem_map across channel loads
+    std::mutex host_channel_mutex;
+    std::map<chip_id_t, std::unordered_map<std::int32_t, std::uint64_t>> tlb_config_map = {};
     std::set<chip_id_t> all_target_mmio_devices;
     std::unordered_map<chip_id_t, std::vector<uint32_t>> host_channel_size;
-    std::function<std::int32_t(tt_xy_pair)> map_core_to_tlb;
+    std::unordered_map<chip_id_t, std::unique_ptr<tt_sysmem_allocator>> sysmem_allocators = {};
+    std::mutex sysmem_allocators_mutex;
+    // Host mappings of every hugepage (or DMA buffer stand-in) channel, set up once the device is started.
+    tt_sysmem_map sysmem_map;
+    std::size_t sysmem_streaming_threshold = TT_SYSMEM_STREAMING_THRESHOLD;
+    tt_telemetry_cache telemetry_cache;
+    std::unordered_map<chip_id_t, std::unique_ptr<tt_arc_mailbox>> arc_mailboxes = {};
+    std::mutex arc_mailboxes_mutex;
+    // I/O workers of each MMIO chip, only populated once start_io_workers is called.
+    std::unordered_map<chip_id_t, std::unique_ptr<tt_io_worker_pool>> io_worker_pools = {};
+    // Fans out work that is independent per MMIO chip (ex: broadcasts through each gateway). Runs on the I/O workers
+    // once they are started, and otherwise on a worker per MMIO chip, pinned to the chip's cpuset.
+    tt_mmio_fan_out mmio_fan_out = tt_mmio_fan_out(
+        [this] (chip_id_t mmio_chip) { pin_fan_out_worker(mmio_chip); },
+        [this] (chip_id_t mmio_chip) { return get_io_worker_pool(mmio_chip); });
+    // Static TLB entry per core, indexed by logical chip id. Only populated for MMIO chips once setup_core_to_tlb_map is called.
+    std::vector<tt_static_tlb_table> static_tlb_tables = {};
+    // Indexed by logical device id. Only populated for MMIO chips while dirty tracking is enabled.
+    // Shared with the split phase barriers in flight, which mark their cores dirty again if they don't complete.
+    std::vector<std::shared_ptr<tt_membar_dirty_cores>> membar_dirty_cores = {};
+    // Cores handed out through get_static_tlb_writer. Their writes bypass the driver, so they are pinned as dirty.
+    std::unordered_set<tt_cxy_pair> static_tlb_writer_cores = {};
+    std::mutex static_tlb_writer_cores_mutex;
+    tt_membar_sequence membar_sequence;
+    // Split phase barriers in flight per MMIO chip. Only populated by init_membars. Tokens hold on to their chip's
+    // counter, since they can outlive the driver.
+    std::unordered_map<chip_id_t, std::shared_ptr<std::atomic<int>>> split_phase_membars_in_flight = {};
     std::unordered_map<std::string, std::int32_t> dynamic_tlb_config = {};
     std::unordered_map<std::string, uint64_t> dynamic_tlb_ordering_modes = {};
     std::map<std::set<chip_id_t>, std::unordered_map<chip_id_t, std::vector<std::vector<int>>>> bcast_header_cache = {};
@@ -1002,6 +1452,7 @@ class tt_SiliconDevice: public tt_device
     // Named Mutexes
     static constexpr char NON_MMIO_MUTEX_NAME[] = "NON_MMIO";
     static constexpr char ARC_MSG_MUTEX_NAME[] = "ARC_MSG";
+    static constexpr char ARC_MSG_IN_FLIGHT_NAME[] = "ARC_MSG_IN_FLIGHT";
     static constexpr char MEM_BARRIER_MUTEX_NAME[] = "MEM_BAR";
     // ERISC FW Version Required by UMD
     static constexpr std::uint32_t SW_VERSION = 0x06060000;
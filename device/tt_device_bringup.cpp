@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_device_bringup.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+tt_device_bringup::tt_device_bringup(std::size_t max_threads, pin_thread_hook pin_thread, unpin_thread_hook unpin_thread) :
+    max_threads(std::max<std::size_t>(max_threads, 1)), pin_thread(std::move(pin_thread)), unpin_thread(std::move(unpin_thread)) {
+}
+
+void tt_device_bringup::run_per_device(const std::string& phase, const std::vector<chip_id_t>& devices, const device_step& step) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t num_workers = std::min(max_threads, devices.size());
+
+    if (num_workers <= 1) {
+        for (const auto& device : devices) {
+            step(device);
+        }
+        record_phase(phase, start, devices.size());
+        return;
+    }
+
+    std::atomic<std::size_t> next_device = 0;
+    std::exception_ptr first_exception = nullptr;
+    std::mutex exception_mutex;
+
+    auto worker = [&] {
+        for (std::size_t idx = next_device++; idx < devices.size(); idx = next_device++) {
+            const chip_id_t device = devices.at(idx);
+            try {
+                if (pin_thread) {
+                    pin_thread(device);
+                }
+                step(device);
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock(exception_mutex);
+                if (!first_exception) {
+                    first_exception = std::current_exception();
+                }
+            }
+            // Threads are re-pinned per device, since a worker can pick up devices on different NUMA nodes.
+            if (unpin_thread) {
+                unpin_thread();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers = {};
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    record_phase(phase, start, devices.size());
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+void tt_device_bringup::run_serial(const std::string& phase, const std::function<void()>& step) {
+    const auto start = std::chrono::steady_clock::now();
+    step();
+    record_phase(phase, start, 0);
+}
+
+void tt_device_bringup::bring_up_mmio_devices(const std::vector<chip_id_t>& devices, const tt_mmio_device_bringup_steps& steps) {
+    run_serial("allocate_devices", [&] {
+        for (const auto& device : devices) {
+            steps.allocate_device(device);
+        }
+    });
+    run_per_device("open_devices", devices, steps.open_device);
+    run_serial("configure_devices", [&] {
+        for (const auto& device : devices) {
+            steps.configure_device(device);
+        }
+    });
+    run_per_device("open_hugepage_fds", devices, steps.open_hugepage_fds);
+    if (steps.start_hugepage_init) {
+        run_serial("start_hugepage_init", steps.start_hugepage_init);
+    }
+    if (steps.init_hugepages) {
+        run_per_device("init_hugepages", devices, steps.init_hugepages);
+    }
+}
+
+std::size_t tt_device_bringup::get_default_max_threads(std::size_t num_devices) {
+    std::size_t max_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    const char* bringup_threads = std::getenv("TT_PCI_BRINGUP_THREADS");
+    if (bringup_threads) {
+        max_threads = std::max(std::atoi(bringup_threads), 1);
+    }
+    return std::max<std::size_t>(std::min(max_threads, num_devices), 1);
+}
+
+void tt_device_bringup::record_phase(const std::string& phase, std::chrono::steady_clock::time_point start, std::size_t num_devices) {
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    phase_timings.push_back({phase, duration, num_devices});
+}
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "device/tt_cluster_descriptor_types.h"
+
+struct tt_bringup_phase_timing {
+    std::string phase;
+    std::chrono::microseconds duration;
+    std::size_t num_devices; // 0 for cluster wide (serial) phases
+};
+
+//! Steps of MMIO device bring-up, run in order by tt_device_bringup::bring_up_mmio_devices.
+/*!
+    Per-device steps run concurrently across devices, serial steps run on the calling thread for one device at a time.
+    The hugepage steps are optional and skipped when empty.
+*/
+struct tt_mmio_device_bringup_steps {
+    std::function<void(chip_id_t)> allocate_device;   // Serial: set up the driver state of the device
+    std::function<void(chip_id_t)> open_device;       // Per device
+    std::function<void(chip_id_t)> configure_device;  // Serial: needs every device to be open
+    std::function<void(chip_id_t)> open_hugepage_fds; // Per device
+    std::function<void()> start_hugepage_init;        // Serial, optional
+    std::function<void(chip_id_t)> init_hugepages;    // Per device, optional
+};
+
+//! tt_device_bringup runs the independent per-device steps of driver initialization concurrently.
+/*!
+    Initialization is split into phases. A phase runs to completion for every device before the next one starts, so steps
+    that touch shared driver state or depend on other devices stay ordered by placing them in a serial phase.
+    Per-device phases run on at most max_threads threads. Each worker thread is pinned to the device it is initializing
+    through the pin/unpin hooks (tt_cpuset_allocator in the driver), so NUMA local allocations happen on the right node.
+    Steps are plain callables, which lets tests inject their own device and hugepage backends.
+    Threads only live for one phase, so work fanned out at runtime goes through tt_mmio_fan_out instead.
+*/
+class tt_device_bringup {
+    public:
+    using device_step = std::function<void(chip_id_t)>;
+    using pin_thread_hook = std::function<void(chip_id_t)>;
+    using unpin_thread_hook = std::function<void()>;
+
+    tt_device_bringup(std::size_t max_threads, pin_thread_hook pin_thread = nullptr, unpin_thread_hook unpin_thread = nullptr);
+
+    /**
+     * @brief Run step for each device, concurrently on up to max_threads worker threads.
+     * Returns once all devices are done. If any step throws, the first exception is rethrown after the others finish.
+     * With a single worker the steps run on the calling thread, which is never pinned.
+     */
+    void run_per_device(const std::string& phase, const std::vector<chip_id_t>& devices, const device_step& step);
+    /**
+     * @brief Run a cluster wide step on the calling thread.
+     */
+    void run_serial(const std::string& phase, const std::function<void()>& step);
+    /**
+     * @brief Bring up a set of MMIO devices: allocate, open, configure, open hugepage fds and initialize hugepages, each
+     * step completing for every device before the next one starts.
+     */
+    void bring_up_mmio_devices(const std::vector<chip_id_t>& devices, const tt_mmio_device_bringup_steps& steps);
+
+    std::size_t get_max_threads() const { return max_threads; }
+    const std::vector<tt_bringup_phase_timing>& get_phase_timings() const { return phase_timings; }
+
+    /**
+     * @brief Number of bring-up threads to use for a cluster. Bounded by the number of devices and hardware threads,
+     * and can be overridden through TT_PCI_BRINGUP_THREADS (1 initializes devices serially).
+     */
+    static std::size_t get_default_max_threads(std::size_t num_devices);
+
+    private:
+    void record_phase(const std::string& phase, std::chrono::steady_clock::time_point start, std::size_t num_devices);
+
+    std::size_t max_threads;
+    pin_thread_hook pin_thread;
+    unpin_thread_hook unpin_thread;
+    std::vector<tt_bringup_phase_timing> phase_timings = {};
+};
@@ -36,6 +36,7 @@ public:
   virtual bool using_harvested_soc_descriptors();
   virtual std::unordered_map<chip_id_t, uint32_t> get_harvesting_masks_for_soc_descriptors();
   virtual std::unordered_map<chip_id_t, tt_SocDescriptor>& get_virtual_soc_descriptors();
+  virtual const tt_soc_descriptor_map& get_virtual_soc_descriptor_map();
   virtual bool noc_translation_en();
   virtual std::set<chip_id_t> get_target_mmio_device_ids(); 
   virtual std::set<chip_id_t> get_target_remote_device_ids();
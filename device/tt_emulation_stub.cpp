@@ -63,7 +63,8 @@ bool tt_emulation_device::using_harvested_soc_descriptors() { return false; }
 bool tt_emulation_device::noc_translation_en() { return false; }
 std::unordered_map<chip_id_t, uint32_t> tt_emulation_device::get_harvesting_masks_for_soc_descriptors() { return {{0, 0}};}
 
-std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_emulation_device::get_virtual_soc_descriptors() {return soc_descriptor_per_chip;}
+std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_emulation_device::get_virtual_soc_descriptors() {return get_soc_descriptor_copies();}
+const tt_soc_descriptor_map& tt_emulation_device::get_virtual_soc_descriptor_map() {return soc_descriptor_per_chip;}
 
 std::map<int, int> tt_emulation_device::get_clocks() {return std::map<int, int>();}
 
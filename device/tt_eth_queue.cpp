@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_eth_queue.h"
+
+#include "common/logger.hpp"
+#include "device/tt_device.h"
+
+bool tt_is_eth_cmd_q_full(const tt_driver_eth_interface_params& eth_params, std::uint32_t curr_wptr, std::uint32_t curr_rptr) {
+    return (curr_wptr != curr_rptr) && ((curr_wptr & eth_params.cmd_buf_size_mask) == (curr_rptr & eth_params.cmd_buf_size_mask));
+}
+
+void tt_rolled_write_to_remote(tt_eth_queue_io& io, const tt_driver_eth_interface_params& eth_params, const tt_driver_host_address_params& host_params,
+                               int& active_queue, const std::uint32_t* mem_ptr, std::uint32_t size_in_bytes, std::uint32_t unroll_count,
+                               std::uint64_t address, std::vector<std::uint32_t>& staging) {
+    log_assert(size_in_bytes <= host_params.eth_routing_block_size, "Rolled write slot of {} bytes does not fit in an ethernet routing block", size_in_bytes);
+    const std::vector<std::uint32_t> slots_per_cmd = tt_SiliconDevice::get_rolled_write_commands(size_in_bytes, unroll_count, host_params.eth_routing_block_size);
+    if (slots_per_cmd.empty()) {
+        return;
+    }
+    const std::uint32_t words_per_slot = size_in_bytes / sizeof(std::uint32_t);
+    tt_SiliconDevice::stage_rolled_write(mem_ptr, size_in_bytes, slots_per_cmd.front(), staging);
+
+    // wptr and rptr, each padded to remote_update_ptr_size_bytes
+    const std::uint32_t q_ptrs_address = eth_params.request_cmd_queue_base + eth_params.cmd_counters_size_bytes;
+    const std::uint32_t rptr_index = eth_params.remote_update_ptr_size_bytes / sizeof(std::uint32_t);
+    std::vector<std::uint32_t> q_ptrs = std::vector<std::uint32_t>(2 * rptr_index);
+    auto read_q_ptrs = [&] () {
+        io.read_queue(active_queue, q_ptrs_address, q_ptrs.data(), q_ptrs.size() * sizeof(std::uint32_t));
+    };
+    auto publish_wptr = [&] () {
+        io.write_queue(active_queue, q_ptrs_address, &q_ptrs[0], sizeof(std::uint32_t));
+        io.flush_writes();
+    };
+
+    read_q_ptrs();
+    std::uint32_t rptr = q_ptrs[rptr_index];
+    bool full = tt_is_eth_cmd_q_full(eth_params, q_ptrs[0], rptr);
+    bool wptr_published = true;
+    std::uint32_t offset = 0;
+    std::uint32_t unroll_offset = 0;
+
+    for (const std::uint32_t num_slots : slots_per_cmd) {
+        while (full) {
+            io.read_queue(active_queue, q_ptrs_address + eth_params.remote_update_ptr_size_bytes, &rptr, sizeof(rptr));
+            full = tt_is_eth_cmd_q_full(eth_params, q_ptrs[0], rptr);
+        }
+
+        log_assert(((address + offset) & 0x1F) == 0, "Base address + offset in incorrect range!");
+
+        const std::uint32_t req_wr_ptr = q_ptrs[0] & eth_params.cmd_buf_size_mask;
+        const std::uint32_t host_dram_block_addr = host_params.eth_routing_buffers_start + (active_queue * eth_params.cmd_buf_size + req_wr_ptr) * host_params.eth_routing_block_size;
+
+        if (words_per_slot) {
+            for (std::uint32_t i = 0; i < num_slots; i++) {
+                staging[i * words_per_slot] = unroll_offset + i; // slot id for debug
+            }
+        }
+        const std::uint32_t block_size = num_slots * size_in_bytes;
+        io.write_sysmem(host_dram_block_addr, staging.data(), block_size);
+        unroll_offset += num_slots;
+        io.flush_writes();
+
+        routing_cmd_t cmd = {};
+        cmd.sys_addr = io.get_sys_addr(address + offset);
+        cmd.rack = io.get_rack();
+        cmd.data = block_size;
+        cmd.flags = eth_params.cmd_data_block_dram | eth_params.cmd_data_block | eth_params.cmd_wr_req;
+        cmd.src_addr_tag = host_dram_block_addr;
+        io.write_queue(active_queue, eth_params.request_routing_cmd_queue_base + sizeof(routing_cmd_t) * req_wr_ptr, &cmd, sizeof(cmd));
+        io.flush_writes();
+        q_ptrs[0] = (q_ptrs[0] + 1) & eth_params.cmd_buf_ptr_mask;
+        wptr_published = false;
+        offset += block_size;
+
+        // If this command made the q full, publish the wptr so the queue drains and switch to next Q.
+        // otherwise full stays false so that we do not poll the rd pointer in next iteration.
+        // As long as current command push does not fill up the queue completely, we do not want
+        // to poll rd pointer in every iteration.
+        if (tt_is_eth_cmd_q_full(eth_params, q_ptrs[0], rptr)) {
+            publish_wptr();
+            wptr_published = true;
+            active_queue = io.get_next_queue(active_queue);
+            read_q_ptrs();
+            rptr = q_ptrs[rptr_index];
+            full = tt_is_eth_cmd_q_full(eth_params, q_ptrs[0], rptr);
+        }
+    }
+    if (!wptr_published) {
+        publish_wptr();
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct tt_driver_eth_interface_params;
+struct tt_driver_host_address_params;
+
+// Command posted to an ERISC routing queue. Matches routing_cmd_t in the ERISC firmware.
+struct routing_cmd_t {
+    uint64_t sys_addr;
+    uint32_t data;
+    uint32_t flags;
+    uint16_t rack;
+    uint16_t src_resp_buf_index;
+    uint32_t local_buf_index;
+    uint8_t  src_resp_q_id;
+    uint8_t  host_mem_txn_id;
+    uint16_t padding;
+    uint32_t src_addr_tag; //upper 32-bits of request source address.
+};
+
+//! Host side of the ethernet command queues of one MMIO chip, used to write to a core of a remote chip.
+/*!
+    Each queue is owned by one of the MMIO chip's ethernet cores. The driver implements this through its TLBs and host
+    memory channel 0, and is expected to hold the NON_MMIO mutex while it is used. Tests implement it with a model of the
+    ERISC firmware.
+*/
+class tt_eth_queue_io {
+    public:
+    virtual ~tt_eth_queue_io() = default;
+    // Access the L1 of the ethernet core that owns queue
+    virtual void read_queue(int queue, std::uint32_t address, void* data, std::uint32_t size_in_bytes) = 0;
+    virtual void write_queue(int queue, std::uint32_t address, const void* data, std::uint32_t size_in_bytes) = 0;
+    // Queue that takes over once queue is full
+    virtual int get_next_queue(int queue) const = 0;
+    // Write a data block to host memory channel 0, where the ethernet cores read it from
+    virtual void write_sysmem(std::uint64_t address, const void* data, std::uint32_t size_in_bytes) = 0;
+    // Routing address and rack of address on the remote core
+    virtual std::uint64_t get_sys_addr(std::uint64_t address) const = 0;
+    virtual std::uint16_t get_rack() const = 0;
+    // Called after data blocks and commands are written, so they land before the commands/wptr that refer to them.
+    virtual void flush_writes() {}
+};
+
+bool tt_is_eth_cmd_q_full(const tt_driver_eth_interface_params& eth_params, std::uint32_t curr_wptr, std::uint32_t curr_rptr);
+
+/**
+ * @brief Write unroll_count copies of a slot to consecutive addresses of a remote core, through the ethernet queues.
+ * Every command carries as many slots as fit in a routing block (see tt_SiliconDevice::get_rolled_write_commands).
+ * All blocks hold the same payload, so it is staged once and only the slot ids are patched per command. The wptr is
+ * only published once all commands are queued, or when a queue fills up, after which the next queue is used.
+ * \param active_queue Queue to start with. Updated to the queue used last.
+ * \param staging Reused to stage the data blocks.
+ */
+void tt_rolled_write_to_remote(tt_eth_queue_io& io, const tt_driver_eth_interface_params& eth_params, const tt_driver_host_address_params& host_params,
+                               int& active_queue, const std::uint32_t* mem_ptr, std::uint32_t size_in_bytes, std::uint32_t unroll_count,
+                               std::uint64_t address, std::vector<std::uint32_t>& staging);
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_host_buffer.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "common/logger.hpp"
+#include "device/cpuset_lib.hpp"
+
+namespace {
+
+std::size_t get_mapping_size(std::size_t size, const tt_host_memory_placement& placement) {
+    const std::size_t unit = placement.use_hugepages ? TT_HOST_BUFFER_HUGEPAGE_SIZE : static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return ((size + unit - 1) / unit) * unit;
+}
+
+}  // namespace
+
+tt_host_memory_mapping tt_map_host_memory(std::size_t size, const tt_host_memory_placement& placement) {
+    tt_host_memory_mapping mapping = {};
+    mapping.size = get_mapping_size(size, placement);
+    if (mapping.size == 0) {
+        return mapping;
+    }
+
+    void* addr = MAP_FAILED;
+    if (placement.use_hugepages) {
+        addr = mmap(nullptr, mapping.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        mapping.hugepage_backed = addr != MAP_FAILED;
+    }
+    if (addr == MAP_FAILED) {
+        addr = mmap(nullptr, mapping.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        if (placement.use_hugepages) {
+            // No 2MB hugepages reserved, let the kernel back what it can with transparent hugepages.
+            madvise(addr, mapping.size, MADV_HUGEPAGE);
+        }
+    }
+    mapping.addr = addr;
+
+    // Bound before the first touch, so pages are allocated on the device's node instead of being migrated there.
+    if (placement.physical_device_id >= 0 && tt::cpuset::tt_cpuset_allocator::has_memory_nodeset(placement.physical_device_id)) {
+        mapping.numa_bound = tt::cpuset::tt_cpuset_allocator::bind_area_to_memory_nodeset(placement.physical_device_id, addr, mapping.size);
+    }
+    if (placement.physical_device_id >= 0 && !mapping.numa_bound) {
+        log_debug(tt::LogSiliconDriver, "Host memory for physical_device_id: {} isn't bound to its NUMA node", placement.physical_device_id);
+    }
+    return mapping;
+}
+
+void tt_unmap_host_memory(void* addr, std::size_t size, const tt_host_memory_placement& placement) {
+    if (addr != nullptr) {
+        munmap(addr, get_mapping_size(size, placement));
+    }
+}
+
+tt_host_buffer::tt_host_buffer(std::size_t size, const tt_host_memory_placement& placement) :
+    placement(placement), mapping(tt_map_host_memory(size, placement)), requested_size(size) {}
+
+tt_host_buffer::~tt_host_buffer() {
+    reset();
+}
+
+tt_host_buffer::tt_host_buffer(tt_host_buffer&& other) noexcept :
+    placement(other.placement), mapping(std::exchange(other.mapping, {})), requested_size(std::exchange(other.requested_size, 0)) {}
+
+tt_host_buffer& tt_host_buffer::operator=(tt_host_buffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        placement = other.placement;
+        mapping = std::exchange(other.mapping, {});
+        requested_size = std::exchange(other.requested_size, 0);
+    }
+    return *this;
+}
+
+void tt_host_buffer::reset() {
+    tt_unmap_host_memory(mapping.addr, mapping.size, placement);
+    mapping = {};
+    requested_size = 0;
+}
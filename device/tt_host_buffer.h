@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "device/tt_cluster_descriptor_types.h"
+
+// Host memory is bound to a NUMA node and backed by hugepages in units of this size.
+static constexpr std::size_t TT_HOST_BUFFER_HUGEPAGE_SIZE = 2 << 20;
+
+//! Where host memory used to stage transfers to a device is placed.
+struct tt_host_memory_placement {
+    // PCI interface id of the device, whose closest NUMA node the memory is bound to. Not bound if negative.
+    chip_id_t physical_device_id = -1;
+    // Back the memory with 2MB hugepages, or transparent hugepages if none are reserved.
+    bool use_hugepages = false;
+
+    bool operator==(const tt_host_memory_placement& other) const {
+        return physical_device_id == other.physical_device_id && use_hugepages == other.use_hugepages;
+    }
+    bool operator!=(const tt_host_memory_placement& other) const { return !(*this == other); }
+};
+
+//! A mapping of host memory placed according to a tt_host_memory_placement.
+struct tt_host_memory_mapping {
+    void* addr = nullptr;
+    // Size of the mapping, the requested size rounded up to pages (or 2MB when using hugepages)
+    std::size_t size = 0;
+    bool hugepage_backed = false;
+    bool numa_bound = false;
+};
+
+/**
+ * @brief Map size bytes of host memory, bound to the NUMA node closest to the device before any page is touched.
+ * If the device's NUMA node isn't known (ex: the cpuset allocator found no devices), the memory is left unbound and
+ * pages land on the node of the thread that first touches them. Throws std::bad_alloc if the memory can't be mapped.
+ */
+tt_host_memory_mapping tt_map_host_memory(std::size_t size, const tt_host_memory_placement& placement);
+/**
+ * @brief Unmap memory returned by tt_map_host_memory. size can be the requested size, or the size of the mapping.
+ */
+void tt_unmap_host_memory(void* addr, std::size_t size, const tt_host_memory_placement& placement);
+
+//! Host buffer returned by tt_SiliconDevice::allocate_host_buffer, unmapped when it is destroyed.
+class tt_host_buffer {
+    public:
+    tt_host_buffer() = default;
+    tt_host_buffer(std::size_t size, const tt_host_memory_placement& placement);
+    ~tt_host_buffer();
+
+    tt_host_buffer(const tt_host_buffer&) = delete;
+    tt_host_buffer& operator=(const tt_host_buffer&) = delete;
+    tt_host_buffer(tt_host_buffer&& other) noexcept;
+    tt_host_buffer& operator=(tt_host_buffer&& other) noexcept;
+
+    void* data() const { return mapping.addr; }
+    // Requested size. The mapping itself can be larger.
+    std::size_t size() const { return requested_size; }
+    const tt_host_memory_placement& get_placement() const { return placement; }
+    bool is_hugepage_backed() const { return mapping.hugepage_backed; }
+    bool is_numa_bound() const { return mapping.numa_bound; }
+
+    private:
+    void reset();
+
+    tt_host_memory_placement placement = {};
+    tt_host_memory_mapping mapping = {};
+    std::size_t requested_size = 0;
+};
+
+namespace tt {
+
+//! std::allocator compatible allocator of host memory placed close to a device (see tt_map_host_memory).
+/*!
+    Each allocation is a mapping of its own, rounded up to pages, so it is meant for transfer buffers rather than small
+    objects. The placement follows containers when they are copied, moved or swapped.
+*/
+template <typename T>
+class basic_numa_allocator {
+    public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    basic_numa_allocator() = default;
+    explicit basic_numa_allocator(const tt_host_memory_placement& placement) : placement(placement) {}
+    template <typename U>
+    basic_numa_allocator(const basic_numa_allocator<U>& other) : placement(other.get_placement()) {}
+
+    T* allocate(std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(tt_map_host_memory(n * sizeof(T), placement).addr);
+    }
+    void deallocate(T* p, std::size_t n) {
+        if (p != nullptr) {
+            tt_unmap_host_memory(p, n * sizeof(T), placement);
+        }
+    }
+
+    const tt_host_memory_placement& get_placement() const { return placement; }
+
+    private:
+    tt_host_memory_placement placement = {};
+};
+
+template <typename T, typename U>
+bool operator==(const basic_numa_allocator<T>& a, const basic_numa_allocator<U>& b) {
+    return a.get_placement() == b.get_placement();
+}
+template <typename T, typename U>
+bool operator!=(const basic_numa_allocator<T>& a, const basic_numa_allocator<U>& b) {
+    return !(a == b);
+}
+
+using numa_allocator = basic_numa_allocator<std::uint32_t>;
+// Accepted by the vector APIs of tt_SiliconDevice
+using numa_vector = std::vector<std::uint32_t, numa_allocator>;
+
+}  // namespace tt
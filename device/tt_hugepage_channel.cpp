@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_hugepage_channel.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "common/logger.hpp"
+
+void* tt_hugepage_channel::get_host_address(std::uint64_t device_offset) const {
+    log_assert(device_offset < size, "Device address {:#x} is outside of the {:#x} byte host memory channel", device_offset, size);
+    return static_cast<std::uint8_t*>(mapping) + device_offset;
+}
+
+std::uint64_t tt_hugepage_channel::get_iova(std::uint64_t device_offset) const {
+    log_assert(device_offset < size, "Device address {:#x} is outside of the {:#x} byte host memory channel", device_offset, size);
+    return iova + device_offset;
+}
+
+tt_hugepage_channel tt_map_hugepage_channel(const tt_hugepage_ops& ops, std::uint16_t channel, std::uint64_t size, std::size_t page_size) {
+    log_assert(page_size > 0 && size % page_size == 0, "Host memory channel size {} is not a multiple of the {} byte hugepage size", size, page_size);
+    const std::string dir = ops.find_dir(page_size);
+    if (dir.empty()) {
+        log_debug(tt::LogSiliconDriver, "No hugetlbfs mount with {} byte pages for host memory channel {}", page_size, channel);
+        return {};
+    }
+    void* mapping = ops.map(dir, channel, size);
+    if (mapping == nullptr) {
+        log_debug(tt::LogSiliconDriver, "Mapping {} bytes of {} byte hugepages from {} for host memory channel {} failed", size, page_size, dir, channel);
+        return {};
+    }
+
+    std::uint64_t iova = 0;
+    if (!ops.pin(channel, mapping, size, iova)) {
+        log_debug(tt::LogSiliconDriver, "Pinning host memory channel {} as one IOVA contiguous range of {} byte hugepages failed", channel, page_size);
+        ops.unmap(mapping, size);
+        return {};
+    }
+    return {mapping, size, page_size, iova};
+}
+
+tt_hugepage_channel_loader::~tt_hugepage_channel_loader() {
+    stop();
+}
+
+void tt_hugepage_channel_loader::start(tt_hugepage_init_mode mode, const std::vector<chip_id_t>& devices, std::uint16_t num_channels, load_channel_fn load) {
+    log_assert(this->load == nullptr, "Host memory channels were already set up");
+    this->load = std::move(load);
+    this->num_channels = num_channels;
+    for (const auto& device : devices) {
+        for (std::uint16_t channel = 0; channel < num_channels; channel++) {
+            channels.emplace(std::make_pair(device, channel), std::make_unique<channel_state>());
+        }
+    }
+
+    if (mode == tt_hugepage_init_mode::Eager) {
+        for (const auto& device : devices) {
+            wait_for_device(device);
+        }
+    } else if (mode == tt_hugepage_init_mode::Background) {
+        background_thread = std::thread([this, devices] {
+            for (const auto& device : devices) {
+                for (std::uint16_t channel = 0; channel < this->num_channels && !stopping; channel++) {
+                    try {
+                        wait_for_channel(device, channel);
+                    } catch (...) {
+                        // Rethrown to the threads that access the channel
+                    }
+                }
+            }
+        });
+    }
+}
+
+tt_hugepage_channel_loader::channel_state* tt_hugepage_channel_loader::get_state(chip_id_t device, std::uint16_t channel) const {
+    auto state = channels.find({device, channel});
+    return state == channels.end() ? nullptr : state->second.get();
+}
+
+void tt_hugepage_channel_loader::wait_for_channel(chip_id_t device, std::uint16_t channel) const {
+    channel_state* managed_state = get_state(device, channel);
+    if (managed_state == nullptr) {
+        return;
+    }
+    channel_state& state = *managed_state;
+    if (!state.ready.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!state.ready && !state.loading) {
+            state.loading = true;
+            lock.unlock();
+            std::exception_ptr error = nullptr;
+            try {
+                load(device, channel);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            state.error = error;
+            state.ready.store(true, std::memory_order_release);
+            channel_ready.notify_all();
+        } else {
+            channel_ready.wait(lock, [&] { return state.ready.load(); });
+        }
+    }
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+}
+
+void tt_hugepage_channel_loader::wait_for_device(chip_id_t device) const {
+    for (std::uint16_t channel = 0; channel < num_channels; channel++) {
+        wait_for_channel(device, channel);
+    }
+}
+
+bool tt_hugepage_channel_loader::is_ready(chip_id_t device, std::uint16_t channel) const {
+    const channel_state* state = get_state(device, channel);
+    return state == nullptr || state->ready.load(std::memory_order_acquire);
+}
+
+void tt_hugepage_channel_loader::stop() {
+    stopping = true;
+    if (background_thread.joinable()) {
+        background_thread.join();
+    }
+}
+
+tt_hugepage_init_mode tt_hugepage_channel_loader::get_default_mode() {
+    const char* init_mode = std::getenv("TT_PCI_HUGEPAGE_INIT");
+    if (init_mode == nullptr) {
+        return tt_hugepage_init_mode::Background;
+    } else if (std::strcmp(init_mode, "eager") == 0) {
+        return tt_hugepage_init_mode::Eager;
+    } else if (std::strcmp(init_mode, "lazy") == 0) {
+        return tt_hugepage_init_mode::OnFirstUse;
+    }
+    log_assert(std::strcmp(init_mode, "background") == 0, "Invalid TT_PCI_HUGEPAGE_INIT={}, expected eager, background or lazy", init_mode);
+    return tt_hugepage_init_mode::Background;
+}
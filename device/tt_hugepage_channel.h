@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "device/tt_cluster_descriptor_types.h"
+
+//! Host memory channel backed by hugepages of page_size bytes.
+/*!
+    Each channel is reached by the device through a single iATU region, so the whole channel is pinned as one IOVA
+    contiguous range. 1GB hugepages always are. 2MB hugepages only are behind an IOMMU, which hands out contiguous IOVAs
+    for physically scattered pages. Device addresses are offsets in the channel, and translate to mapping + offset on
+    the host and iova + offset on the PCIe bus.
+*/
+struct tt_hugepage_channel {
+    void* mapping = nullptr;
+    std::uint64_t size = 0;
+    std::size_t page_size = 0;
+    // Address the device uses to reach the channel over PCIe (physical address, or IO virtual address behind an IOMMU)
+    std::uint64_t iova = 0;
+
+    bool is_valid() const { return mapping != nullptr; }
+    void* get_host_address(std::uint64_t device_offset) const;
+    std::uint64_t get_iova(std::uint64_t device_offset) const;
+};
+
+//! Operating system and kernel driver layers used to back a channel with hugepages.
+/*!
+    The driver implements these with hugetlbfs, mmap and TENSTORRENT_IOCTL_PIN_PAGES. Tests implement them with
+    anonymous memory and a model of the IOMMU.
+*/
+struct tt_hugepage_ops {
+    // Mount point of a hugetlbfs with the given page size. Empty if there is none.
+    std::function<std::string(std::size_t page_size)> find_dir;
+    // Map size bytes of the channel's hugepage file in dir. nullptr on failure.
+    std::function<void*(const std::string& dir, std::uint16_t channel, std::uint64_t size)> map;
+    std::function<void(void* mapping, std::uint64_t size)> unmap;
+    // Pin size bytes at address as one IOVA contiguous range. false if the range can't be pinned contiguously.
+    std::function<bool(std::uint16_t channel, void* address, std::uint64_t size, std::uint64_t& iova)> pin;
+};
+
+/**
+ * @brief Map and pin a host memory channel of size bytes, backed by hugepages of page_size bytes.
+ * The channel is unmapped and an invalid channel returned if there is no hugetlbfs mount with that page size, if mapping
+ * fails, or if the channel can't be pinned as one IOVA contiguous range.
+ */
+tt_hugepage_channel tt_map_hugepage_channel(const tt_hugepage_ops& ops, std::uint16_t channel, std::uint64_t size, std::size_t page_size);
+
+enum class tt_hugepage_init_mode {
+    Eager,      // Channels are mapped while the device is opened
+    Background, // Channels are mapped by a background thread started when the device is opened
+    OnFirstUse, // Each channel is mapped by the first thread that accesses it
+};
+
+//! Maps the host memory channels of a set of devices, eagerly, in the background or on first use.
+/*!
+    Mapping and populating a 1GB channel is slow, and not every user of the driver touches sysmem. Accessors call
+    wait_for_channel before using a channel: it returns immediately (one atomic load) once the channel is ready, loads
+    the channel on the calling thread if nobody started loading it yet, and otherwise blocks until the thread loading it
+    is done. Each channel is loaded exactly once. If loading a channel throws, the exception is rethrown to every thread
+    that waits for that channel.
+*/
+class tt_hugepage_channel_loader {
+    public:
+    using load_channel_fn = std::function<void(chip_id_t device, std::uint16_t channel)>;
+
+    ~tt_hugepage_channel_loader();
+
+    /**
+     * @brief Set up channels [0, num_channels) of each device. Eager loads all of them on the calling thread, Background
+     * starts a thread that loads them in order, OnFirstUse leaves them to wait_for_channel. Can only be called once.
+     */
+    void start(tt_hugepage_init_mode mode, const std::vector<chip_id_t>& devices, std::uint16_t num_channels, load_channel_fn load);
+    /**
+     * @brief Block until a channel is loaded, loading it on the calling thread if nobody else is.
+     * Channels that were not set up through start are not managed by the loader, and are always ready.
+     */
+    void wait_for_channel(chip_id_t device, std::uint16_t channel) const;
+    void wait_for_device(chip_id_t device) const;
+    bool is_ready(chip_id_t device, std::uint16_t channel) const;
+    /**
+     * @brief Stop the background thread once it is done with the channel it is loading. Channels it didn't get to are
+     * still loaded on first use.
+     */
+    void stop();
+
+    /**
+     * @brief Mode set through TT_PCI_HUGEPAGE_INIT (eager, background or lazy). Background if it isn't set.
+     */
+    static tt_hugepage_init_mode get_default_mode();
+
+    private:
+    struct channel_state {
+        std::atomic<bool> ready = false;
+        bool loading = false;
+        std::exception_ptr error = nullptr;
+    };
+
+    channel_state* get_state(chip_id_t device, std::uint16_t channel) const;
+
+    load_channel_fn load = nullptr;
+    std::uint16_t num_channels = 0;
+    // Fixed once started, so lookups don't need the lock
+    std::map<std::pair<chip_id_t, std::uint16_t>, std::unique_ptr<channel_state>> channels = {};
+    mutable std::mutex mutex;
+    mutable std::condition_variable channel_ready;
+    std::atomic<bool> stopping = false;
+    std::thread background_thread;
+};
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_io_worker_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "common/logger.hpp"
+
+namespace {
+thread_local bool running_on_io_worker = false;
+}
+
+tt_io_worker_pool::tt_io_worker_pool(std::size_t num_workers, pin_worker_hook pin_worker) : pin_worker(std::move(pin_worker)) {
+    log_assert(num_workers > 0, "An I/O worker pool needs at least one worker");
+    workers.reserve(num_workers);
+    for (std::size_t worker = 0; worker < num_workers; worker++) {
+        workers.emplace_back(&tt_io_worker_pool::run_worker, this, worker);
+    }
+}
+
+tt_io_worker_pool::~tt_io_worker_pool() {
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    tasks_available.notify_all();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+std::future<void> tt_io_worker_pool::submit(task work) {
+    std::packaged_task<void()> packaged_work = std::packaged_task<void()>(std::move(work));
+    std::future<void> done = packaged_work.get_future();
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        log_assert(!stopping, "Can't submit work to an I/O worker pool that is stopping");
+        tasks.push_back(std::move(packaged_work));
+    }
+    tasks_available.notify_one();
+    return done;
+}
+
+void tt_io_worker_pool::run_worker(std::size_t worker) {
+    running_on_io_worker = true;
+    if (pin_worker) {
+        pin_worker(worker);
+    }
+    while (true) {
+        std::packaged_task<void()> work;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            tasks_available.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            work = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        // Exceptions are stored in the task's future.
+        work();
+    }
+}
+
+bool tt_io_worker_pool::is_worker_thread() {
+    return running_on_io_worker;
+}
+
+std::size_t tt_io_worker_pool::get_default_max_workers_per_device() {
+    const char* max_workers = std::getenv("TT_PCI_IO_WORKERS_PER_DEVICE");
+    if (max_workers) {
+        return std::max(std::atoi(max_workers), 0);
+    }
+    return 0;
+}
+
+tt_io_task_group::tt_io_task_group(std::size_t num_tasks) : state(std::make_shared<group_state>()) {
+    state->num_pending = num_tasks;
+    if (num_tasks == 0) {
+        state->done.set_value();
+    }
+}
+
+std::function<void()> tt_io_task_group::wrap(std::function<void()> task) {
+    return [state = state, task = std::move(task)] {
+        std::exception_ptr error = nullptr;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        const std::lock_guard<std::mutex> lock(state->mutex);
+        log_assert(state->num_pending > 0, "More tasks ran than the I/O task group was created for");
+        if (error && !state->first_error) {
+            state->first_error = error;
+        }
+        if (--state->num_pending == 0) {
+            if (state->first_error) {
+                state->done.set_exception(state->first_error);
+            } else {
+                state->done.set_value();
+            }
+        }
+    };
+}
+
+tt_mmio_fan_out::tt_mmio_fan_out(pin_worker_hook pin_worker, get_pool_hook get_io_worker_pool) :
+    pin_worker(std::move(pin_worker)), get_io_worker_pool(std::move(get_io_worker_pool)) {}
+
+tt_io_worker_pool& tt_mmio_fan_out::get_pool(chip_id_t device) {
+    if (get_io_worker_pool) {
+        if (tt_io_worker_pool* pool = get_io_worker_pool(device)) {
+            return *pool;
+        }
+    }
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto& pool = pools[device];
+    if (!pool) {
+        pool = std::make_unique<tt_io_worker_pool>(1, [pin_worker = pin_worker, device] (std::size_t) {
+            if (pin_worker) {
+                pin_worker(device);
+            }
+        });
+    }
+    return *pool;
+}
+
+void tt_mmio_fan_out::run_per_device(const std::vector<chip_id_t>& devices, const std::function<void(chip_id_t)>& step) {
+    if (devices.size() <= 1 || tt_io_worker_pool::is_worker_thread()) {
+        for (const chip_id_t device : devices) {
+            step(device);
+        }
+        return;
+    }
+    tt_io_task_group steps = tt_io_task_group(devices.size());
+    for (const chip_id_t device : devices) {
+        get_pool(device).submit(steps.wrap([&step, device] { step(device); }));
+    }
+    steps.get_future().get();
+}
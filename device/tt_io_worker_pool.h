@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "device/tt_cluster_descriptor_types.h"
+
+//! Worker threads that run the I/O of one device.
+/*!
+    Workers are started once and live as long as the pool, so work submitted to them doesn't pay for creating and
+    pinning a thread. Each worker calls the pin hook with its index when it starts (the driver pins it to a CPU close to
+    the device, see tt::cpuset::get_io_worker_cpus). Tasks run in submission order, on whichever worker is free first.
+*/
+class tt_io_worker_pool {
+    public:
+    using task = std::function<void()>;
+    using pin_worker_hook = std::function<void(std::size_t worker)>;
+
+    tt_io_worker_pool(std::size_t num_workers, pin_worker_hook pin_worker = nullptr);
+    // Runs the tasks that are still queued, then joins the workers.
+    ~tt_io_worker_pool();
+
+    tt_io_worker_pool(const tt_io_worker_pool&) = delete;
+    tt_io_worker_pool& operator=(const tt_io_worker_pool&) = delete;
+
+    /**
+     * @brief Queue a task to run on one of the workers.
+     * \returns A future that becomes ready once the task ran, and rethrows its exception if it threw.
+     */
+    std::future<void> submit(task work);
+    std::size_t get_num_workers() const { return workers.size(); }
+    // Whether the calling thread is a worker of any pool. Work running on a worker must not wait for work it submits.
+    static bool is_worker_thread();
+
+    /**
+     * @brief Maximum number of I/O workers per device, set through TT_PCI_IO_WORKERS_PER_DEVICE. 0 (the default) means
+     * the driver doesn't start I/O workers.
+     */
+    static std::size_t get_default_max_workers_per_device();
+
+    private:
+    void run_worker(std::size_t worker);
+
+    pin_worker_hook pin_worker;
+    std::mutex mutex;
+    std::condition_variable tasks_available;
+    std::deque<std::packaged_task<void()>> tasks = {};
+    bool stopping = false;
+    std::vector<std::thread> workers = {};
+};
+
+//! Completion of a group of tasks, which can be spread over the pools of several devices.
+/*!
+    Tasks are wrapped before they are submitted. The group's future becomes ready once every wrapped task ran, and
+    rethrows the first exception thrown by one of them. The wrapped tasks keep the group's state alive, so the group
+    itself can be dropped once they are submitted.
+*/
+class tt_io_task_group {
+    public:
+    explicit tt_io_task_group(std::size_t num_tasks);
+
+    // Wrap task so it counts towards the group. Must be called exactly num_tasks times.
+    std::function<void()> wrap(std::function<void()> task);
+    std::future<void> get_future() { return state->done.get_future(); }
+
+    private:
+    struct group_state {
+        std::mutex mutex;
+        std::size_t num_pending;
+        std::exception_ptr first_error = nullptr;
+        std::promise<void> done;
+    };
+
+    std::shared_ptr<group_state> state;
+};
+
+//! Runs a step per MMIO device, concurrently across devices, on workers that outlive each call.
+/*!
+    Steps run on the device's I/O worker pool when the lookup hook returns one (the driver's I/O workers, once started).
+    Otherwise each device gets a worker of its own, started on first use and pinned through the pin hook. Fanning out on
+    a hot path (ex: every broadcast) never pays for creating, pinning and joining threads.
+*/
+class tt_mmio_fan_out {
+    public:
+    using pin_worker_hook = std::function<void(chip_id_t device)>;
+    using get_pool_hook = std::function<tt_io_worker_pool*(chip_id_t device)>;
+
+    explicit tt_mmio_fan_out(pin_worker_hook pin_worker = nullptr, get_pool_hook get_io_worker_pool = nullptr);
+
+    /**
+     * @brief Run step for each device, and return once all ran.
+     * A single device, or a caller that is itself an I/O worker (which must not wait for other workers), runs the steps
+     * on the calling thread, in order. Otherwise if any step throws, the first exception is rethrown after the others
+     * finish.
+     */
+    void run_per_device(const std::vector<chip_id_t>& devices, const std::function<void(chip_id_t)>& step);
+
+    private:
+    tt_io_worker_pool& get_pool(chip_id_t device);
+
+    pin_worker_hook pin_worker;
+    get_pool_hook get_io_worker_pool;
+    std::mutex mutex;
+    std::unordered_map<chip_id_t, std::unique_ptr<tt_io_worker_pool>> pools = {};
+};
@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_membar.h"
+
+#include <algorithm>
+#include <bitset>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "common/logger.hpp"
+
+std::vector<tt_multicast_grid> tt_get_multicast_grids(const std::unordered_set<tt_xy_pair>& cores) {
+    std::vector<tt_xy_pair> row_major_cores(cores.begin(), cores.end());
+    std::sort(row_major_cores.begin(), row_major_cores.end(), [] (const tt_xy_pair& a, const tt_xy_pair& b) {
+        return a.y < b.y || (a.y == b.y && a.x < b.x);
+    });
+    std::unordered_set<tt_xy_pair> covered = {};
+    auto available = [&] (const tt_xy_pair& core) {
+        return cores.find(core) != cores.end() && covered.find(core) == covered.end();
+    };
+
+    std::vector<tt_multicast_grid> grids = {};
+    for (const auto& start : row_major_cores) {
+        if (!available(start)) {
+            continue;
+        }
+        tt_xy_pair end = start;
+        while (available(tt_xy_pair(end.x + 1, start.y))) {
+            end.x++;
+        }
+        auto row_available = [&] (std::size_t y) {
+            for (std::size_t x = start.x; x <= end.x; x++) {
+                if (!available(tt_xy_pair(x, y))) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        while (row_available(end.y + 1)) {
+            end.y++;
+        }
+
+        const tt_multicast_grid grid = {start, end};
+        if (grid.num_cores() < 2) {
+            continue;
+        }
+        for (std::size_t y = start.y; y <= end.y; y++) {
+            for (std::size_t x = start.x; x <= end.x; x++) {
+                covered.insert(tt_xy_pair(x, y));
+            }
+        }
+        grids.push_back(grid);
+    }
+    return grids;
+}
+
+// Post value to all cores back to back, so the writes are in flight at the same time.
+static void post_membar_flag(tt_membar_io& io, const std::unordered_set<tt_xy_pair>& cores, std::uint32_t address, std::uint32_t value) {
+    std::vector<tt_multicast_grid> grids = {};
+    if (std::any_of(cores.begin(), cores.end(), [&] (const tt_xy_pair& core) { return io.can_multicast_to(core); })) {
+        std::unordered_set<tt_xy_pair> multicast_cores = {};
+        for (const auto& core : cores) {
+            if (io.can_multicast_to(core)) {
+                multicast_cores.insert(core);
+            }
+        }
+        grids = tt_get_multicast_grids(multicast_cores);
+    }
+
+    for (const auto& grid : grids) {
+        io.multicast_write_word(grid.start, grid.end, address, value);
+    }
+    for (const auto& core : cores) {
+        const bool multicast = std::any_of(grids.begin(), grids.end(), [&] (const tt_multicast_grid& grid) { return grid.contains(core); });
+        if (!multicast) {
+            io.write_word(core, address, value);
+        }
+    }
+}
+
+void tt_set_membar_flag(tt_membar_io& io, const std::unordered_set<tt_xy_pair>& cores, std::uint32_t address, std::uint32_t value) {
+    log_assert(cores.size() <= TT_MEMBAR_MAX_CORES, "Memory barrier on {} cores exceeds the maximum of {}", cores.size(), TT_MEMBAR_MAX_CORES);
+
+    post_membar_flag(io, cores, address, value);
+    io.flush_writes();
+
+    // Bit i tracks the i-th core in iteration order of cores, which doesn't change while it isn't modified.
+    std::bitset<TT_MEMBAR_MAX_CORES> pending = {};
+    for (std::size_t i = 0; i < cores.size(); i++) {
+        pending.set(i);
+    }
+    while (pending.any()) {
+        std::size_t i = 0;
+        for (const auto& core : cores) {
+            if (pending.test(i) && io.read_word(core, address) == value) {
+                pending.reset(i);
+            }
+            i++;
+        }
+    }
+    io.fence();
+}
+
+tt_membar_sequence::tt_membar_sequence() : tt_membar_sequence(std::random_device()()) {}
+
+tt_membar_sequence::tt_membar_sequence(std::uint32_t start) : next_value(start & ~SEQUENCE_BIT) {}
+
+std::uint32_t tt_membar_sequence::next() {
+    return (next_value++ & ~SEQUENCE_BIT) | SEQUENCE_BIT;
+}
+
+bool tt_membar_sequence::acknowledges(std::uint32_t flag, std::uint32_t sequence) const {
+    if (!(flag & SEQUENCE_BIT)) {
+        return false;
+    }
+    // A flag posted after sequence overwrote it, which means that sequence (written earlier on the same path) landed too.
+    const std::uint32_t latest = (next_value.load() - 1) | SEQUENCE_BIT;
+    const std::uint32_t distance = (flag - sequence) & ~SEQUENCE_BIT;
+    const std::uint32_t window = (latest - sequence) & ~SEQUENCE_BIT;
+    return distance <= window;
+}
+
+void tt_begin_membar(tt_membar_io& io, tt_membar_token& token) {
+    log_assert(token.targets.size() <= TT_MEMBAR_MAX_CORES, "Memory barrier on {} cores exceeds the maximum of {}", token.targets.size(), TT_MEMBAR_MAX_CORES);
+
+    // Cores of the same type share a flag address, and are posted together so they can be multicast to.
+    std::unordered_map<std::uint32_t, std::unordered_set<tt_xy_pair>> cores_per_address = {};
+    for (const auto& target : token.targets) {
+        cores_per_address[target.address].insert(target.core);
+    }
+    for (const auto& [address, cores] : cores_per_address) {
+        post_membar_flag(io, cores, address, token.sequence);
+    }
+    io.flush_writes();
+
+    token.pending.reset();
+    for (std::size_t i = 0; i < token.targets.size(); i++) {
+        token.pending.set(i);
+    }
+    token.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(token.timeout);
+}
+
+bool tt_test_membar(tt_membar_io& io, tt_membar_token& token, const tt_membar_sequence& sequence) {
+    if (token.pending.none()) {
+        return true;
+    }
+    for (std::size_t i = 0; i < token.targets.size(); i++) {
+        if (token.pending.test(i)) {
+            const auto& target = token.targets[i];
+            if (sequence.acknowledges(io.read_word(target.core, target.address), token.sequence)) {
+                token.pending.reset(i);
+            }
+        }
+    }
+    if (token.pending.none()) {
+        io.fence();
+        if (token.in_flight) {
+            token.in_flight->completed = true;
+            token.in_flight.reset();
+        }
+        return true;
+    }
+    if (std::chrono::steady_clock::now() > token.deadline) {
+        token.in_flight.reset();
+        throw std::runtime_error("Timed out after waiting " + std::to_string(token.timeout) + " seconds for " + std::to_string(token.pending.count()) +
+                                 " cores of device " + std::to_string(token.chip) + " to acknowledge memory barrier 0x" + fmt::format("{:x}", token.sequence));
+    }
+    return false;
+}
+
+tt_membar_dirty_cores::tt_membar_dirty_cores(const tt_xy_pair& grid_size) : grid_size(grid_size) {
+    log_assert(grid_size.x * grid_size.y <= TT_MEMBAR_MAX_CORES, "Grid of size {} is too large to track dirty cores", grid_size.str());
+}
+
+std::size_t tt_membar_dirty_cores::get_index(const tt_xy_pair& core) const {
+    log_assert(core.x < grid_size.x && core.y < grid_size.y, "Core {} is outside of the {} grid", core.str(), grid_size.str());
+    return core.y * grid_size.x + core.x;
+}
+
+void tt_membar_dirty_cores::mark_all() {
+    for (auto& word : words) {
+        word.store(~std::uint64_t(0), std::memory_order_release);
+    }
+}
+
+void tt_membar_dirty_cores::mark_grid(const tt_xy_pair& start, const tt_xy_pair& end) {
+    for (std::size_t y = start.y; y <= std::min(end.y, grid_size.y - 1); y++) {
+        for (std::size_t x = start.x; x <= std::min(end.x, grid_size.x - 1); x++) {
+            mark(tt_xy_pair(x, y));
+        }
+    }
+}
+
+void tt_membar_dirty_cores::pin(const tt_xy_pair& core) {
+    const std::size_t index = get_index(core);
+    pinned_words[index / 64].fetch_or(std::uint64_t(1) << (index % 64), std::memory_order_release);
+}
+
+bool tt_membar_dirty_cores::is_dirty(const tt_xy_pair& core) const {
+    const std::size_t index = get_index(core);
+    const std::uint64_t bit = std::uint64_t(1) << (index % 64);
+    return (words[index / 64].load(std::memory_order_acquire) | pinned_words[index / 64].load(std::memory_order_acquire)) & bit;
+}
+
+std::unordered_set<tt_xy_pair> tt_membar_dirty_cores::take(const std::unordered_set<tt_xy_pair>& candidates) {
+    std::unordered_set<tt_xy_pair> dirty = {};
+    for (const auto& core : candidates) {
+        if (is_dirty(core)) {
+            dirty.insert(core);
+        }
+    }
+    clear(dirty);
+    return dirty;
+}
+
+void tt_membar_dirty_cores::clear(const std::unordered_set<tt_xy_pair>& cores) {
+    std::array<std::uint64_t, TT_MEMBAR_MAX_CORES / 64> mask = {};
+    for (const auto& core : cores) {
+        const std::size_t index = get_index(core);
+        mask[index / 64] |= std::uint64_t(1) << (index % 64);
+    }
+    for (std::size_t i = 0; i < words.size(); i++) {
+        if (mask[i]) {
+            words[i].fetch_and(~mask[i], std::memory_order_acq_rel);
+        }
+    }
+}
@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "tt_xy_pair.h"
+#include "device/tt_cluster_descriptor_types.h"
+
+// Upper bound on the number of cores a single barrier can target (largest grid is 17x12).
+static constexpr std::size_t TT_MEMBAR_MAX_CORES = 256;
+
+//! Word accessors used to post and poll memory barrier flags on one chip.
+/*!
+    The driver implements this on top of its static/dynamic TLBs. Tests implement it with a model of the device.
+*/
+class tt_membar_io {
+    public:
+    virtual ~tt_membar_io() = default;
+    virtual void write_word(const tt_xy_pair& core, std::uint32_t address, std::uint32_t value) = 0;
+    virtual std::uint32_t read_word(const tt_xy_pair& core, std::uint32_t address) = 0;
+    // Cores that may be part of a multicast rectangle. Multicast is disabled unless this is overridden.
+    virtual bool can_multicast_to(const tt_xy_pair& /*core*/) const { return false; }
+    // Write value to every core in the [start, end] rectangle with a single transaction.
+    virtual void multicast_write_word(const tt_xy_pair& /*start*/, const tt_xy_pair& /*end*/, std::uint32_t /*address*/, std::uint32_t /*value*/) {}
+    // Called between posting all flag writes and polling, and once all cores acknowledged the flag.
+    virtual void flush_writes() {}
+    virtual void fence() {}
+};
+
+struct tt_multicast_grid {
+    tt_xy_pair start; // top left
+    tt_xy_pair end; // bottom right (inclusive)
+
+    bool contains(const tt_xy_pair& core) const {
+        return core.x >= start.x && core.x <= end.x && core.y >= start.y && core.y <= end.y;
+    }
+    std::size_t num_cores() const { return (end.x - start.x + 1) * (end.y - start.y + 1); }
+};
+
+/**
+ * @brief Split a set of cores into rectangles that can each be written with one multicast.
+ * Every core in a returned rectangle is part of cores, so a multicast never reaches a core outside the set. Rectangles
+ * are grown greedily (along x first) in row major order and are disjoint. Cores that don't fit in a rectangle of at
+ * least two cores are left out and must be written individually.
+ */
+std::vector<tt_multicast_grid> tt_get_multicast_grids(const std::unordered_set<tt_xy_pair>& cores);
+
+/**
+ * @brief Set a barrier flag on all cores and wait until every core reads it back.
+ * All writes are posted before any core is polled, and polling tracks outstanding cores in a fixed size bitmap, so a
+ * barrier costs (at most) one write and (at least) one read per core, and polling doesn't allocate.
+ * If io supports multicast, rectangles of multicast capable cores get the flag through a single multicast write
+ * (see tt_get_multicast_grids), the remaining cores are written one by one. Polling is always per core.
+ * \param io Accessors for the chip the cores are on
+ * \param cores Cores to set the flag on. At most TT_MEMBAR_MAX_CORES.
+ * \param address Address of the barrier flag on each core
+ * \param value Flag value to write and wait for
+ */
+void tt_set_membar_flag(tt_membar_io& io, const std::unordered_set<tt_xy_pair>& cores, std::uint32_t address, std::uint32_t value);
+
+//! Flag values for split phase memory barriers.
+/*!
+    Each barrier writes a fresh value instead of the shared SET/RESET pair, so no lock needs to be held while it is in
+    flight. Values always have the top bit set, so they never match tt_MemBarFlag, and start at a random point so stale
+    flags left by another driver instance are unlikely to acknowledge a barrier.
+*/
+class tt_membar_sequence {
+    public:
+    tt_membar_sequence();
+    explicit tt_membar_sequence(std::uint32_t start);
+
+    std::uint32_t next();
+    /**
+     * @brief Whether a flag read back from a core acknowledges the barrier that wrote sequence.
+     * True if the flag holds sequence, or a value handed out by this generator after it, which overwrote it.
+     */
+    bool acknowledges(std::uint32_t flag, std::uint32_t sequence) const;
+
+    private:
+    static constexpr std::uint32_t SEQUENCE_BIT = 0x80000000;
+    std::atomic<std::uint32_t> next_value;
+};
+
+struct tt_membar_target {
+    tt_xy_pair core;
+    std::uint32_t address;
+};
+
+//! Held by a split phase memory barrier until it completes, times out or is dropped.
+/*!
+    Owners release their per barrier state through the shared_ptr deleter, which can check whether the barrier
+    completed, ex: to mark the cores it was meant to flush dirty again.
+*/
+struct tt_membar_in_flight {
+    bool completed = false;
+};
+
+//! State of a split phase memory barrier on one chip, returned by tt_SiliconDevice::begin_membar.
+struct tt_membar_token {
+    chip_id_t chip = 0;
+    std::string fallback_tlb = "";
+    std::uint32_t sequence = 0;
+    std::vector<tt_membar_target> targets = {};
+    // Bit i is set while targets[i] hasn't acknowledged the barrier
+    std::bitset<TT_MEMBAR_MAX_CORES> pending = {};
+    // Barriers on remote chips wait for the non-MMIO queues to flush instead of polling flags
+    bool remote = false;
+    // Seconds after posting at which tt_test_membar gives up on the barrier and throws
+    int timeout = 1;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    // Held until the barrier completes or times out, so the owner can tell that it is still in flight
+    std::shared_ptr<tt_membar_in_flight> in_flight = nullptr;
+
+    bool is_complete() const { return pending.none(); }
+};
+
+/**
+ * @brief Post the barrier flag (token.sequence) to all of the token's targets and mark them pending.
+ * The token's deadline is set token.timeout seconds from now.
+ */
+void tt_begin_membar(tt_membar_io& io, tt_membar_token& token);
+/**
+ * @brief Read the flag of every pending target once, and clear the ones that acknowledged the barrier.
+ * Throws once the deadline passed with targets still pending, ex: because a flag was overwritten by a blocking barrier
+ * or another process. token.in_flight is released when the barrier completes (marked completed) or times out.
+ * \returns true once all targets acknowledged. The io is fenced when the barrier completes.
+ */
+bool tt_test_membar(tt_membar_io& io, tt_membar_token& token, const tt_membar_sequence& sequence);
+
+//! Cores of one chip that received posted writes since their last memory barrier.
+/*!
+    Cores are tracked in a fixed size bitmap over the NOC grid. Writers mark cores from any thread, and barriers take
+    (test and clear) the cores they are about to flush. Writers mark a core both before and after issuing a write:
+    marking before makes any barrier that starts while the write is in progress include the core, and marking after keeps
+    the core dirty for the next barrier if this one cleared it before the write was posted.
+    Cores written through paths the driver doesn't see (static TLB writers) are pinned, and stay dirty for good.
+*/
+class tt_membar_dirty_cores {
+    public:
+    explicit tt_membar_dirty_cores(const tt_xy_pair& grid_size);
+
+    void mark(const tt_xy_pair& core) {
+        const std::size_t index = get_index(core);
+        const std::uint64_t bit = std::uint64_t(1) << (index % 64);
+        auto& word = words[index / 64];
+        // Most writes go to cores that are already dirty, which only needs a load.
+        if (!(word.load(std::memory_order_relaxed) & bit)) {
+            word.fetch_or(bit, std::memory_order_release);
+        }
+    }
+    void mark_all();
+    /**
+     * @brief Mark every core in the [start, end] rectangle, as written by a multicast.
+     */
+    void mark_grid(const tt_xy_pair& start, const tt_xy_pair& end);
+    /**
+     * @brief Keep core dirty through every barrier, for cores written outside of the driver.
+     */
+    void pin(const tt_xy_pair& core);
+    bool is_dirty(const tt_xy_pair& core) const;
+    /**
+     * @brief Clear and return the dirty cores among candidates.
+     */
+    std::unordered_set<tt_xy_pair> take(const std::unordered_set<tt_xy_pair>& candidates);
+    /**
+     * @brief Clear cores that are about to be flushed by a barrier on an explicit set of cores.
+     */
+    void clear(const std::unordered_set<tt_xy_pair>& cores);
+
+    private:
+    std::size_t get_index(const tt_xy_pair& core) const;
+
+    tt_xy_pair grid_size;
+    std::array<std::atomic<std::uint64_t>, TT_MEMBAR_MAX_CORES / 64> words = {};
+    std::array<std::atomic<std::uint64_t>, TT_MEMBAR_MAX_CORES / 64> pinned_words = {};
+};
@@ -5,6 +5,8 @@
 #include <boost/interprocess/permissions.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 #include <boost/interprocess/sync/named_mutex.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #include <fstream>
 #include <iterator>
@@ -43,7 +45,11 @@
 #include "device/architecture.h"
 #include "device/architecture_implementation.h"
 #include "device/tlb.h"
+#include "device/tt_arc_msg.h"
 #include "device/tt_arch_types.h"
+#include "device/tt_device_bringup.h"
+#include "device/tt_eth_queue.h"
+#include "device/tt_membar.h"
 #include "tt_device.h"
 #include "kmdif.h"
 #include "ioctl.h"
@@ -122,11 +128,14 @@ const uint32_t HUGEPAGE_REGION_SIZE = 1 << 30; // 1GB
 const uint32_t DMA_MAP_MASK = DMA_BUF_REGION_SIZE - 1;
 const uint32_t HUGEPAGE_MAP_MASK = HUGEPAGE_REGION_SIZE - 1;
 
-static const uint32_t MSG_ERROR_REPLY = 0xFFFFFFFF;
+static const uint32_t MSG_ERROR_REPLY = TT_ARC_MSG_ERROR_REPLY;
 
 // Hardcode (but allow override) of path now, to support environments with other 1GB hugepage mounts not for runtime.
 const char* hugepage_dir_env = std::getenv("TT_BACKEND_HUGEPAGE_DIR");
 std::string hugepage_dir = hugepage_dir_env ? hugepage_dir_env : "/dev/hugepages-1G";
+// 2MB hugepages back the host memory channels when 1GB hugepages are missing or exhausted.
+const char* hugepage_2m_dir_env = std::getenv("TT_BACKEND_HUGEPAGE_2M_DIR");
+std::string hugepage_2m_dir = hugepage_2m_dir_env ? hugepage_2m_dir_env : "/dev/hugepages";
 
 // BAR0 size for Blackhole, used to determine whether write block should use BAR0 or BAR4
 const uint64_t BAR0_BH_SIZE = 512 * 1024 * 1024;
@@ -205,13 +214,14 @@ struct TTDevice : TTDeviceBase
     TTDevice(const TTDevice&) = delete;
     void operator = (const TTDevice&) = delete;
 
-    TTDevice(TTDevice &&that) : TTDeviceBase(std::move(that)), arch(that.arch), architecture_implementation(std::move(that.architecture_implementation)) { that.drop(); }
+    TTDevice(TTDevice &&that) : TTDeviceBase(std::move(that)), arch(that.arch), architecture_implementation(std::move(that.architecture_implementation)), tlb_operations(that.tlb_operations) { that.drop(); }
     TTDevice &operator = (TTDevice &&that) {
         reset();
 
         *static_cast<TTDeviceBase*>(this) = std::move(that);
         arch = that.arch;
         architecture_implementation = std::move(that.architecture_implementation);
+        tlb_operations = that.tlb_operations;
         that.drop();
 
         return *this;
@@ -227,6 +237,7 @@ struct TTDevice : TTDeviceBase
 
     tt::ARCH get_arch() const { return arch; }
     tt::umd::architecture_implementation* get_architecture_implementation() const { return architecture_implementation.get(); }
+    const tt::umd::tlb_operations& get_tlb_operations() const { return *tlb_operations; }
 
 private:
     TTDevice() = default;
@@ -291,6 +302,8 @@ private:
 
     tt::ARCH arch;
     std::unique_ptr<tt::umd::architecture_implementation> architecture_implementation;
+    // Resolved once at open so that TLB programming doesn't dispatch on the architecture per access.
+    const tt::umd::tlb_operations* tlb_operations = nullptr;
 };
 
 TTDevice TTDevice::open(unsigned int device_id) {
@@ -625,6 +638,7 @@ void TTDevice::do_open() {
 
     arch = detect_arch(this);
     architecture_implementation = tt::umd::architecture_implementation::create(static_cast<tt::umd::architecture>(arch));
+    tlb_operations = tt::umd::architecture_implementation::get_tlb_operations(static_cast<tt::umd::architecture>(arch));
 
     // GS+WH: ARC_SCRATCH[6], BH: NOC NODE_ID
     this->read_checking_offset = is_blackhole(device_info.out) ? BH_NOC_NODE_ID_OFFSET : GS_WH_ARC_SCRATCH_6_OFFSET;
@@ -1378,19 +1392,6 @@ struct dynamic_tlb {
     uint64_t remaining_size;    // Bytes remaining between bar_offset and end of the TLB.
 };
 
-struct routing_cmd_t {
-    uint64_t sys_addr;
-    uint32_t data;
-    uint32_t flags;
-    uint16_t rack;
-    uint16_t src_resp_buf_index;
-    uint32_t local_buf_index;
-    uint8_t  src_resp_q_id;
-    uint8_t  host_mem_txn_id;
-    uint16_t padding;
-    uint32_t src_addr_tag; //upper 32-bits of request source address.
-};
-
 struct remote_update_ptr_t{
   uint32_t ptr;
   uint32_t pad[3];
@@ -1425,26 +1426,18 @@ namespace {
 }
 // Get TLB index (from zero), check if it's in 16MB, 2MB or 1MB TLB range, and dynamically program it.
 dynamic_tlb set_dynamic_tlb(PCIdevice* dev, unsigned int tlb_index, tt_xy_pair start, tt_xy_pair end,
-                            std::uint64_t address, bool multicast, std::unordered_map<chip_id_t, std::unordered_map<tt_xy_pair, tt_xy_pair>>& harvested_coord_translation, std::uint64_t ordering) {
-    auto architecture_implementation = dev->hdev->get_architecture_implementation();
+                            std::uint64_t address, bool multicast, const tt_coord_translation_table& coord_translation, std::uint64_t ordering) {
     if (multicast) {
-        std::tie(start, end) = architecture_implementation->multicast_workaround(start, end);
+        std::tie(start, end) = dev->hdev->get_tlb_operations().multicast_workaround(start, end);
     }
 
     LOG2("set_dynamic_tlb with arguments: tlb_index = %d, start = (%d, %d), end = (%d, %d), address = 0x%x, multicast = %d, ordering = %d\n",
          tlb_index, start.x, start.y, end.x, end.y, address, multicast, (int)ordering);
 
-    tt::umd::tlb_configuration tlb_config = architecture_implementation->get_tlb_configuration(tlb_index);
-    std::uint32_t TLB_CFG_REG_SIZE_BYTES = architecture_implementation->get_tlb_cfg_reg_size_bytes();
-    auto translated_start_coords = harvested_coord_translation.at(dev -> logical_id).at(start);
-    auto translated_end_coords = harvested_coord_translation.at(dev -> logical_id).at(end);
-    uint32_t tlb_address    = address / tlb_config.size;
-    uint32_t local_offset   = address % tlb_config.size;
-    uint64_t tlb_base       = tlb_config.base + (tlb_config.size * tlb_config.index_offset);
-    uint32_t tlb_cfg_reg    = tlb_config.cfg_addr + (TLB_CFG_REG_SIZE_BYTES * tlb_config.index_offset);
-
-    std::pair<std::uint64_t, std::uint64_t> tlb_data = TLB_DATA {
-        .local_offset = tlb_address,
+    auto translated_start_coords = coord_translation.translate(start);
+    auto translated_end_coords = coord_translation.translate(end);
+
+    tt::umd::tlb_setup tlb_setup = dev->hdev->get_tlb_operations().get_dynamic_tlb_setup(tlb_index, address, TLB_DATA {
         .x_end = static_cast<uint64_t>(translated_end_coords.x),
         .y_end = static_cast<uint64_t>(translated_end_coords.y),
         .x_start = static_cast<uint64_t>(translated_start_coords.x),
@@ -1455,34 +1448,66 @@ dynamic_tlb set_dynamic_tlb(PCIdevice* dev, unsigned int tlb_index, tt_xy_pair s
         // Using the same static vc for reads and writes through TLBs can hang the card. It doesn't even have to be the same TLB.
         // Dynamic vc should not have this issue. There might be a perf impact with using dynamic vc.
         .static_vc = (dev->hdev->get_arch() == tt::ARCH::BLACKHOLE) ? false : true,
-    }.apply_offset(tlb_config.offset);
+    });
 
-    LOG1("set_dynamic_tlb() with tlb_index: %d tlb_index_offset: %d dynamic_tlb_size: %dMB tlb_base: 0x%x tlb_cfg_reg: 0x%x\n", tlb_index, tlb_config.index_offset, tlb_config.size/(1024*1024), tlb_base, tlb_cfg_reg);
-    // write_regs(dev -> hdev, tlb_cfg_reg, 2, &tlb_data);
-    write_tlb_reg(dev->hdev, tlb_cfg_reg, tlb_data.first, tlb_data.second, TLB_CFG_REG_SIZE_BYTES);
+    LOG1("set_dynamic_tlb() with tlb_index: %d bar_offset: 0x%x remaining_size: 0x%x tlb_cfg_reg: 0x%x\n", tlb_index, tlb_setup.bar_offset, tlb_setup.remaining_size, tlb_setup.cfg_reg);
+    write_tlb_reg(dev->hdev, tlb_setup.cfg_reg, tlb_setup.cfg_data.first, tlb_setup.cfg_data.second, tlb_setup.cfg_reg_size);
 
-    return { tlb_base + local_offset, tlb_config.size - local_offset };
+    return { tlb_setup.bar_offset, tlb_setup.remaining_size };
 }
 
-dynamic_tlb set_dynamic_tlb(PCIdevice *dev, unsigned int tlb_index, tt_xy_pair target, std::uint64_t address, std::unordered_map<chip_id_t, std::unordered_map<tt_xy_pair, tt_xy_pair>>& harvested_coord_translation, std::uint64_t ordering = TLB_DATA::Relaxed) {
-    return set_dynamic_tlb(dev, tlb_index, tt_xy_pair(0, 0), target, address, false, harvested_coord_translation, ordering);
+dynamic_tlb set_dynamic_tlb(PCIdevice *dev, unsigned int tlb_index, tt_xy_pair target, std::uint64_t address, const tt_coord_translation_table& coord_translation, std::uint64_t ordering = TLB_DATA::Relaxed) {
+    return set_dynamic_tlb(dev, tlb_index, tt_xy_pair(0, 0), target, address, false, coord_translation, ordering);
 }
 
-dynamic_tlb set_dynamic_tlb_broadcast(PCIdevice *dev, unsigned int tlb_index, std::uint64_t address, std::unordered_map<chip_id_t, std::unordered_map<tt_xy_pair, tt_xy_pair>>& harvested_coord_translation, tt_xy_pair start, tt_xy_pair end, std::uint64_t ordering = TLB_DATA::Relaxed) {
+dynamic_tlb set_dynamic_tlb_broadcast(PCIdevice *dev, unsigned int tlb_index, std::uint64_t address, const tt_coord_translation_table& coord_translation, tt_xy_pair start, tt_xy_pair end, std::uint64_t ordering = TLB_DATA::Relaxed) {
     // Issue a broadcast to cores included in the start (top left) and end (bottom right) grid
     return set_dynamic_tlb (dev, tlb_index, start, end,
-                            address, true, harvested_coord_translation, ordering);
+                            address, true, coord_translation, ordering);
+}
+
+tt_static_tlb_table tt_static_tlb_table::create(const tt::umd::architecture_implementation* architecture_implementation, const std::function<std::int32_t(tt_xy_pair)>& mapping_function,
+                                                const std::unordered_map<std::int32_t, std::uint64_t>& configured_tlbs) {
+    tt_static_tlb_table table = {};
+    table.grid_size = tt_xy_pair(architecture_implementation->get_grid_size_x(), architecture_implementation->get_grid_size_y());
+    table.entries.resize(table.grid_size.x * table.grid_size.y);
+    for(std::size_t y = 0; y < table.grid_size.y; y++) {
+        for(std::size_t x = 0; x < table.grid_size.x; x++) {
+            std::int32_t tlb_index = mapping_function(tt_xy_pair(x, y));
+            auto tlb_data = architecture_implementation->describe_tlb(tlb_index);
+            if(!tlb_data.has_value()) {
+                continue;
+            }
+            tt_static_tlb_entry& entry = table.entries.at(y * table.grid_size.x + x);
+            entry.tlb_index = tlb_index;
+            std::tie(entry.bar_offset, entry.size) = tlb_data.value();
+            if(configured_tlbs.find(tlb_index) != configured_tlbs.end()) {
+                entry.mapped_base = configured_tlbs.at(tlb_index);
+                entry.configured = true;
+            }
+        }
+    }
+    return table;
 }
 
-bool tt_SiliconDevice::address_in_tlb_space(uint32_t address, uint32_t size_in_bytes, int32_t tlb_index, uint64_t tlb_size, std::uint32_t chip) {
-    return ((tlb_config_map.at(chip).find(tlb_index) != tlb_config_map.at(chip).end()) && address >= tlb_config_map.at(chip).at(tlb_index) && (address + size_in_bytes <= tlb_config_map.at(chip).at(tlb_index) + tlb_size));
+void tt_static_tlb_table::configure(std::int32_t tlb_index, std::uint64_t mapped_base) {
+    for(auto& entry : entries) {
+        if(entry.tlb_index == tlb_index) {
+            entry.mapped_base = mapped_base;
+            entry.configured = true;
+        }
+    }
 }
 
-tt_SocDescriptor& tt_SiliconDevice::get_soc_descriptor(chip_id_t chip_id){
+const tt_SocDescriptor& tt_SiliconDevice::get_soc_descriptor(chip_id_t chip_id){
     return soc_descriptor_per_chip.at(chip_id);
 }
 
 std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_SiliconDevice::get_virtual_soc_descriptors() {
+    return get_soc_descriptor_copies();
+}
+
+const tt_soc_descriptor_map& tt_SiliconDevice::get_virtual_soc_descriptor_map() {
     return soc_descriptor_per_chip;
 }
 
@@ -1510,6 +1535,14 @@ void tt_SiliconDevice::initialize_interprocess_mutexes(int pci_interface_id, boo
     if (cleanup_mutexes_in_shm) named_mutex::remove(mutex_name.c_str());
     hardware_resource_mutex_map[mutex_name] = std::make_shared<named_mutex>(open_or_create, mutex_name.c_str(), unrestricted_permissions);
 
+    // Initialize the marker of ARC messages in flight, which lives next to the ARC core mutex. New shared memory is zeroed,
+    // so it starts out without a message in flight.
+    std::string marker_name = ARC_MSG_IN_FLIGHT_NAME + std::to_string(pci_interface_id);
+    if (cleanup_mutexes_in_shm) shared_memory_object::remove(marker_name.c_str());
+    shared_memory_object marker_shm = shared_memory_object(open_or_create, marker_name.c_str(), read_write, unrestricted_permissions);
+    marker_shm.truncate(sizeof(tt_arc_msg_in_flight_marker));
+    arc_msg_in_flight_markers[marker_name] = std::make_shared<mapped_region>(marker_shm, read_write);
+
     if (arch_name == tt::ARCH::WORMHOLE or arch_name == tt::ARCH::WORMHOLE_B0) {
         mutex_name = NON_MMIO_MUTEX_NAME + std::to_string(pci_interface_id);
         // Initialize non-MMIO mutexes for WH devices regardless of number of chips, since these may be used for ethernet broadcast
@@ -1547,6 +1580,12 @@ void tt_SiliconDevice::create_device(const std::unordered_set<chip_id_t> &target
     }
     LOG1 ("TT_PCI_DMA_BUF_SIZE=%d\n", m_dma_buf_size);
 
+    const char* sysmem_streaming_threshold_env = std::getenv("TT_PCI_SYSMEM_STREAMING_THRESHOLD");
+    if (sysmem_streaming_threshold_env) {
+        sysmem_streaming_threshold = std::strtoull(sysmem_streaming_threshold_env, nullptr, 0);
+    }
+    telemetry_cache.set_ttl(tt_telemetry_cache::get_default_ttl());
+
     // Don't buffer stdout.
     setbuf(stdout, NULL);
 
@@ -1555,16 +1594,40 @@ void tt_SiliconDevice::create_device(const std::unordered_set<chip_id_t> &target
 
     log_assert(target_mmio_device_ids.size() > 0, "Must provide set of target_mmio_device_ids to tt_SiliconDevice constructor now.");
 
-    for (const chip_id_t &logical_device_id : target_mmio_device_ids) {
-        m_pci_device_map.insert({logical_device_id, new struct PCIdevice});
-        struct PCIdevice* pci_device = m_pci_device_map.at(logical_device_id);
+    // Per-device steps (opening the device, mapping and pinning hugepages) are independent across devices and run concurrently,
+    // with each worker pinned to the NUMA node of its device. Steps touching shared driver state run serially between them.
+    std::vector<chip_id_t> mmio_devices = std::vector<chip_id_t>(target_mmio_device_ids.begin(), target_mmio_device_ids.end());
+    std::sort(mmio_devices.begin(), mmio_devices.end());
+    tt_device_bringup bringup = tt_device_bringup(tt_device_bringup::get_default_max_threads(mmio_devices.size()),
+        [this] (chip_id_t logical_device_id) { tt::cpuset::tt_cpuset_allocator::bind_thread_to_cpuset(ndesc.get(), logical_device_id); },
+        [] () { tt::cpuset::tt_cpuset_allocator::unbind_thread_from_cpuset(); });
 
+    tt_mmio_device_bringup_steps steps = {};
+    steps.allocate_device = [&] (chip_id_t logical_device_id) {
         log_assert(logical_to_physical_device_id_map.count(logical_device_id) != 0, "Cannot find logical mmio device_id: {} in cluster desc / logical-to-physical-map", logical_device_id);
-        int pci_interface_id = logical_to_physical_device_id_map.at(logical_device_id);
+        m_pci_device_map.insert({logical_device_id, new struct PCIdevice});
+
+        // Initialize these. Used to be in header file.
+        for (int ch = 0; ch < g_MAX_HOST_MEM_CHANNELS; ch ++) {
+            hugepage_mapping[logical_device_id][ch]= nullptr;
+            hugepage_mapping_size[logical_device_id][ch] = 0;
+            hugepage_physical_address[logical_device_id][ch] = 0;
+            hugepage_channels[logical_device_id][ch] = {};
+        }
+        sysmem_map.add_device(logical_device_id);
+    };
 
+    steps.open_device = [&] (chip_id_t logical_device_id) {
+        int pci_interface_id = logical_to_physical_device_id_map.at(logical_device_id);
         log_debug(LogSiliconDriver, "Opening TT_PCI_INTERFACE_ID {} for netlist target_device_id: {}", pci_interface_id, logical_device_id);
+        struct PCIdevice* pci_device = m_pci_device_map.at(logical_device_id);
         *pci_device = ttkmd_open ((DWORD) pci_interface_id, false);
         pci_device->logical_id = logical_device_id;
+    };
+
+    steps.configure_device = [&] (chip_id_t logical_device_id) {
+        struct PCIdevice* pci_device = m_pci_device_map.at(logical_device_id);
+        int pci_interface_id = logical_to_physical_device_id_map.at(logical_device_id);
 
         m_num_host_mem_channels = get_available_num_host_mem_channels(num_host_mem_ch_per_mmio_device, pci_device->device_id, pci_device->revision_id);
         if (arch_name == tt::ARCH::BLACKHOLE && m_num_host_mem_channels > 1) {
@@ -1576,38 +1639,49 @@ void tt_SiliconDevice::create_device(const std::unordered_set<chip_id_t> &target
         log_debug(LogSiliconDriver, "Using {} Hugepages/NumHostMemChannels for TTDevice (logical_device_id: {} pci_interface_id: {} device_id: 0x{:x} revision: {})",
             m_num_host_mem_channels, logical_device_id, pci_interface_id, pci_device->device_id, pci_device->revision_id);
 
+        initialize_interprocess_mutexes(pci_interface_id, clean_system_resources);
+
+        if (!skip_driver_allocs)
+            print_device_info (*pci_device);
+
+        harvested_coord_translation.insert({logical_device_id, create_harvested_coord_translation(arch_name, true)}); //translation layer for harvested coords. Default is identity map
+        // The device is already open, no need to open it again to find its arch
+        archs_in_cluster.push_back(detect_arch(pci_device));
+    };
+
+    // MT: Initial BH - hugepages will fail init
+    // For using silicon driver without workload to query mission mode params, no need for hugepage/dmabuf.
+    steps.open_hugepage_fds = [&] (chip_id_t logical_device_id) {
         if (g_SINGLE_PIN_PAGE_PER_FD_WORKAROND) {
-            pci_device->hdev->open_hugepage_per_host_mem_ch(m_num_host_mem_channels);
+            m_pci_device_map.at(logical_device_id)->hdev->open_hugepage_per_host_mem_ch(m_num_host_mem_channels);
         }
+    };
 
-        // Initialize these. Used to be in header file.
-        for (int ch = 0; ch < g_MAX_HOST_MEM_CHANNELS; ch ++) {
-            hugepage_mapping[logical_device_id][ch]= nullptr;
-            hugepage_mapping_size[logical_device_id][ch] = 0;
-            hugepage_physical_address[logical_device_id][ch] = 0;
+    if (!skip_driver_allocs) {
+        // Populating hugepages is slow, so by default they are mapped in the background and accessors of a channel wait
+        // for it. Eagerly mapped channels are set up concurrently per device, on threads pinned to the device.
+        const tt_hugepage_init_mode hugepage_init_mode = tt_hugepage_channel_loader::get_default_mode();
+        const auto init_host_channel_fn = [this] (chip_id_t logical_device_id, uint16_t channel) { init_host_channel(logical_device_id, channel); };
+        if (hugepage_init_mode == tt_hugepage_init_mode::Eager) {
+            steps.start_hugepage_init = [&, init_host_channel_fn] () {
+                hugepage_loader.start(tt_hugepage_init_mode::OnFirstUse, mmio_devices, m_num_host_mem_channels, init_host_channel_fn);
+            };
+            steps.init_hugepages = [&] (chip_id_t logical_device_id) {
+                hugepage_loader.wait_for_device(logical_device_id);
+            };
+        } else {
+            steps.start_hugepage_init = [&, hugepage_init_mode, init_host_channel_fn] () {
+                hugepage_loader.start(hugepage_init_mode, mmio_devices, m_num_host_mem_channels, init_host_channel_fn);
+            };
         }
+    }
 
-        initialize_interprocess_mutexes(pci_interface_id, clean_system_resources);
+    bringup.bring_up_mmio_devices(mmio_devices, steps);
 
-        if (!skip_driver_allocs)
-            print_device_info (*pci_device);
+    bringup_phase_timings = bringup.get_phase_timings();
 
-        // MT: Initial BH - hugepages will fail init
-        // For using silicon driver without workload to query mission mode params, no need for hugepage/dmabuf.
-        if (!skip_driver_allocs){
-            bool hugepages_initialized = init_hugepage(logical_device_id);
-            // Large writes to remote chips require hugepages to be initialized.
-            // Conservative assert - end workload if remote chips present but hugepages not initialized (failures caused if using remote only for small transactions)
-            if(target_remote_chips.size()) {
-                log_assert(hugepages_initialized, "Hugepages must be successfully initialized if workload contains remote chips!");
-            }
-            uint16_t channel = 0; // Single channel sufficient for this?
-            if (not hugepage_mapping.at(logical_device_id).at(channel)) {
-                init_dmabuf(logical_device_id);
-            }
-        }
-        harvested_coord_translation.insert({logical_device_id, create_harvested_coord_translation(arch_name, true)}); //translation layer for harvested coords. Default is identity map
-        archs_in_cluster.push_back(detect_arch(logical_to_physical_device_id_map.at(logical_device_id)));
+    if (const std::size_t max_io_workers = tt_io_worker_pool::get_default_max_workers_per_device()) {
+        start_io_workers(max_io_workers);
     }
 
     for(const chip_id_t& chip : target_devices_in_cluster) {
@@ -1626,6 +1700,18 @@ bool tt_SiliconDevice::using_harvested_soc_descriptors() {
 }
 
 std::unordered_map<tt_xy_pair, tt_xy_pair> tt_SiliconDevice::get_harvested_coord_translation_map(chip_id_t logical_device_id) {
+    const auto& coord_translation = harvested_coord_translation.at(logical_device_id);
+    std::unordered_map<tt_xy_pair, tt_xy_pair> translation_map = {};
+    for(std::size_t x = 0; x < coord_translation.grid_size.x; x++) {
+        for(std::size_t y = 0; y < coord_translation.grid_size.y; y++) {
+            tt_xy_pair curr_core = tt_xy_pair(x, y);
+            translation_map.insert({curr_core, coord_translation.translate(curr_core)});
+        }
+    }
+    return translation_map;
+}
+
+const tt_coord_translation_table& tt_SiliconDevice::get_coord_translation_table(chip_id_t logical_device_id) const {
     return harvested_coord_translation.at(logical_device_id);
 }
 
@@ -1770,7 +1856,9 @@ tt_SiliconDevice::tt_SiliconDevice(const std::string &sdesc_path, const std::str
     if(arch_name == tt::ARCH::WORMHOLE or arch_name == tt::ARCH::WORMHOLE_B0) {
         remote_transfer_ethernet_cores.resize(target_mmio_device_ids.size());
         for (const auto &logical_mmio_chip_id : target_mmio_device_ids) {
-            tt_SocDescriptor& soc_desc = get_soc_descriptor(logical_mmio_chip_id);
+            // Each gateway cycles through its own ethernet cores, so transfers through different gateways can run concurrently.
+            active_core.insert({logical_mmio_chip_id, NON_EPOCH_ETH_CORES_START_ID});
+            const tt_SocDescriptor& soc_desc = get_soc_descriptor(logical_mmio_chip_id);
             // 4-5 is for send_epoch_commands, 0-3 are for everything else
             for (std::uint32_t i = 0; i < NUM_ETH_CORES_FOR_NON_MMIO_TRANSFERS; i++) {
                 if(remote_transfer_ethernet_cores.size() <= logical_mmio_chip_id) {
@@ -1808,12 +1896,12 @@ void tt_SiliconDevice::configure_active_ethernet_cores_for_mmio_device(chip_id_t
 
 void tt_SiliconDevice::populate_cores() {
     std::uint32_t count = 0;
-    for(const auto chip : soc_descriptor_per_chip) {
-        workers_per_chip.insert({chip.first, std::unordered_set<tt_xy_pair>(chip.second.workers.begin(), chip.second.workers.end())});
+    for(const auto& chip : soc_descriptor_per_chip) {
+        workers_per_chip.insert({chip.first, std::unordered_set<tt_xy_pair>(chip.second->workers.begin(), chip.second->workers.end())});
         if(count == 0) {
-            eth_cores = std::unordered_set<tt_xy_pair>(chip.second.ethernet_cores.begin(), chip.second.ethernet_cores.end());
-            for(std::uint32_t dram_idx = 0; dram_idx < chip.second.get_num_dram_channels(); dram_idx++) {
-                dram_cores.insert(chip.second.get_core_for_dram_channel(dram_idx, 0)) ;
+            eth_cores = std::unordered_set<tt_xy_pair>(chip.second->ethernet_cores.begin(), chip.second->ethernet_cores.end());
+            for(std::uint32_t dram_idx = 0; dram_idx < chip.second->get_num_dram_channels(); dram_idx++) {
+                dram_cores.insert(chip.second->get_core_for_dram_channel(dram_idx, 0)) ;
             }
         }
         count++;
@@ -1888,15 +1976,33 @@ void tt_SiliconDevice::harvest_rows_in_soc_descriptor(tt::ARCH arch, tt_SocDescr
     remove_worker_row_from_descriptor(sdesc, row_coordinates_to_remove);
 }
 
-void tt_SiliconDevice::perform_harvesting_and_populate_soc_descriptors(const std::string& sdesc_path, const bool perform_harvesting) {
-    const auto default_sdesc = tt_SocDescriptor(sdesc_path);
-    for(const auto& chip : harvested_rows_per_target) {
-        auto temp_sdesc = default_sdesc;
-        if(perform_harvesting) {
-            harvest_rows_in_soc_descriptor(arch_name, temp_sdesc, chip.second);
+tt_soc_descriptor_map tt_SiliconDevice::create_soc_descriptors(tt::ARCH arch, const std::string& sdesc_path, const std::unordered_map<chip_id_t, uint32_t>& harvested_rows_per_chip, const bool perform_harvesting) {
+    // Descriptors are interned by (arch, harvesting mask): each layout is parsed/harvested once and shared by all chips with that layout.
+    std::map<std::pair<tt::ARCH, uint32_t>, std::shared_ptr<const tt_SocDescriptor>> interned_descriptors = {};
+    std::shared_ptr<const tt_SocDescriptor> default_sdesc = nullptr;
+    tt_soc_descriptor_map soc_descriptors = {};
+    for(const auto& [chip, harvested_rows] : harvested_rows_per_chip) {
+        const uint32_t harvesting_mask = perform_harvesting ? harvested_rows : 0;
+        auto& sdesc = interned_descriptors[{arch, harvesting_mask}];
+        if(sdesc == nullptr) {
+            if(default_sdesc == nullptr) {
+                default_sdesc = std::make_shared<const tt_SocDescriptor>(sdesc_path);
+            }
+            if(perform_harvesting) {
+                auto harvested_sdesc = std::make_shared<tt_SocDescriptor>(*default_sdesc);
+                harvest_rows_in_soc_descriptor(arch, *harvested_sdesc, harvesting_mask);
+                sdesc = std::move(harvested_sdesc);
+            } else {
+                sdesc = default_sdesc;
+            }
         }
-        soc_descriptor_per_chip.insert({chip.first, temp_sdesc});
+        soc_descriptors.insert(chip, sdesc);
     }
+    return soc_descriptors;
+}
+
+void tt_SiliconDevice::perform_harvesting_and_populate_soc_descriptors(const std::string& sdesc_path, const bool perform_harvesting) {
+    soc_descriptor_per_chip = create_soc_descriptors(arch_name, sdesc_path, harvested_rows_per_target, perform_harvesting);
 }
 
 void tt_SiliconDevice::check_pcie_device_initialized(int device_id) {
@@ -1945,9 +2051,9 @@ void tt_SiliconDevice::check_pcie_device_initialized(int device_id) {
     }
 }
 
-std::unordered_map<tt_xy_pair, tt_xy_pair> tt_SiliconDevice::create_harvested_coord_translation(const tt::ARCH arch, bool identity_map) {
+tt_coord_translation_table tt_SiliconDevice::create_harvested_coord_translation(const tt::ARCH arch, bool identity_map) {
     log_assert(identity_map ? true : (arch != tt::ARCH::GRAYSKULL), "NOC Translation can only be performed for WH devices");
-    std::unordered_map<tt_xy_pair, tt_xy_pair> translation_table = {};
+    tt_coord_translation_table translation_table = {};
 
     tt_xy_pair grid_size;
     std::vector<uint32_t> T6_x = {};
@@ -1972,17 +2078,16 @@ std::unordered_map<tt_xy_pair, tt_xy_pair> tt_SiliconDevice::create_harvested_co
     }
 
     
+    translation_table.grid_size = grid_size;
     if(identity_map) {
         // When device is initialized, assume no harvesting and create an identity map for cores
         // This flow is always used for GS, since there is no hardware harvesting
-        for(int x = 0; x < grid_size.x; x++) {
-            for(int y = 0; y < grid_size.y; y++) {
-                tt_xy_pair curr_core = tt_xy_pair(x, y);
-                translation_table.insert({curr_core, curr_core});
-            }
-        }
+        // Identity tables only bounds check coordinates, so no entries are stored.
+        translation_table.identity = true;
         return translation_table;
     }
+    translation_table.identity = false;
+    translation_table.translated_coords.resize(grid_size.x * grid_size.y);
 
     // If this function is called with identity_map = false, we have perform NOC translation
     // This can only happen for WH devices
@@ -2002,7 +2107,7 @@ std::unordered_map<tt_xy_pair, tt_xy_pair> tt_SiliconDevice::create_harvested_co
                 if(y >= 1 && y <= 5) harvested_worker.y = y + 17;
                 else if(y <= 11 && y > 6) harvested_worker.y = y + 16;
                 else log_assert(false, "Invalid WH worker y coord {} when creating translation tables.", y);
-                translation_table.insert({curr_core, harvested_worker});
+                translation_table.translated_coords.at(y * grid_size.x + x) = harvested_worker;
             }
 
             else if(std::find(ethernet.begin(), ethernet.end(), curr_core) != ethernet.end()){
@@ -2015,12 +2120,12 @@ std::unordered_map<tt_xy_pair, tt_xy_pair> tt_SiliconDevice::create_harvested_co
                 if(y == 0) harvested_eth_core.y = y + 16;
                 else if(y == 6) harvested_eth_core.y = y + 11;
                 else log_assert(false, "Invalid WH eth_core y coord {} when creating translation tables.", y);
-                translation_table.insert({curr_core, harvested_eth_core});
+                translation_table.translated_coords.at(y * grid_size.x + x) = harvested_eth_core;
             }
 
             else {
                 // All other cores for WH are not translated in case of harvesting.
-                translation_table.insert({curr_core, curr_core});
+                translation_table.translated_coords.at(y * grid_size.x + x) = curr_core;
             }
         }
     }
@@ -2028,7 +2133,7 @@ std::unordered_map<tt_xy_pair, tt_xy_pair> tt_SiliconDevice::create_harvested_co
 }
 
 void tt_SiliconDevice::translate_to_noc_table_coords(chip_id_t device_id, std::size_t &r, std::size_t &c) {
-    auto translated_coords = harvested_coord_translation[device_id].at(tt_xy_pair(c, r));
+    auto translated_coords = harvested_coord_translation.at(device_id).translate(tt_xy_pair(c, r));
     c = translated_coords.x;
     r = translated_coords.y;
 }
@@ -2091,7 +2196,7 @@ void tt_SiliconDevice::broadcast_pcie_tensix_risc_reset(struct PCIdevice *device
     LOG1("== For all tensix set soft-reset for %s risc cores.\n", TensixSoftResetOptionsToString(valid).c_str());
 
     auto architecture_implementation = device->hdev->get_architecture_implementation();
-    auto [soft_reset_reg, _] = set_dynamic_tlb_broadcast(device, architecture_implementation->get_reg_tlb(), architecture_implementation->get_tensix_soft_reset_addr(), harvested_coord_translation, tt_xy_pair(0, 0), 
+    auto [soft_reset_reg, _] = set_dynamic_tlb_broadcast(device, architecture_implementation->get_reg_tlb(), architecture_implementation->get_tensix_soft_reset_addr(), harvested_coord_translation.at(device -> logical_id), tt_xy_pair(0, 0), 
                                 tt_xy_pair(architecture_implementation->get_grid_size_x() - 1, architecture_implementation->get_grid_size_y() - 1 - num_rows_harvested.at(device -> logical_id)), TLB_DATA::Posted);
     write_regs(device->hdev, soft_reset_reg, 1, &valid);
     tt_driver_atomics::sfence();
@@ -2115,33 +2220,68 @@ void tt_SiliconDevice::deassert_risc_reset() {
 }
 
 void tt_SiliconDevice::deassert_risc_reset_at_core(tt_cxy_pair core) {
-    std::uint32_t target_device = core.chip; // Get Target Device to query soc descriptor and determine location in cluster
-    log_assert(std::find(get_soc_descriptor(target_device).workers.begin(), get_soc_descriptor(target_device).workers.end(), core) != get_soc_descriptor(target_device).workers.end() ||
-               std::find(get_soc_descriptor(target_device).ethernet_cores.begin(), get_soc_descriptor(target_device).ethernet_cores.end(), core) != get_soc_descriptor(target_device).ethernet_cores.end(),
-                                "Cannot deassert reset on a non-tensix or harvested core");
-    bool target_is_mmio_capable = ndesc -> is_chip_mmio_capable(target_device);
-    if(target_is_mmio_capable) {
-        log_assert(m_pci_device_map.find(target_device) != m_pci_device_map.end(), "Could not find MMIO mapped device in devices connected over PCIe");
-        send_tensix_risc_reset_to_core(core, TENSIX_DEASSERT_SOFT_RESET);
+    set_risc_reset_state(core.chip, {tt_xy_pair(core.x, core.y)}, TENSIX_DEASSERT_SOFT_RESET);
+}
+
+void tt_SiliconDevice::assert_risc_reset_at_core(tt_cxy_pair core) {
+    set_risc_reset_state(core.chip, {tt_xy_pair(core.x, core.y)}, TENSIX_ASSERT_SOFT_RESET);
+}
+
+void tt_SiliconDevice::get_risc_reset_targets(chip_id_t chip, const std::unordered_set<tt_xy_pair>& workers, const std::unordered_set<tt_xy_pair>& eth_cores,
+                                              const std::unordered_set<tt_xy_pair>& cores, bool use_multicast,
+                                              std::vector<tt_multicast_grid>& grids, std::vector<tt_xy_pair>& unicast_cores) {
+    std::unordered_set<tt_xy_pair> multicast_cores = {};
+    for (const auto& core : cores) {
+        const bool is_worker = workers.find(core) != workers.end();
+        log_assert(is_worker || eth_cores.find(core) != eth_cores.end(), "Cannot set reset state on core {} of chip {}: not a tensix or ethernet core, or harvested", core.str(), chip);
+        if (is_worker && use_multicast) {
+            multicast_cores.insert(core);
+        }
     }
-    else {
-        log_assert(arch_name != tt::ARCH::BLACKHOLE, "Can't issue access to remote core in BH");
-        send_remote_tensix_risc_reset_to_core(core, TENSIX_DEASSERT_SOFT_RESET);
+    grids = tt_get_multicast_grids(multicast_cores);
+    unicast_cores.clear();
+    for (const auto& core : cores) {
+        if (std::none_of(grids.begin(), grids.end(), [&] (const tt_multicast_grid& grid) { return grid.contains(core); })) {
+            unicast_cores.push_back(core);
+        }
     }
 }
 
-void tt_SiliconDevice::assert_risc_reset_at_core(tt_cxy_pair core) {
-    std::uint32_t target_device = core.chip; // Get Target Device to query soc descriptor and determine location in cluster
-    log_assert(std::find(get_soc_descriptor(target_device).workers.begin(), get_soc_descriptor(target_device).workers.end(), core) != get_soc_descriptor(target_device).workers.end() ||
-               std::find(get_soc_descriptor(target_device).ethernet_cores.begin(), get_soc_descriptor(target_device).ethernet_cores.end(), core) != get_soc_descriptor(target_device).ethernet_cores.end(),
-                                "Cannot assert reset on a non-tensix or harvested core");
-    bool target_is_mmio_capable = ndesc -> is_chip_mmio_capable(target_device);
-    if(target_is_mmio_capable) {
-        log_assert(m_pci_device_map.find(target_device) != m_pci_device_map.end(), "Could not find MMIO mapped device in devices connected over PCIe");
-        send_tensix_risc_reset_to_core(core, TENSIX_ASSERT_SOFT_RESET);
+void tt_SiliconDevice::set_risc_reset_state(chip_id_t chip, const std::unordered_set<tt_xy_pair>& cores, const TensixSoftResetOptions& soft_resets) {
+    const bool is_mmio_chip = ndesc -> is_chip_mmio_capable(chip);
+    std::vector<tt_multicast_grid> grids = {};
+    std::vector<tt_xy_pair> unicast_cores = {};
+    get_risc_reset_targets(chip, workers_per_chip.at(chip), eth_cores, cores, is_mmio_chip, grids, unicast_cores);
+    auto valid = soft_resets & ALL_TENSIX_SOFT_RESET;
+    uint32_t valid_val = (std::underlying_type<TensixSoftResetOptions>::type) valid;
+    const uint32_t soft_reset_addr = tt::umd::architecture_implementation::create(static_cast<tt::umd::architecture>(arch_name))->get_tensix_soft_reset_addr();
+
+    if(is_mmio_chip) {
+        log_assert(m_pci_device_map.find(chip) != m_pci_device_map.end(), "Could not find MMIO mapped device in devices connected over PCIe");
+        // Rectangles of Tensix cores get the reset signal through one multicast. All register writes are posted under a single
+        // REG_TLB acquisition and fenced once.
+        struct PCIdevice* pci_device = get_pci_device(chip);
+        TTDevice *dev = pci_device->hdev;
+        const auto tlb_index = dynamic_tlb_config.at("REG_TLB");
+        const auto& coord_translation = harvested_coord_translation.at(chip);
+        const scoped_lock<named_mutex> lock(*get_mutex("REG_TLB", pci_device -> id));
+        for (const auto& grid : grids) {
+            auto [mapped_address, _] = set_dynamic_tlb_broadcast(pci_device, tlb_index, soft_reset_addr, coord_translation, grid.start, grid.end, TLB_DATA::Posted);
+            write_regs(dev, mapped_address, 1, &valid_val);
+        }
+        for (const auto& core : unicast_cores) {
+            auto [mapped_address, _] = set_dynamic_tlb(pci_device, tlb_index, tt_cxy_pair(chip, core), soft_reset_addr, coord_translation, TLB_DATA::Strict);
+            write_regs(dev, mapped_address, 1, &valid_val);
+        }
+        tt_driver_atomics::sfence();
     }
     else {
-        send_remote_tensix_risc_reset_to_core(core, TENSIX_ASSERT_SOFT_RESET);
+        log_assert(arch_name != tt::ARCH::BLACKHOLE, "Can't issue access to remote core in BH");
+        // Remote chips can't be multicast to: every core costs an ethernet round trip.
+        for (const auto& core : unicast_cores) {
+            write_to_non_mmio_device(&valid_val, sizeof(uint32_t), tt_cxy_pair(chip, core), soft_reset_addr);
+        }
+        tt_driver_atomics::sfence();
     }
 }
 
@@ -2152,6 +2292,10 @@ void tt_SiliconDevice::cleanup_shared_host_state() {
         mutex.second = nullptr;
         named_mutex::remove(mutex.first.c_str());
     }
+    for (auto &marker : arc_msg_in_flight_markers) {
+        marker.second.reset();
+        shared_memory_object::remove(marker.first.c_str());
+    }
 }
 
 std::unordered_set<chip_id_t> tt_SiliconDevice::get_all_chips_in_cluster() {
@@ -2206,7 +2350,7 @@ tt::Writer tt_SiliconDevice::get_static_tlb_writer(tt_cxy_pair target) {
         throw std::runtime_error("Target not in MMIO chip: " + target.str());
     }
 
-    if (!tlbs_init || !map_core_to_tlb) {
+    if (!tlbs_init) {
         throw std::runtime_error("TLBs not initialized");
     }
 
@@ -2217,20 +2361,31 @@ tt::Writer tt_SiliconDevice::get_static_tlb_writer(tt_cxy_pair target) {
         throw std::runtime_error("No write-combined mapping for BAR0");
     }
 
-    auto tlb_index = map_core_to_tlb(tt_xy_pair(target.x, target.y));
-    auto tlb_data = dev->get_architecture_implementation()->describe_tlb(tlb_index);
+    const tt_static_tlb_entry* static_tlb = get_static_tlb_entry(target);
 
-    if (!tlb_data.has_value()) {
+    if (!static_tlb) {
         throw std::runtime_error("No TLB mapped to core " + target.str());
     }
 
-    auto [tlb_offset, tlb_size] = tlb_data.value();
+    {
+        // Writes through the returned writer bypass the driver, so the core can't be tracked anymore.
+        const std::lock_guard<std::mutex> lock(static_tlb_writer_cores_mutex);
+        static_tlb_writer_cores.insert(target);
+        if (auto dirty_cores = get_membar_dirty_cores(target.chip)) {
+            dirty_cores->pin(target);
+        }
+    }
+
     auto *base = reinterpret_cast<uint8_t *>(dev->bar0_wc);
 
-    return tt::Writer(base + tlb_offset, tlb_size);
+    return tt::Writer(base + static_tlb->bar_offset, static_tlb->size);
 }
 
-void tt_SiliconDevice::write_device_memory(const void *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair target, std::uint32_t address, const std::string& fallback_tlb) {
+void tt_SiliconDevice::write_device_memory(const void *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair target, std::uint32_t address, const std::string& fallback_tlb, bool mark_membar_dirty) {
+    tt_membar_dirty_cores* dirty_cores = mark_membar_dirty ? get_membar_dirty_cores(target.chip) : nullptr;
+    if (dirty_cores) {
+        dirty_cores->mark(target);
+    }
     struct PCIdevice* pci_device = get_pci_device(target.chip);
     TTDevice *dev = pci_device->hdev;
 
@@ -2239,15 +2394,11 @@ void tt_SiliconDevice::write_device_memory(const void *mem_ptr, uint32_t size_in
     // LOG1("---- tt_SiliconDevice::write_device_memory to chip:%lu %lu-%lu at 0x%x size_in_bytes: %d small_access: %d\n",
     //     target.chip, target.x, target.y, address, size_in_bytes, small_access);
 
-    std::int32_t tlb_index = 0;
-    std::optional<std::tuple<std::uint64_t, std::uint64_t>> tlb_data = std::nullopt;
-    if(tlbs_init) {
-        tlb_index = map_core_to_tlb(tt_xy_pair(target.x, target.y));
-        tlb_data = dev->get_architecture_implementation()->describe_tlb(tlb_index);
-    }
+    const tt_static_tlb_entry* static_tlb = get_static_tlb_entry(target);
 
-    if (tlb_data.has_value() && address_in_tlb_space(address, size_in_bytes, tlb_index, std::get<1>(tlb_data.value()), target.chip)) {
-        auto [tlb_offset, tlb_size] = tlb_data.value();
+    if (static_tlb && static_tlb->contains(address, size_in_bytes)) {
+        const std::uint64_t tlb_offset = static_tlb->bar_offset;
+        const std::uint64_t tlb_size = static_tlb->size;
         if (dev->bar4_wc != nullptr && tlb_size == BH_4GB_TLB_SIZE) {
             // This is only for Blackhole. If we want to  write to DRAM (BAR4 space), we add offset
             // to which we write so write_block knows it needs to target BAR4
@@ -2257,11 +2408,12 @@ void tt_SiliconDevice::write_device_memory(const void *mem_ptr, uint32_t size_in
         }
     } else {
         const auto tlb_index = dynamic_tlb_config.at(fallback_tlb);
+        const auto& coord_translation = harvested_coord_translation.at(target.chip);
         const scoped_lock<named_mutex> lock(*get_mutex(fallback_tlb, pci_device -> id));
 
         while(size_in_bytes > 0) {
 
-            auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, target, address, harvested_coord_translation, dynamic_tlb_ordering_modes.at(fallback_tlb));
+            auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, target, address, coord_translation, dynamic_tlb_ordering_modes.at(fallback_tlb));
             uint32_t transfer_size = std::min((uint64_t)size_in_bytes, tlb_size);
             write_block(dev, mapped_address, transfer_size, buffer_addr, m_dma_buf_size);
 
@@ -2271,6 +2423,10 @@ void tt_SiliconDevice::write_device_memory(const void *mem_ptr, uint32_t size_in
         }
         // LOG1 ("Write done Dynamic TLB with pid=%ld\n", (long)getpid());
     }
+    if (dirty_cores) {
+        // A barrier may have taken the core while the write was being issued
+        dirty_cores->mark(target);
+    }
 }
 
 void tt_SiliconDevice::read_device_memory(void *mem_ptr, tt_cxy_pair target, std::uint32_t address, std::uint32_t size_in_bytes, const std::string& fallback_tlb) {
@@ -2281,16 +2437,12 @@ void tt_SiliconDevice::read_device_memory(void *mem_ptr, tt_cxy_pair target, std
 
     uint8_t* buffer_addr = static_cast<uint8_t*>(mem_ptr);
 
-    std::int32_t tlb_index = 0;
-    std::optional<std::tuple<std::uint64_t, std::uint64_t>> tlb_data = std::nullopt;
-    if(tlbs_init) {
-        tlb_index = map_core_to_tlb(tt_xy_pair(target.x, target.y));
-        tlb_data = dev->get_architecture_implementation()->describe_tlb(tlb_index);
-    }
-    LOG1("  tlb_index: %d, tlb_data.has_value(): %d\n", tlb_index, tlb_data.has_value());
+    const tt_static_tlb_entry* static_tlb = get_static_tlb_entry(target);
+    LOG1("  tlb_index: %d, static tlb mapped: %d\n", static_tlb ? static_tlb->tlb_index : -1, static_tlb != nullptr);
 
-    if (tlb_data.has_value()  && address_in_tlb_space(address, size_in_bytes, tlb_index, std::get<1>(tlb_data.value()), target.chip)) {
-        auto [tlb_offset, tlb_size] = tlb_data.value();
+    if (static_tlb && static_tlb->contains(address, size_in_bytes)) {
+        const std::uint64_t tlb_offset = static_tlb->bar_offset;
+        const std::uint64_t tlb_size = static_tlb->size;
         if (dev->bar4_wc != nullptr && tlb_size == BH_4GB_TLB_SIZE) {
             // This is only for Blackhole. If we want to  read from DRAM (BAR4 space), we add offset
             // from which we read so read_block knows it needs to target BAR4
@@ -2301,11 +2453,12 @@ void tt_SiliconDevice::read_device_memory(void *mem_ptr, tt_cxy_pair target, std
         LOG1 ("  read_block called with tlb_offset: %d, tlb_size: %d\n", tlb_offset, tlb_size);
     } else {
         const auto tlb_index = dynamic_tlb_config.at(fallback_tlb);
+        const auto& coord_translation = harvested_coord_translation.at(target.chip);
         const scoped_lock<named_mutex> lock(*get_mutex(fallback_tlb, pci_device -> id));
         LOG1 ("  dynamic tlb_index: %d\n", tlb_index);
         while(size_in_bytes > 0) {
 
-            auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, target, address, harvested_coord_translation, dynamic_tlb_ordering_modes.at(fallback_tlb));
+            auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, target, address, coord_translation, dynamic_tlb_ordering_modes.at(fallback_tlb));
             uint32_t transfer_size = std::min((uint64_t)size_in_bytes, tlb_size);
             read_block(dev, mapped_address, transfer_size, buffer_addr, m_dma_buf_size);
 
@@ -2317,6 +2470,16 @@ void tt_SiliconDevice::read_device_memory(void *mem_ptr, tt_cxy_pair target, std
     }
 }
 
+tt_sysmem_span tt_SiliconDevice::map_sysmem(chip_id_t mmio_chip, uint16_t channel, std::uint64_t offset, std::uint32_t size) const {
+    hugepage_loader.wait_for_channel(mmio_chip, channel);
+    if (!sysmem_map.is_mapped(mmio_chip, channel)) {
+        std::string err_msg = "map_sysmem: Hugepage or DMAbuffer are not allocated for src_device_id: " + std::to_string(mmio_chip) + " ch: " + std::to_string(channel);
+        err_msg += " - Ensure sufficient number of Hugepages installed per device (1 per host mem ch, per device)";
+        throw std::runtime_error(err_msg);
+    }
+    return sysmem_map.map(mmio_chip, channel, offset, size);
+}
+
 void tt_SiliconDevice::read_dma_buffer(
     void* mem_ptr,
     std::uint32_t address,
@@ -2325,22 +2488,15 @@ void tt_SiliconDevice::read_dma_buffer(
     chip_id_t src_device_id) {
 
     log_assert(src_device_id != -1, "Must provide src_device_id for host_resident read/write");
-    log_assert(channel >= 0 && channel <= g_MAX_HOST_MEM_CHANNELS, "{} - Invalid channel {} for host_resident read/write.", __FUNCTION__, channel);
-    void * user_scratchspace = nullptr;
+    log_assert(channel < g_MAX_HOST_MEM_CHANNELS, "{} - Invalid channel {} for host_resident read/write.", __FUNCTION__, channel);
+    hugepage_loader.wait_for_channel(src_device_id, channel);
+    // Addresses wrap around the channel (hugepage or DMA buffer), callers may pass them with device side bits set
+    const std::uint64_t offset = address & (sysmem_map.get_channel_size(src_device_id, channel) - 1);
+    const tt_sysmem_span view = map_sysmem(src_device_id, channel, offset, size_in_bytes);
 
-    if(hugepage_mapping.at(src_device_id).at(channel)) {
-      user_scratchspace = static_cast<char*>(hugepage_mapping.at(src_device_id).at(channel)) + (address & HUGEPAGE_MAP_MASK);
-    } else if (buf_mapping) {
-      user_scratchspace = static_cast<char*>(buf_mapping) + (address & DMA_MAP_MASK);
-    } else {
-      std::string err_msg = "write_dma_buffer: Hugepage or DMAbuffer are not allocated for src_device_id: " + std::to_string(src_device_id) + " ch: " + std::to_string(channel);
-      err_msg += " - Ensure sufficient number of Hugepages installed per device (1 per host mem ch, per device)";
-      throw std::runtime_error(err_msg);
-    }
+    LOG1("---- tt_SiliconDevice::read_dma_buffer (src_device_id: %d, ch: %d) from 0x%lx\n",  src_device_id, channel, view.data);
 
-    LOG1("---- tt_SiliconDevice::read_dma_buffer (src_device_id: %d, ch: %d) from 0x%lx\n",  src_device_id, channel, user_scratchspace);
-    
-    memcpy(mem_ptr, user_scratchspace, size_in_bytes);
+    memcpy(mem_ptr, view.data, view.size);
 }
 
 void tt_SiliconDevice::write_dma_buffer(
@@ -2350,29 +2506,15 @@ void tt_SiliconDevice::write_dma_buffer(
     std::uint16_t channel,
     chip_id_t src_device_id) {
 
-    void * user_scratchspace = nullptr;
-    if(hugepage_mapping.at(src_device_id).at(channel)) {
-      log_assert(size <= HUGEPAGE_REGION_SIZE, "write_dma_buffer data has larger size {} than destination buffer {}", size, HUGEPAGE_REGION_SIZE);
-      log_debug(LogSiliconDriver, "Using hugepage mapping at address {} offset {} chan {} size {}",
-        hugepage_mapping.at(src_device_id).at(channel),
-        (address & HUGEPAGE_MAP_MASK),
-        channel,
-        size);
-      user_scratchspace = static_cast<char*>(hugepage_mapping.at(src_device_id).at(channel)) + (address & HUGEPAGE_MAP_MASK);
-    }
-    else if(buf_mapping) {
-      log_assert(size <= DMA_BUF_REGION_SIZE, "write_dma_buffer data has larger size {} than destination buffer {}", size, DMA_BUF_REGION_SIZE);
-      log_debug(LogSiliconDriver, "Using DMA Buffer at address {} offset {} size {}",
-        buf_mapping,
-        address,
-        size);
-        // we failed when initializing huge pages, we are using a 1MB DMA buffer as a stand-in
-        user_scratchspace = reinterpret_cast<char*>(buf_mapping);
-    } else {
-      std::string err_msg = "write_dma_buffer: Hugepage or DMAbuffer are not allocated for src_device_id: " + std::to_string(src_device_id) + " ch: " + std::to_string(channel);
-      throw std::runtime_error(err_msg);
-    }
-    memcpy(user_scratchspace, mem_ptr, size);
+    log_assert(src_device_id != -1, "Must provide src_device_id for host_resident read/write");
+    log_assert(channel < g_MAX_HOST_MEM_CHANNELS, "{} - Invalid channel {} for host_resident read/write.", __FUNCTION__, channel);
+    hugepage_loader.wait_for_channel(src_device_id, channel);
+    const std::uint64_t offset = address & (sysmem_map.get_channel_size(src_device_id, channel) - 1);
+    const tt_sysmem_span view = map_sysmem(src_device_id, channel, offset, size);
+    log_debug(LogSiliconDriver, "Using host memory channel mapping at address {} offset {} chan {} size {}", static_cast<void*>(view.data), offset, channel, size);
+
+    // Large writes are read by the device rather than the host, so they shouldn't take up space in the CPU caches.
+    tt_sysmem_write(view.data, mem_ptr, view.size, sysmem_streaming_threshold);
 }
 
 
@@ -2397,15 +2539,18 @@ uint32_t tt_SiliconDevice::get_power_state_arc_msg(struct PCIdevice* pci_device,
 }
 
 void tt_SiliconDevice::set_pcie_power_state(tt_DevicePowerState state) {
-
+    // Messages to all devices are posted before waiting on any, so devices change power state concurrently.
+    std::vector<tt_arc_msg_token> tokens = {};
     for (auto &device_it : m_pci_device_map){
-        int d = device_it.first;
-        struct PCIdevice* pci_device = device_it.second;
-        uint32_t msg = get_power_state_arc_msg(pci_device, state);
-        std::stringstream ss;
-        ss << state;
-        auto exit_code = arc_msg(d, 0xaa00 | msg, true, 0, 0);
+        tokens.push_back(post_arc_msg(device_it.first, 0xaa00 | get_power_state_arc_msg(device_it.second, state), 0, 0));
+    }
+    for (auto& token : tokens) {
+        auto exit_code = wait_arc_msg(token);
+        // Clocks change with the power state.
+        telemetry_cache.invalidate(token.chip);
         if (exit_code != 0) {
+            std::stringstream ss;
+            ss << state;
             throw std::runtime_error(
                 "Failed to set power state to " + ss.str() + " with exit code " + std::to_string(exit_code));
         }
@@ -2425,21 +2570,33 @@ int tt_SiliconDevice::get_clock(int logical_device_id) {
         }
     }
 
-    uint32_t clock;
     auto mmio_capable_chip_logical = ndesc->get_closest_mmio_capable_chip(logical_device_id);
     struct PCIdevice* pci_device = get_pci_device(mmio_capable_chip_logical);
-    auto exit_code = arc_msg(logical_device_id, 0xaa00 | pci_device->hdev->get_architecture_implementation()->get_arc_message_get_aiclk(), true, 0xFFFF, 0xFFFF, 1, &clock);
-    if (exit_code != 0) {
-        throw std::runtime_error("Failed to get aiclk value with exit code " + std::to_string(exit_code));
-    }
-    return clock;
+    const uint32_t msg_code = 0xaa00 | pci_device->hdev->get_architecture_implementation()->get_arc_message_get_aiclk();
+    return telemetry_cache.get(logical_device_id, msg_code, [&] () {
+        uint32_t clock;
+        auto exit_code = arc_msg(logical_device_id, msg_code, true, 0xFFFF, 0xFFFF, 1, &clock);
+        if (exit_code != 0) {
+            throw std::runtime_error("Failed to get aiclk value with exit code " + std::to_string(exit_code));
+        }
+        return clock;
+    });
 }
 
 std::map<int, int> tt_SiliconDevice::get_clocks() {
-    std::map<int,int> clock_freq_map;
+    std::vector<chip_id_t> mmio_chips = {};
     for (auto &device_it : m_pci_device_map){
-        int d = device_it.first;
-        clock_freq_map.insert({d, get_clock(d)});
+        mmio_chips.push_back(device_it.first);
+    }
+    // Clocks are read concurrently, each worker writes the slot of its own device.
+    std::vector<int> clocks = std::vector<int>(mmio_chips.size(), 0);
+    mmio_fan_out.run_per_device(mmio_chips, [&] (chip_id_t d) {
+        const auto idx = std::find(mmio_chips.begin(), mmio_chips.end(), d) - mmio_chips.begin();
+        clocks.at(idx) = get_clock(d);
+    });
+    std::map<int,int> clock_freq_map;
+    for (std::size_t i = 0; i < mmio_chips.size(); i++) {
+        clock_freq_map.insert({mmio_chips.at(i), clocks.at(i)});
     }
     return clock_freq_map;
 }
@@ -2487,6 +2644,8 @@ std::map<int, int> tt_SiliconDevice::get_clocks() {
 tt_SiliconDevice::~tt_SiliconDevice () {
 
     LOG1 ("---- tt_SiliconDevice::~tt_SiliconDevice\n");
+    // Queued I/O may still use the devices, so it runs before anything is torn down.
+    stop_io_workers();
 
     for(int i = 0; i < archs_in_cluster.size(); i++) {
         if(archs_in_cluster[i] == tt::ARCH::WORMHOLE) {
@@ -2494,6 +2653,7 @@ tt_SiliconDevice::~tt_SiliconDevice () {
         }
     }
     cleanup_shared_host_state();
+    hugepage_loader.stop();
 
     for (auto &device_it : m_pci_device_map){
 
@@ -2516,18 +2676,24 @@ tt_SiliconDevice::~tt_SiliconDevice () {
     soc_descriptor_per_chip.clear();
     dynamic_tlb_config.clear();
     tlb_config_map.clear();
+    static_tlb_tables.clear();
     dynamic_tlb_ordering_modes.clear();
 }
 
 std::optional<std::tuple<uint32_t, uint32_t>> tt_SiliconDevice::get_tlb_data_from_target(const tt_xy_pair& target) {
-    std::int32_t tlb_index = 0;
     std::optional<std::tuple<std::uint32_t, std::uint32_t>> tlb_data;
 
     if (tlbs_init) {
-        tlb_index = map_core_to_tlb(target);
-        auto architecture_implementation = tt::umd::architecture_implementation::create(static_cast<tt::umd::architecture>(arch_name));
-        tlb_data = architecture_implementation->describe_tlb(tlb_index);
-    } 
+        // The core to TLB mapping is identical across MMIO chips. Use the table of any chip that has one.
+        for(const auto& table : static_tlb_tables) {
+            if(table.entries.empty()) continue;
+            const tt_static_tlb_entry* static_tlb = table.get(target);
+            if(static_tlb) {
+                tlb_data = std::make_tuple(static_tlb->bar_offset, static_tlb->size);
+            }
+            break;
+        }
+    }
     return tlb_data;
 }
 
@@ -2538,10 +2704,14 @@ uint32_t tt_SiliconDevice::get_m_dma_buf_size() const {
 void tt_SiliconDevice::configure_tlb(chip_id_t logical_device_id, tt_xy_pair core, std::int32_t tlb_index, std::int32_t address, uint64_t ordering) {
     log_assert(ordering == TLB_DATA::Strict || ordering == TLB_DATA::Posted || ordering == TLB_DATA::Relaxed, "Invalid ordering specified in tt_SiliconDevice::configure_tlb");
     struct PCIdevice* pci_device = get_pci_device(logical_device_id);
-    set_dynamic_tlb(pci_device, tlb_index, core, address, harvested_coord_translation, ordering);
-    auto tlb_size = std::get<1>(pci_device->hdev->get_architecture_implementation()->describe_tlb(tlb_index).value());
-    if(tlb_config_map.find(logical_device_id) == tlb_config_map.end()) tlb_config_map.insert({logical_device_id, {}});
-    tlb_config_map[logical_device_id].insert({tlb_index, (address / tlb_size) * tlb_size});
+    set_dynamic_tlb(pci_device, tlb_index, core, address, harvested_coord_translation.at(logical_device_id), ordering);
+    auto tlb_size = std::get<1>(pci_device->hdev->get_tlb_operations().describe_tlb(tlb_index).value());
+    std::uint64_t mapped_base = (address / tlb_size) * tlb_size;
+    // Reconfiguring a TLB moves its window, so the latest configuration always wins.
+    tlb_config_map[logical_device_id][tlb_index] = mapped_base;
+    if(static_cast<std::size_t>(logical_device_id) < static_tlb_tables.size()) {
+        static_tlb_tables[logical_device_id].configure(tlb_index, mapped_base);
+    }
 }
 
 void tt_SiliconDevice::set_fallback_tlb_ordering_mode(const std::string& fallback_tlb, uint64_t ordering) {
@@ -2615,6 +2785,7 @@ void tt_SiliconDevice::init_pcie_iatus() {
     for (auto &src_device_it : m_pci_device_map){
         int src_pci_id = src_device_it.first;
         struct PCIdevice* src_pci_device = src_device_it.second;
+        hugepage_loader.wait_for_device(src_pci_id);
 
         uint32_t current_peer_region = 0;
         const int num_peer_ids = 3; // 0=HOST, 1=UPSTREAM Device, 2=DOWNSTREAM Device, 3=Unused
@@ -2667,6 +2838,7 @@ void tt_SiliconDevice::init_pcie_iatus_no_p2p() {
     for (auto &src_device_it : m_pci_device_map){
         int src_pci_id = src_device_it.first;
         struct PCIdevice* src_pci_device = src_device_it.second;
+        hugepage_loader.wait_for_device(src_pci_id);
 
         // Device to Host (multiple channels)
         for (int channel_id = 0; channel_id < m_num_host_mem_channels; channel_id++) {
@@ -2694,6 +2866,7 @@ uint32_t tt_SiliconDevice::dma_allocation_size(chip_id_t src_device_id)
 
   // Fall back to first device if no src_device_id is provided. Assumes all devices have the same size, which is true.
   chip_id_t device_index = src_device_id == -1 ? m_pci_device_map.begin()->first : src_device_id;
+  hugepage_loader.wait_for_channel(device_index, 0);
 
   if (hugepage_mapping.at(device_index).at(0)) {
     return HUGEPAGE_REGION_SIZE;
@@ -2708,11 +2881,11 @@ uint32_t tt_SiliconDevice::dma_allocation_size(chip_id_t src_device_id)
 
 
 
-// Looks for hugetlbfs inside /proc/mounts matching desired pagesize (typically 1G)
-std::string find_hugepage_dir(std::size_t pagesize)
+// Looks for hugetlbfs mounted at dir inside /proc/mounts matching desired pagesize (typically 1G)
+std::string find_hugepage_dir(std::size_t pagesize, const std::string& dir = hugepage_dir)
 {
 
-    static const std::regex hugetlbfs_mount_re("^(nodev|hugetlbfs) (" + hugepage_dir + ") hugetlbfs ([^ ]+) 0 0$");
+    const std::regex hugetlbfs_mount_re("^(nodev|hugetlbfs) (" + dir + ") hugetlbfs ([^ ]+) 0 0$");
     static const std::regex pagesize_re("(?:^|,)pagesize=([0-9]+)([KMGT])(?:,|$)");
 
     std::ifstream proc_mounts("/proc/mounts");
@@ -2741,7 +2914,7 @@ std::string find_hugepage_dir(std::size_t pagesize)
         }
     }
 
-    WARN("---- ttSiliconDevice::find_hugepage_dir: no huge page mount found in /proc/mounts for path: %s with hugepage_size: %d.\n", hugepage_dir.c_str(), pagesize);
+    WARN("---- ttSiliconDevice::find_hugepage_dir: no huge page mount found in /proc/mounts for path: %s with hugepage_size: %d.\n", dir.c_str(), pagesize);
     return std::string();
 }
 
@@ -2852,82 +3025,130 @@ void print_file_contents(std::string filename, std::string hint = ""){
     }
 }
 
-// Initialize hugepage, N per device (all same size).
-bool tt_SiliconDevice::init_hugepage(chip_id_t device_id) {
+// Initialize the hugepage of one host memory channel (all channels are the same size).
+// Each channel is backed by a 1GB hugepage if possible, and falls back to 2MB hugepages, which must be pinned as a
+// single IOVA contiguous range (only possible behind an IOMMU) since each channel gets one iATU region.
+bool tt_SiliconDevice::init_hugepage(chip_id_t device_id, uint16_t ch) {
     const std::size_t hugepage_size = (std::size_t)1 << 30;
+    const std::size_t small_hugepage_size = (std::size_t)2 << 20;
     const std::size_t mapping_size = (std::size_t) HUGEPAGE_REGION_SIZE;
 
     // Convert from logical (device_id in netlist) to physical device_id (in case of virtualization)
     auto physical_device_id = m_pci_device_map.at(device_id)->id;
 
-    std::string hugepage_dir = find_hugepage_dir(hugepage_size);
-    if (hugepage_dir.empty()) {
-        WARN("---- ttSiliconDevice::init_hugepage: no huge page mount found for hugepage_size: %d.\n", hugepage_size);
-        return false;
-    }
-
-    bool success = true;
-
-    // Support for more than 1GB host memory accessible per device, via channels.
-    for (int ch = 0; ch < m_num_host_mem_channels; ch++) {
-
-        int hugepage_fd = open_hugepage_file(hugepage_dir, physical_device_id, ch);
+    tt_hugepage_ops ops = {};
+    ops.find_dir = [&] (std::size_t page_size) {
+        return find_hugepage_dir(page_size, page_size == hugepage_size ? hugepage_dir : hugepage_2m_dir);
+    };
+    ops.map = [&] (const std::string& dir, std::uint16_t ch, std::uint64_t size) -> void* {
+        int hugepage_fd = open_hugepage_file(dir, physical_device_id, ch);
         if (hugepage_fd == -1) {
             // Probably a permissions problem.
             WARN("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d creating hugepage mapping file failed.\n", physical_device_id, ch);
-            success = false;
-            continue;
+            return nullptr;
         }
 
-        std::byte *mapping = static_cast<std::byte*>(mmap(nullptr, mapping_size, PROT_READ|PROT_WRITE, MAP_SHARED | MAP_POPULATE, hugepage_fd, 0));
+        std::byte *mapping = static_cast<std::byte*>(mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_SHARED | MAP_POPULATE, hugepage_fd, 0));
 
         close(hugepage_fd);
 
         if (mapping == MAP_FAILED) {
             uint32_t num_tt_mmio_devices_for_arch = tt::cpuset::tt_cpuset_allocator::get_num_tt_pci_devices_by_pci_device_id(m_pci_device_map.at(device_id)->device_id, m_pci_device_map.at(device_id)->revision_id);
-            WARN("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d mapping hugepage failed. (errno: %s).\n", physical_device_id, ch, strerror(errno));
+            WARN("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d mapping hugepage from %s failed. (errno: %s).\n", physical_device_id, ch, dir.c_str(), strerror(errno));
             WARN("---- Possible hint: /proc/cmdline should have hugepages=N, nr_hugepages=N - (N = NUM_MMIO_TT_DEVICES * (is_grayskull ? 1 : 4). NUM_MMIO_DEVICES = %d\n", num_tt_mmio_devices_for_arch);
             print_file_contents("/proc/cmdline");\
             print_file_contents("/sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages"); // Hardcoded for 1GB hugepage.
-            success = false;
-            continue;
+            return nullptr;
         }
 
         // Beter performance if hugepage just allocated (populate flag to prevent lazy alloc) is migrated to same numanode as TT device.
-        if (!tt::cpuset::tt_cpuset_allocator::bind_area_to_memory_nodeset(physical_device_id, mapping, mapping_size)){
+        if (!tt::cpuset::tt_cpuset_allocator::bind_area_to_memory_nodeset(physical_device_id, mapping, size)){
             WARN("---- ttSiliconDevice::init_hugepage: bind_area_to_memory_nodeset() failed (physical_device_id: %d ch: %d). "
             "Hugepage allocation is not on NumaNode matching TT Device. Side-Effect is decreased Device->Host perf (Issue #893).\n",
             physical_device_id, ch);
         }
-
+        return mapping;
+    };
+    ops.unmap = [] (void* mapping, std::uint64_t size) {
+        munmap(mapping, size);
+    };
+    ops.pin = [&] (std::uint16_t ch, void* address, std::uint64_t size, std::uint64_t& iova) {
         tenstorrent_pin_pages pin_pages;
         memset(&pin_pages, 0, sizeof(pin_pages));
         pin_pages.in.output_size_bytes = sizeof(pin_pages.out);
         pin_pages.in.flags = TENSTORRENT_PIN_PAGES_CONTIGUOUS;
-        pin_pages.in.virtual_address = reinterpret_cast<std::uintptr_t>(mapping);
-        pin_pages.in.size = mapping_size;
+        pin_pages.in.virtual_address = reinterpret_cast<std::uintptr_t>(address);
+        pin_pages.in.size = size;
 
         auto &fd = g_SINGLE_PIN_PAGE_PER_FD_WORKAROND ? m_pci_device_map.at(device_id)->hdev->device_fd_per_host_ch[ch] : m_pci_device_map.at(device_id)->hdev->device_fd;
 
         if (ioctl(fd, TENSTORRENT_IOCTL_PIN_PAGES, &pin_pages) == -1) {
             WARN("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d TENSTORRENT_IOCTL_PIN_PAGES failed (errno: %s). Common Issue: Requires TTMKD >= 1.11, see following file contents...\n", physical_device_id, ch, strerror(errno));
-            munmap(mapping, mapping_size);
             print_file_contents("/sys/module/tenstorrent/version", "(TTKMD version)");
             print_file_contents("/proc/meminfo");
             print_file_contents("/proc/buddyinfo");
-            success = false;
-            continue;
+            return false;
+        }
+        iova = pin_pages.out.physical_address;
+        return true;
+    };
+
+    tt_hugepage_channel channel = tt_map_hugepage_channel(ops, ch, mapping_size, hugepage_size);
+    if (!channel.is_valid()) {
+        WARN("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d could not be backed by 1GB hugepages, trying 2MB hugepages in %s.\n", physical_device_id, ch, hugepage_2m_dir.c_str());
+        channel = tt_map_hugepage_channel(ops, ch, mapping_size, small_hugepage_size);
+        if (!channel.is_valid()) {
+            WARN("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d could not be backed by 2MB hugepages either. They only work behind an IOMMU, which is needed to pin them as one contiguous range.\n", physical_device_id, ch);
         }
+    }
+    if (!channel.is_valid()) {
+        return false;
+    }
 
-        hugepage_mapping.at(device_id).at(ch) = mapping;
-        hugepage_mapping_size.at(device_id).at(ch) = mapping_size;
-        hugepage_physical_address.at(device_id).at(ch) = pin_pages.out.physical_address;
+    hugepage_mapping.at(device_id).at(ch) = channel.mapping;
+    hugepage_mapping_size.at(device_id).at(ch) = channel.size;
+    hugepage_physical_address.at(device_id).at(ch) = channel.iova;
+    hugepage_channels.at(device_id).at(ch) = std::move(channel);
 
-        LOG1("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d mapping_size: %d physical address 0x%llx\n", physical_device_id, ch, mapping_size, (unsigned long long)hugepage_physical_address.at(device_id).at(ch));
+    LOG1("---- ttSiliconDevice::init_hugepage: physical_device_id: %d ch: %d mapping_size: %d page_size: %d physical address 0x%llx\n", physical_device_id, ch, mapping_size, hugepage_channels.at(device_id).at(ch).page_size, (unsigned long long)hugepage_physical_address.at(device_id).at(ch));
+    return true;
+}
 
+// Loads a host memory channel for hugepage_loader: maps its hugepage, falling back to the DMA buffer, and makes it
+// visible to map_sysmem. Runs on whichever thread touches the channel first, concurrently with other channels.
+void tt_SiliconDevice::init_host_channel(chip_id_t device_id, uint16_t channel) {
+    if (channel != 0) {
+        // Channel 0 decides whether the DMA buffer stands in for channels that can't be backed by hugepages
+        hugepage_loader.wait_for_channel(device_id, 0);
+    }
+    const bool hugepage_initialized = init_hugepage(device_id, channel);
+    // Large writes to remote chips require hugepages to be initialized.
+    // Conservative assert - end workload if remote chips present but hugepages not initialized (failures caused if using remote only for small transactions)
+    if (target_remote_chips.size()) {
+        log_assert(hugepage_initialized, "Hugepages must be successfully initialized if workload contains remote chips!");
     }
 
-    return success;
+    const std::lock_guard<std::mutex> lock(host_channel_mutex);
+    if (channel == 0 && !hugepage_initialized) {
+        init_dmabuf(device_id);
+        // The DMA buffer also stands in for channels past the ones backed by hugepages
+        for (uint16_t unused_channel = m_num_host_mem_channels; unused_channel < g_MAX_HOST_MEM_CHANNELS; unused_channel++) {
+            sysmem_map.add_channel(device_id, unused_channel, buf_mapping, DMA_BUF_REGION_SIZE);
+        }
+    }
+    if (hugepage_initialized) {
+        sysmem_map.add_channel(device_id, channel, hugepage_mapping.at(device_id).at(channel), HUGEPAGE_REGION_SIZE);
+    } else if (buf_mapping) {
+        // We failed when initializing huge pages, the DMA buffer is a stand-in for every channel
+        sysmem_map.add_channel(device_id, channel, buf_mapping, DMA_BUF_REGION_SIZE);
+    }
+}
+
+const tt_hugepage_channel& tt_SiliconDevice::get_hugepage_channel(chip_id_t mmio_chip, uint16_t channel) const {
+    hugepage_loader.wait_for_channel(mmio_chip, channel);
+    log_assert(hugepage_channels.count(mmio_chip) && hugepage_channels.at(mmio_chip).count(channel) && hugepage_channels.at(mmio_chip).at(channel).is_valid(),
+        "Host memory channel {} of device {} is not backed by hugepages", channel, mmio_chip);
+    return hugepage_channels.at(mmio_chip).at(channel);
 }
 
 int tt_SiliconDevice::test_setup_interface () {
@@ -2935,7 +3156,7 @@ int tt_SiliconDevice::test_setup_interface () {
         int ret_val = 0;
         TTDevice *dev = m_pci_device_map.begin()->second->hdev;
 
-        uint32_t mapped_reg = set_dynamic_tlb(m_pci_device_map.begin()->second, dev->get_architecture_implementation()->get_reg_tlb(), tt_xy_pair(0, 0), 0xffb20108, harvested_coord_translation).bar_offset;
+        uint32_t mapped_reg = set_dynamic_tlb(m_pci_device_map.begin()->second, dev->get_architecture_implementation()->get_reg_tlb(), tt_xy_pair(0, 0), 0xffb20108, harvested_coord_translation.at(m_pci_device_map.begin()->second->logical_id)).bar_offset;
 
         uint32_t regval = 0;
         read_regs(dev, mapped_reg, 1, &regval);
@@ -2946,7 +3167,7 @@ int tt_SiliconDevice::test_setup_interface () {
         int ret_val = 0;
         TTDevice *dev = m_pci_device_map.begin()->second->hdev;
 
-        uint32_t mapped_reg = set_dynamic_tlb(m_pci_device_map.begin()->second, dev->get_architecture_implementation()->get_reg_tlb(), tt_xy_pair(1, 0), 0xffb20108, harvested_coord_translation).bar_offset;
+        uint32_t mapped_reg = set_dynamic_tlb(m_pci_device_map.begin()->second, dev->get_architecture_implementation()->get_reg_tlb(), tt_xy_pair(1, 0), 0xffb20108, harvested_coord_translation.at(m_pci_device_map.begin()->second->logical_id)).bar_offset;
 
         uint32_t regval = 0;
         read_regs(dev, mapped_reg, 1, &regval);
@@ -3049,67 +3270,125 @@ uint32_t tt_SiliconDevice::bar_read32 (int logical_device_id, uint32_t addr) {
     return data;
 }
 
-// Returns 0 if everything was OK
-int tt_SiliconDevice::pcie_arc_msg(int logical_device_id, uint32_t msg_code, bool wait_for_done, uint32_t arg0, uint32_t arg1, int timeout, uint32_t *return_3, uint32_t *return_4) {
+class tt_SiliconDevice::pcie_arc_msg_io : public tt_arc_msg_io {
+    public:
+    pcie_arc_msg_io(tt_SiliconDevice* device, int logical_device_id, tt_arc_msg_in_flight_marker* marker) :
+        device(device), logical_device_id(logical_device_id), marker(marker) {}
 
+    std::uint32_t read_reg(std::uint64_t address) override { return device->bar_read32(logical_device_id, address); }
+    void write_reg(std::uint64_t address, std::uint32_t value) override { device->bar_write32(logical_device_id, address, value); }
+    tt_arc_msg_in_flight_marker* get_in_flight_marker() override { return marker; }
 
-    if ((msg_code & 0xff00) != 0xaa00) {
-        ERROR ("Malformed message. msg_code is 0x%x but should be 0xaa..\n", msg_code);
+    private:
+    tt_SiliconDevice* device;
+    int logical_device_id;
+    tt_arc_msg_in_flight_marker* marker;
+};
+
+class tt_SiliconDevice::remote_arc_msg_io : public tt_arc_msg_io {
+    public:
+    remote_arc_msg_io(tt_SiliconDevice* device, const tt_cxy_pair& core) : device(device), core(core) {}
+
+    std::uint32_t read_reg(std::uint64_t address) override {
+        std::uint32_t value = 0;
+        device->read_from_non_mmio_device(&value, core, address, sizeof(value));
+        return value;
     }
-    log_assert(arg0 <= 0xffff and arg1 <= 0xffff, "Only 16 bits allowed in arc_msg args"); // Only 16 bits are allowed
+    void write_reg(std::uint64_t address, std::uint32_t value) override {
+        device->write_to_non_mmio_device(&value, sizeof(value), core, address);
+    }
+    // The message has to land before misc_cntl is read back.
+    void flush_writes() override { device->wait_for_non_mmio_flush(); }
 
-    struct PCIdevice* pci_device = get_pci_device(logical_device_id);
+    private:
+    tt_SiliconDevice* device;
+    tt_cxy_pair core;
+};
+
+tt_arc_mailbox& tt_SiliconDevice::get_arc_mailbox(chip_id_t chip) {
+    const std::lock_guard<std::mutex> lock(arc_mailboxes_mutex);
+    auto mailbox = arc_mailboxes.find(chip);
+    if (mailbox == arc_mailboxes.end()) {
+        mailbox = arc_mailboxes.insert({chip, std::make_unique<tt_arc_mailbox>()}).first;
+    }
+    return *mailbox->second;
+}
+
+void tt_SiliconDevice::access_arc_mailbox(chip_id_t chip, const std::function<void(tt_arc_mailbox&, tt_arc_msg_io&, const tt_arc_msg_regs&)>& access) {
+    tt_arc_mailbox& mailbox = get_arc_mailbox(chip);
+    if (!ndesc->is_chip_mmio_capable(chip)) {
+        constexpr uint64_t ARC_RESET_SCRATCH_ADDR = 0x880030060;
+        constexpr uint64_t ARC_RESET_MISC_CNTL_ADDR = 0x880030100;
+        remote_arc_msg_io io = remote_arc_msg_io(this, tt_cxy_pair(chip, get_soc_descriptor(chip).arc_cores.at(0)));
+        access(mailbox, io, {ARC_RESET_SCRATCH_ADDR, ARC_RESET_MISC_CNTL_ADDR});
+        return;
+    }
+
+    struct PCIdevice* pci_device = get_pci_device(chip);
     auto architecture_implementation = pci_device->hdev->get_architecture_implementation();
+    const tt_arc_msg_regs regs = {architecture_implementation->get_arc_reset_scratch_offset(), architecture_implementation->get_arc_reset_arc_misc_cntl_offset()};
 
     // Exclusive access for a single process at a time. Based on physical pci interface id.
+    // Only held while the mailbox is accessed, not while ARC handles the message: the in-flight marker keeps other
+    // processes from posting until the reply was read.
     std::string msg_type = "ARC_MSG";
     const scoped_lock<named_mutex> lock(*get_mutex(msg_type, pci_device->id));
-    uint32_t fw_arg = arg0 | (arg1<<16);
-    int exit_code = 0;
-
-    bar_write32 (logical_device_id, architecture_implementation->get_arc_reset_scratch_offset() + 3 * 4, fw_arg);
-    bar_write32 (logical_device_id, architecture_implementation->get_arc_reset_scratch_offset() + 5 * 4, msg_code);
+    auto marker = arc_msg_in_flight_markers.find(ARC_MSG_IN_FLIGHT_NAME + std::to_string(pci_device->id));
+    pcie_arc_msg_io io = pcie_arc_msg_io(this, chip, marker == arc_msg_in_flight_markers.end() ? nullptr : static_cast<tt_arc_msg_in_flight_marker*>(marker->second->get_address()));
+    access(mailbox, io, regs);
+    detect_ffffffff_read(pci_device->hdev);
+}
 
-    uint32_t misc = bar_read32 (logical_device_id, architecture_implementation->get_arc_reset_arc_misc_cntl_offset());
-    if (misc & (1 << 16)) {
-        log_error("trigger_fw_int failed on device {}", logical_device_id);
-        return 1;
-    } else {
-        bar_write32(logical_device_id, architecture_implementation->get_arc_reset_arc_misc_cntl_offset(), misc | (1 << 16));
+tt_arc_msg_token tt_SiliconDevice::post_arc_msg(int logical_device_id, uint32_t msg_code, uint32_t arg0, uint32_t arg1, int timeout) {
+    log_assert(arch_name != tt::ARCH::BLACKHOLE, "ARC messages not supported in Blackhole");
+    tt_arc_msg_token token = {};
+    // The ARC mutex is released between tries, so the process with a message in flight can read its reply.
+    tt_arc_msg_backoff backoff = {};
+    bool posted = false;
+    while (true) {
+        access_arc_mailbox(logical_device_id, [&] (tt_arc_mailbox& mailbox, tt_arc_msg_io& io, const tt_arc_msg_regs& regs) {
+            posted = mailbox.try_post(io, regs, logical_device_id, msg_code, arg0, arg1, timeout, token);
+        });
+        if (posted) {
+            return token;
+        }
+        backoff.wait();
     }
+}
 
-    if (wait_for_done) {
-        uint32_t status = 0xbadbad;
-        auto timeout_seconds = std::chrono::seconds(timeout);
-        auto start = std::chrono::system_clock::now();
-        while (true) {
-            if (std::chrono::system_clock::now() - start > timeout_seconds) {
-                throw std::runtime_error("Timed out after waiting " + std::to_string(timeout) + " seconds for device " + std::to_string(logical_device_id) + " ARC to respond");
-            }
-
-            status = bar_read32(logical_device_id, architecture_implementation->get_arc_reset_scratch_offset() + 5 * 4);
-
-            if ((status & 0xffff) == (msg_code & 0xff)) {
-                if (return_3 != nullptr) {
-                    *return_3 = bar_read32(logical_device_id, architecture_implementation->get_arc_reset_scratch_offset() + 3 * 4);
-                }
-
-                if (return_4 != nullptr) {
-                    *return_4 = bar_read32(logical_device_id, architecture_implementation->get_arc_reset_scratch_offset() + 4 * 4);
-                }
+bool tt_SiliconDevice::test_arc_msg(tt_arc_msg_token& token) {
+    if (token.is_complete()) {
+        return true;
+    }
+    bool complete = false;
+    access_arc_mailbox(token.chip, [&] (tt_arc_mailbox& mailbox, tt_arc_msg_io& io, const tt_arc_msg_regs& regs) {
+        complete = mailbox.test(io, regs, token);
+    });
+    return complete;
+}
 
-                exit_code = (status & 0xffff0000) >> 16;
-                break;
-            } else if (status == MSG_ERROR_REPLY) {
-                log_warning(LogSiliconDriver, "On device {}, message code 0x{:x} not recognized by FW", logical_device_id, msg_code);
-                exit_code = MSG_ERROR_REPLY;
-                break;
-            }
-        }
+int tt_SiliconDevice::wait_arc_msg(tt_arc_msg_token& token) {
+    tt_arc_msg_backoff backoff = {};
+    while (!test_arc_msg(token)) {
+        backoff.wait();
     }
+    return token.exit_code;
+}
 
-    detect_ffffffff_read(pci_device->hdev);
-    return exit_code;
+// Returns 0 if everything was OK
+int tt_SiliconDevice::send_arc_msg(int logical_device_id, uint32_t msg_code, bool wait_for_done, uint32_t arg0, uint32_t arg1, int timeout, uint32_t *return_3, uint32_t *return_4) {
+    tt_arc_msg_token token = post_arc_msg(logical_device_id, msg_code, arg0, arg1, timeout);
+    if (!wait_for_done) {
+        return token.exit_code;
+    }
+    wait_arc_msg(token);
+    if (return_3 != nullptr) {
+        *return_3 = token.return_3;
+    }
+    if (return_4 != nullptr) {
+        *return_4 = token.return_4;
+    }
+    return token.exit_code;
 }
 
 int tt_SiliconDevice::iatu_configure_peer_region (int logical_device_id, uint32_t peer_region_id, uint64_t bar_addr_64, uint32_t region_size) {
@@ -3234,11 +3513,11 @@ void *tt_SiliconDevice::channel_address(std::uint32_t offset, const tt_cxy_pair&
     if (arch_name == tt::ARCH::BLACKHOLE) {
         // We use BAR4 segment for mapping for Blackhole.
         log_assert(tlbs_init, "TLBs were not initialized.");
-        std::int32_t tlb_index = map_core_to_tlb(tt_xy_pair(target.x, target.y));
-        auto [tlb_offset, tlb_size] = pci_device->hdev->get_architecture_implementation()->describe_tlb(tlb_index).value();
+        const tt_static_tlb_entry* static_tlb = get_static_tlb_entry(target);
+        log_assert(static_tlb != nullptr, "No static TLB mapped to core {}", target.str());
 
-        log_assert(pci_device->hdev->bar4_wc != nullptr && tlb_size == BH_4GB_TLB_SIZE, "BAR4 not initialized, or TLBs not initialized properly.");
-        return static_cast<std::byte*>(pci_device->hdev->bar4_wc) + tlb_offset + offset;
+        log_assert(pci_device->hdev->bar4_wc != nullptr && static_tlb->size == BH_4GB_TLB_SIZE, "BAR4 not initialized, or TLBs not initialized properly.");
+        return static_cast<std::byte*>(pci_device->hdev->bar4_wc) + static_tlb->bar_offset + offset;
     } else {
         // This hard-codes that we use 16MB TLB #1 onwards for the mapping.
         bar0_offset = offset - architecture_implementation->get_dram_channel_0_peer2peer_region_start()
@@ -3249,6 +3528,7 @@ void *tt_SiliconDevice::channel_address(std::uint32_t offset, const tt_cxy_pair&
 }
 
 void *tt_SiliconDevice::host_dma_address(std::uint64_t offset, chip_id_t src_device_id, uint16_t channel) const {
+    hugepage_loader.wait_for_channel(src_device_id, channel);
 
     if (hugepage_mapping.at(src_device_id).at(channel) != nullptr) {
         return static_cast<std::byte*>(hugepage_mapping.at(src_device_id).at(channel)) + offset;
@@ -3336,7 +3616,7 @@ uint16_t tt_SiliconDevice::get_sys_rack(uint32_t rack_x, uint32_t rack_y) {
 }
 
 bool tt_SiliconDevice::is_non_mmio_cmd_q_full(uint32_t curr_wptr, uint32_t curr_rptr) {
-  return (curr_wptr != curr_rptr) && ((curr_wptr & eth_interface_params.cmd_buf_size_mask) == (curr_rptr & eth_interface_params.cmd_buf_size_mask));
+  return tt_is_eth_cmd_q_full(eth_interface_params, curr_wptr, curr_rptr);
 }
 
 /*
@@ -3379,7 +3659,7 @@ bool tt_SiliconDevice::is_non_mmio_cmd_q_full(uint32_t curr_wptr, uint32_t curr_
  * Considering the above, the current chosen approach is to make each of these calls acquired a shared mutex:
  * `NON_MMIO_MUTEX_NAME`
  *  - They acquire at a relatively large granularity -> for the entire duration of the function where we interact
- *    with the ethernet core (read/write) and where we use `active_core` to choose a core.
+ *    with the ethernet core (read/write) and where we use `active_core` (per MMIO chip) to choose a core.
  *    - Simplifies synchronization while we reach stability
  *  - We need to include any usage (read/modify) of `active_core` in the mutex acquisition scope.
  *
@@ -3445,7 +3725,7 @@ void tt_SiliconDevice::write_to_non_mmio_device(
     const scoped_lock<named_mutex> lock(
         *get_mutex(NON_MMIO_MUTEX_NAME, this->get_pci_device(mmio_capable_chip_logical)->id));
 
-    int& active_core_for_txn = non_mmio_transfer_cores_customized ? active_eth_core_idx_per_chip.at(mmio_capable_chip_logical) : active_core;
+    int& active_core_for_txn = non_mmio_transfer_cores_customized ? active_eth_core_idx_per_chip.at(mmio_capable_chip_logical) : active_core.at(mmio_capable_chip_logical);
     tt_cxy_pair remote_transfer_ethernet_core = remote_transfer_ethernet_cores.at(mmio_capable_chip_logical)[active_core_for_txn];
 
     erisc_command.resize(sizeof(routing_cmd_t)/DATA_WORD_SIZE);
@@ -3732,34 +4012,51 @@ void tt_SiliconDevice::write_to_non_mmio_device_send_epoch_cmd(const uint32_t *m
     }
 }
 
+// Ethernet queues of the MMIO chip closest to core's chip, used to write to core. Only used while the NON_MMIO mutex is held.
+class tt_SiliconDevice::eth_queue_io : public tt_eth_queue_io {
+   public:
+    eth_queue_io(tt_SiliconDevice* device, tt_cxy_pair core, chip_id_t mmio_chip) :
+        device(device), core(core), mmio_chip(mmio_chip), target_chip(device->ndesc->get_chip_locations().at(core.chip)) {}
+
+    void read_queue(int queue, std::uint32_t address, void* data, std::uint32_t size_in_bytes) override {
+        device->read_device_memory(data, device->remote_transfer_ethernet_cores.at(mmio_chip)[queue], address, size_in_bytes, "LARGE_READ_TLB");
+    }
+    void write_queue(int queue, std::uint32_t address, const void* data, std::uint32_t size_in_bytes) override {
+        device->write_device_memory(data, size_in_bytes, device->remote_transfer_ethernet_cores.at(mmio_chip)[queue], address, "LARGE_WRITE_TLB");
+    }
+    int get_next_queue(int queue) const override {
+        queue++;
+        if (device->non_mmio_transfer_cores_customized) {
+            return queue & (device->remote_transfer_ethernet_cores.at(mmio_chip).size() - 1);
+        }
+        return (queue & NON_EPOCH_ETH_CORES_MASK) + NON_EPOCH_ETH_CORES_START_ID;
+    }
+    void write_sysmem(std::uint64_t address, const void* data, std::uint32_t size_in_bytes) override {
+        // WH can only map ETH buffers to channel 0.
+        device->write_to_sysmem(data, size_in_bytes, address, 0, mmio_chip);
+    }
+    std::uint64_t get_sys_addr(std::uint64_t address) const override {
+        return device->get_sys_addr(std::get<0>(target_chip), std::get<1>(target_chip), core.x, core.y, address);
+    }
+    std::uint16_t get_rack() const override {
+        return device->get_sys_rack(std::get<2>(target_chip), std::get<3>(target_chip));
+    }
+    void flush_writes() override { tt_driver_atomics::sfence(); }
+
+   private:
+    tt_SiliconDevice* device;
+    tt_cxy_pair core;
+    chip_id_t mmio_chip;
+    eth_coord_t target_chip;
+};
+
 /*
  * Note that this function is required to acquire the `NON_MMIO_MUTEX_NAME` mutex for interacting with the ethernet core (host) command queue
  * DO NOT issue any pcie reads/writes to the ethernet core prior to acquiring the mutex. For extra information, see the "NON_MMIO_MUTEX Usage" above
  */
 void tt_SiliconDevice::rolled_write_to_non_mmio_device(const uint32_t *mem_ptr, uint32_t size_in_bytes, tt_cxy_pair core, uint64_t address, uint32_t unroll_count) {
-    using data_word_t = uint32_t;
-    constexpr int DATA_WORD_SIZE = sizeof(data_word_t);
-
-    std::string write_tlb = "LARGE_WRITE_TLB";
-    std::string read_tlb = "LARGE_READ_TLB";
-    std::string empty_tlb = "";
     translate_to_noc_table_coords(core.chip, core.y, core.x);
-
-    const eth_coord_t target_chip = ndesc->get_chip_locations().at(core.chip);
-
-
-    std::vector<std::uint32_t> erisc_command;
-    std::vector<std::uint32_t> erisc_q_rptr = std::vector<uint32_t>(1);
-    std::vector<std::uint32_t> erisc_q_ptrs = std::vector<uint32_t>(eth_interface_params.remote_update_ptr_size_bytes*2 / sizeof(uint32_t));
-
-    std::vector<std::uint32_t> data_block = std::vector<uint32_t>(size_in_bytes / DATA_WORD_SIZE);
-
-    routing_cmd_t *new_cmd;
-
     flush_non_mmio = true;
-    uint32_t transfer_size = size_in_bytes * unroll_count;
-    uint32_t buffer_id = 0;
-    uint32_t timestamp = 0; //CMD_TIMESTAMP;
 
     //
     //                    MUTEX ACQUIRE (NON-MMIO)
@@ -3774,85 +4071,24 @@ void tt_SiliconDevice::rolled_write_to_non_mmio_device(const uint32_t *mem_ptr,
     const scoped_lock<named_mutex> lock(
         *get_mutex(NON_MMIO_MUTEX_NAME, this->get_pci_device(mmio_capable_chip_logical)->id));
 
-    erisc_command.resize(sizeof(routing_cmd_t)/DATA_WORD_SIZE);
-    new_cmd = (routing_cmd_t *)&erisc_command[0];
-    int& active_core_for_txn = non_mmio_transfer_cores_customized ? active_eth_core_idx_per_chip.at(mmio_capable_chip_logical) : active_core;
-    read_device_memory(erisc_q_ptrs.data(), remote_transfer_ethernet_cores.at(mmio_capable_chip_logical)[active_core_for_txn], eth_interface_params.request_cmd_queue_base + eth_interface_params.cmd_counters_size_bytes, eth_interface_params.remote_update_ptr_size_bytes*2, read_tlb);
-
-    uint32_t offset = 0;
-
-    bool full = is_non_mmio_cmd_q_full(erisc_q_ptrs[0], erisc_q_ptrs[4]);
-    erisc_q_rptr.resize(1);
-    erisc_q_rptr[0] = erisc_q_ptrs[4];
-
-    uint32_t unroll_offset = 0;
-
-    while (offset < transfer_size) {
-        while (full) {
-            read_device_memory(erisc_q_rptr.data(), remote_transfer_ethernet_cores.at(mmio_capable_chip_logical)[active_core_for_txn], eth_interface_params.request_cmd_queue_base + eth_interface_params.cmd_counters_size_bytes + eth_interface_params.remote_update_ptr_size_bytes, DATA_WORD_SIZE, read_tlb);
-            full = is_non_mmio_cmd_q_full(erisc_q_ptrs[0],erisc_q_rptr[0]);
-        }
-        //full = true;
-        // set full only if this command will make the q full.
-        // otherwise full stays false so that we do not poll the rd pointer in next iteration.
-        // As long as current command push does not fill up the queue completely, we do not want
-        // to poll rd pointer in every iteration.
-        //full = is_non_mmio_cmd_q_full((erisc_q_ptrs[0] + 1) & CMD_BUF_PTR_MASK, erisc_q_rptr[0]);
-
-        log_assert(((address + offset) & 0x1F) == 0, "Base address + offset in incorrect range!");
-
-        uint32_t req_wr_ptr = erisc_q_ptrs[0] & eth_interface_params.cmd_buf_size_mask;
-
-        uint32_t req_flags = eth_interface_params.cmd_data_block_dram | eth_interface_params.cmd_data_block | eth_interface_params.cmd_wr_req;
-        timestamp = 0;
-
-        uint32_t host_dram_block_addr = host_address_params.eth_routing_buffers_start + (active_core_for_txn * eth_interface_params.cmd_buf_size + req_wr_ptr) * host_address_params.eth_routing_block_size;
-        uint16_t host_dram_channel = 0; // This needs to be 0, since WH can only map ETH buffers to chan 0.
-
-        memcpy(data_block.data(), mem_ptr, size_in_bytes);
-        uint32_t byte_increment = data_block.size() * DATA_WORD_SIZE;
-        uint32_t host_mem_offset = 0;
-        uint32_t i = 0;
-        for (i = 0; (i + unroll_offset) < unroll_count; i++) {
-            if ((host_mem_offset + byte_increment) > host_address_params.eth_routing_block_size) {
-                break;
-            }
-            data_block[0] = i + unroll_offset;
-            write_to_sysmem(data_block, host_dram_block_addr + host_mem_offset, host_dram_channel, mmio_capable_chip_logical);
-            host_mem_offset += byte_increment;
-        }
-        unroll_offset += i;
-        tt_driver_atomics::sfence();
-        new_cmd->sys_addr = get_sys_addr(std::get<0>(target_chip), std::get<1>(target_chip), core.x, core.y, address + offset);
-        new_cmd->rack = get_sys_rack(std::get<2>(target_chip), std::get<3>(target_chip));
-        new_cmd->data = host_mem_offset;
-        new_cmd->flags = req_flags;
-        new_cmd->src_addr_tag = host_dram_block_addr;
-
-        write_device_memory(erisc_command.data(), erisc_command.size() * DATA_WORD_SIZE, remote_transfer_ethernet_cores.at(mmio_capable_chip_logical)[active_core_for_txn], eth_interface_params.request_routing_cmd_queue_base + (sizeof(routing_cmd_t) * req_wr_ptr), write_tlb);
-        tt_driver_atomics::sfence();
-        erisc_q_ptrs[0] = (erisc_q_ptrs[0] + 1) & eth_interface_params.cmd_buf_ptr_mask;
-        std::vector<std::uint32_t> erisc_q_wptr;
-        erisc_q_wptr.resize(1);
-        erisc_q_wptr[0] = erisc_q_ptrs[0];
-        write_device_memory(erisc_q_wptr.data(), erisc_q_wptr.size() * DATA_WORD_SIZE, remote_transfer_ethernet_cores.at(mmio_capable_chip_logical)[active_core_for_txn], eth_interface_params.request_cmd_queue_base + eth_interface_params.cmd_counters_size_bytes, write_tlb);
-        tt_driver_atomics::sfence();
-        offset += host_mem_offset;
-
-        // If there is more data to send and this command will make the q full, switch to next Q.
-        // otherwise full stays false so that we do not poll the rd pointer in next iteration.
-        // As long as current command push does not fill up the queue completely, we do not want
-        // to poll rd pointer in every iteration.
+    int& active_core_for_txn = non_mmio_transfer_cores_customized ? active_eth_core_idx_per_chip.at(mmio_capable_chip_logical) : active_core.at(mmio_capable_chip_logical);
+    eth_queue_io io = eth_queue_io(this, core, mmio_capable_chip_logical);
+    tt_rolled_write_to_remote(io, eth_interface_params, host_address_params, active_core_for_txn, mem_ptr, size_in_bytes, unroll_count, address, get_rolled_write_staging());
+}
 
-        if (is_non_mmio_cmd_q_full((erisc_q_ptrs[0]) & eth_interface_params.cmd_buf_ptr_mask, erisc_q_rptr[0])) {
-            active_core_for_txn++;
-            uint32_t update_mask_for_chip = (remote_transfer_ethernet_cores[mmio_capable_chip_logical].size() - 1);
-            active_core_for_txn = non_mmio_transfer_cores_customized ? (active_core_for_txn & update_mask_for_chip) : ((active_core_for_txn & NON_EPOCH_ETH_CORES_MASK) + NON_EPOCH_ETH_CORES_START_ID);
-            read_device_memory(erisc_q_ptrs.data(), remote_transfer_ethernet_cores.at(mmio_capable_chip_logical)[active_core_for_txn], eth_interface_params.request_cmd_queue_base + eth_interface_params.cmd_counters_size_bytes, eth_interface_params.remote_update_ptr_size_bytes*2, read_tlb);
-            full = is_non_mmio_cmd_q_full(erisc_q_ptrs[0], erisc_q_ptrs[4]);
-            erisc_q_rptr[0] = erisc_q_ptrs[4];
-        }
+std::vector<uint32_t> tt_SiliconDevice::get_rolled_write_commands(uint32_t size_in_bytes, uint32_t unroll_count, uint32_t max_block_size) {
+    std::vector<uint32_t> slots_per_cmd = {};
+    if (size_in_bytes == 0) {
+        return slots_per_cmd;
+    }
+    log_assert(size_in_bytes <= max_block_size, "Rolled write slot of {} bytes exceeds the block size of {} bytes", size_in_bytes, max_block_size);
+    const uint32_t max_slots = max_block_size / size_in_bytes;
+    for (uint32_t remaining = unroll_count; remaining > 0;) {
+        const uint32_t num_slots = std::min(remaining, max_slots);
+        slots_per_cmd.push_back(num_slots);
+        remaining -= num_slots;
     }
+    return slots_per_cmd;
 }
 
 /*
@@ -4184,15 +4420,22 @@ std::unordered_map<chip_id_t, std::vector<std::vector<int>>>& tt_SiliconDevice::
     return bcast_header_cache[chips_to_exclude];
 }
 
-void tt_SiliconDevice::pcie_broadcast_write(chip_id_t chip, const void* mem_ptr, uint32_t size_in_bytes, std::uint32_t addr, const tt_xy_pair& start, const tt_xy_pair& end, const std::string& fallback_tlb) {
-    // Use the specified TLB to broadcast data to all cores included in the [start, end] grid -> GS Only. Use Ethernet Broadcast for WH.
+void tt_SiliconDevice::pcie_broadcast_write(chip_id_t chip, const void* mem_ptr, uint32_t size_in_bytes, std::uint32_t addr, const tt_xy_pair& start, const tt_xy_pair& end, const std::string& fallback_tlb, bool mark_membar_dirty) {
+    // Use the specified TLB to broadcast data to all cores included in the [start, end] grid on a single MMIO chip.
+    // Cluster wide broadcasts use this on GS, and on WH when Ethernet Broadcast isn't supported: each Tensix rectangle of
+    // an MMIO chip is written with one call (see plan_ethernet_broadcast).
     struct PCIdevice* pci_device = get_pci_device(chip);
     const auto tlb_index = dynamic_tlb_config.at(fallback_tlb);
     TTDevice *dev = pci_device->hdev;
     const uint8_t* buffer_addr = static_cast<const uint8_t*>(mem_ptr);
+    const auto& coord_translation = harvested_coord_translation.at(chip);
+    tt_membar_dirty_cores* dirty_cores = mark_membar_dirty ? get_membar_dirty_cores(chip) : nullptr;
+    if (dirty_cores) {
+        dirty_cores->mark_grid(start, end);
+    }
     const scoped_lock<named_mutex> lock(*get_mutex(fallback_tlb, pci_device -> id));
     while(size_in_bytes > 0) {
-        auto [mapped_address, tlb_size] = set_dynamic_tlb_broadcast(pci_device, tlb_index, addr, harvested_coord_translation, start, end, dynamic_tlb_ordering_modes.at(fallback_tlb));
+        auto [mapped_address, tlb_size] = set_dynamic_tlb_broadcast(pci_device, tlb_index, addr, coord_translation, start, end, dynamic_tlb_ordering_modes.at(fallback_tlb));
         uint64_t transfer_size = std::min((uint64_t)size_in_bytes, tlb_size);
         write_block(dev, mapped_address, transfer_size, buffer_addr, m_dma_buf_size);
 
@@ -4200,6 +4443,9 @@ void tt_SiliconDevice::pcie_broadcast_write(chip_id_t chip, const void* mem_ptr,
         addr += transfer_size;
         buffer_addr += transfer_size;
     }
+    if (dirty_cores) {
+        dirty_cores->mark_grid(start, end);
+    }
 }
 
 inline bool tensix_or_eth_in_broadcast(const std::set<uint32_t>& cols_to_exclude, const tt::umd::architecture_implementation* architecture_implementation) {
@@ -4222,13 +4468,12 @@ inline bool valid_tensix_broadcast_grid(const std::set<uint32_t>& rows_to_exclud
 }
 
 
-void tt_SiliconDevice::ethernet_broadcast_write(const void *mem_ptr, uint32_t size_in_bytes, uint64_t address,
-                                                const std::set<chip_id_t>& chips_to_exclude, const std::set<uint32_t>& rows_to_exclude, 
-                                                std::set<uint32_t>& cols_to_exclude, const std::string& fallback_tlb, bool use_virtual_coords) {
+void tt_SiliconDevice::plan_ethernet_broadcast(tt_broadcast_plan& plan, const std::set<chip_id_t>& chips_to_exclude, const std::set<uint32_t>& rows_to_exclude,
+                                               const std::set<uint32_t>& cols_to_exclude, bool use_virtual_coords) {
     if(use_ethernet_broadcast) {
         // Broadcast through ERISC core supported
-        std::unordered_map<chip_id_t, std::vector<std::vector<int>>>& broadcast_headers = get_ethernet_broadcast_headers(chips_to_exclude);
-        // Apply row and column exclusion mask explictly. Placing this here if we want to cache the higher level broadcast headers on future/
+        std::unordered_map<chip_id_t, std::vector<std::vector<int>>> broadcast_headers = get_ethernet_broadcast_headers(chips_to_exclude);
+        // Apply row and column exclusion mask explictly. The headers cached per set of excluded chips don't include them.
         std::uint32_t row_exclusion_mask = 0;
         std::uint32_t col_exclusion_mask = 0;
         for(const auto& row : rows_to_exclude) {
@@ -4238,33 +4483,60 @@ void tt_SiliconDevice::ethernet_broadcast_write(const void *mem_ptr, uint32_t si
         for(const auto& col : cols_to_exclude) {
             col_exclusion_mask |= 1 << (16 + col);
         }
-        // Write broadcast block to device.
         for(auto& mmio_group : broadcast_headers) {
             for(auto& header : mmio_group.second) {
                 header.at(4) = use_virtual_coords * 0x8000; // Reset row/col exclusion masks
                 header.at(4) |= row_exclusion_mask;
                 header.at(4) |= col_exclusion_mask;
-                // Write Target: x-y endpoint is a don't care. Initialize to tt_xy_pair(1, 1)
-                write_to_non_mmio_device(mem_ptr, size_in_bytes, tt_cxy_pair(mmio_group.first, tt_xy_pair(1, 1)), address, true, header);
             }
         }
+        plan.ethernet_broadcasts.push_back(std::move(broadcast_headers));
     }
     else {
-        // Broadcast not supported. Implement this at the software level as a for loop
-        std::vector<tt_cxy_pair> cores_to_write = {};
+        // Broadcast not supported. Implement this at the software level: Tensix rectangles on MMIO chips are written with
+        // one multicast each and all other cores one by one.
         for(const auto& chip : target_devices_in_cluster) {
             if(chips_to_exclude.find(chip) != chips_to_exclude.end()) continue;
-            for(const auto& core : get_soc_descriptor(chip).cores) {
-                if(cols_to_exclude.find(core.first.x) == cols_to_exclude.end() and rows_to_exclude.find(core.first.y) == rows_to_exclude.end() and core.second.type != CoreType::HARVESTED) {
-                    write_to_device(mem_ptr, size_in_bytes, tt_cxy_pair(chip, core.first.x, core.first.y), address, fallback_tlb);
-                }
-            }
+            tt_broadcast_chip_targets targets = {};
+            targets.chip = chip;
+            get_broadcast_targets(get_soc_descriptor(chip), rows_to_exclude, cols_to_exclude, ndesc->is_chip_mmio_capable(chip), targets.grids, targets.unicast_cores);
+            plan.direct_writes_per_gateway[ndesc->get_closest_mmio_capable_chip(chip)].push_back(std::move(targets));
         }
     }
 }
 
-void tt_SiliconDevice::broadcast_write_to_cluster(const void *mem_ptr, uint32_t size_in_bytes, uint64_t address,
-                       const std::set<chip_id_t>& chips_to_exclude, std::set<uint32_t>& rows_to_exclude, std::set<uint32_t>& cols_to_exclude, const std::string& fallback_tlb) {
+void tt_SiliconDevice::get_broadcast_targets(const tt_SocDescriptor& sdesc, const std::set<uint32_t>& rows_to_exclude, const std::set<uint32_t>& cols_to_exclude, bool use_multicast,
+                                             std::vector<tt_multicast_grid>& grids, std::vector<tt_xy_pair>& unicast_cores) {
+    std::unordered_set<tt_xy_pair> multicast_cores = {};
+    for(const auto& core : sdesc.cores) {
+        if(cols_to_exclude.find(core.first.x) != cols_to_exclude.end() or rows_to_exclude.find(core.first.y) != rows_to_exclude.end() or core.second.type == CoreType::HARVESTED) {
+            continue;
+        }
+        // Only Tensix cores are multicast to, so a rectangle never reaches DRAM, ARC, PCIe or router cores.
+        if(use_multicast and core.second.type == CoreType::WORKER) {
+            multicast_cores.insert(core.first);
+        } else {
+            unicast_cores.push_back(core.first);
+        }
+    }
+    grids = tt_get_multicast_grids(multicast_cores);
+    for(const auto& core : multicast_cores) {
+        if(std::none_of(grids.begin(), grids.end(), [&] (const tt_multicast_grid& grid) { return grid.contains(core); })) {
+            unicast_cores.push_back(core);
+        }
+    }
+}
+
+tt_broadcast_plan tt_SiliconDevice::create_broadcast_plan(const std::set<chip_id_t>& chips_to_exclude, const std::set<uint32_t>& rows_to_exclude_, const std::set<uint32_t>& cols_to_exclude_) {
+    tt_broadcast_plan plan = {};
+    // Grid generation adds the non Tensix rows and columns to the exclusion sets, so work on copies.
+    std::set<uint32_t> rows_to_exclude = rows_to_exclude_;
+    std::set<uint32_t> cols_to_exclude = cols_to_exclude_;
+    for(const auto& chip : target_devices_in_cluster) {
+        if(chips_to_exclude.find(chip) == chips_to_exclude.end()) {
+            plan.target_chips.insert(chip);
+        }
+    }
     if (arch_name == tt::ARCH::GRAYSKULL) {
         // Device FW disables broadcasts to all non tensix cores.
         std::vector<tt_xy_pair> dram_cores_to_write = {};
@@ -4281,20 +4553,21 @@ void tt_SiliconDevice::broadcast_write_to_cluster(const void *mem_ptr, uint32_t
         
         std::set<std::pair<tt_xy_pair, tt_xy_pair>> broadcast_grids = {};
         generate_tensix_broadcast_grids_for_grayskull(broadcast_grids, rows_to_exclude, cols_to_exclude);
-        for(const auto& chip : target_devices_in_cluster) {
-            if(chips_to_exclude.find(chip) != chips_to_exclude.end()) continue;
-            for(const auto& dram : dram_cores_to_write) {
-                write_device_memory(mem_ptr, size_in_bytes, tt_cxy_pair(chip, dram), address, fallback_tlb);
-            }
+        for(const auto& chip : plan.target_chips) {
+            tt_broadcast_chip_targets targets = {};
+            targets.chip = chip;
+            targets.unicast_cores = dram_cores_to_write;
             for(const auto& grid : broadcast_grids) {
-                pcie_broadcast_write(chip, mem_ptr, size_in_bytes, address, grid.first, grid.second, fallback_tlb);
+                targets.grids.push_back({grid.first, grid.second});
             }
-        } 
+            // All GS chips are MMIO chips
+            plan.direct_writes_per_gateway[chip].push_back(std::move(targets));
+        }
     }
     else if (arch_name == tt::ARCH::BLACKHOLE) {
-        auto architecture_implementation = tt::umd::architecture_implementation::create(static_cast<tt::umd::architecture>(arch_name));
+        auto architecture_implementation = m_pci_device_map.begin()->second->hdev->get_architecture_implementation();
         if(cols_to_exclude.find(0) == cols_to_exclude.end() or cols_to_exclude.find(9) == cols_to_exclude.end()) {
-            log_assert(!tensix_or_eth_in_broadcast(cols_to_exclude, architecture_implementation.get()), "Cannot broadcast to tensix/ethernet and DRAM simultaneously on Blackhole.");
+            log_assert(!tensix_or_eth_in_broadcast(cols_to_exclude, architecture_implementation), "Cannot broadcast to tensix/ethernet and DRAM simultaneously on Blackhole.");
             if(cols_to_exclude.find(0) == cols_to_exclude.end()) {
                 // When broadcast includes column zero do not exclude anything
                 std::set<uint32_t> unsafe_rows = {};
@@ -4302,27 +4575,27 @@ void tt_SiliconDevice::broadcast_write_to_cluster(const void *mem_ptr, uint32_t
                 std::set<uint32_t> rows_to_exclude_for_col_0_bcast = rows_to_exclude;
                 cols_to_exclude_for_col_0_bcast.insert(9);
                 rows_to_exclude_for_col_0_bcast.insert(unsafe_rows.begin(), unsafe_rows.end());
-                ethernet_broadcast_write(mem_ptr, size_in_bytes, address, chips_to_exclude,
-                                        rows_to_exclude_for_col_0_bcast, cols_to_exclude_for_col_0_bcast, fallback_tlb, false);
+                plan_ethernet_broadcast(plan, chips_to_exclude,
+                                        rows_to_exclude_for_col_0_bcast, cols_to_exclude_for_col_0_bcast, false);
             }
             if(cols_to_exclude.find(9) == cols_to_exclude.end()) {
                 std::set<uint32_t> cols_to_exclude_for_col_9_bcast = cols_to_exclude;
                 cols_to_exclude_for_col_9_bcast.insert(0);
-                ethernet_broadcast_write(mem_ptr, size_in_bytes, address, chips_to_exclude,
-                                        rows_to_exclude, cols_to_exclude_for_col_9_bcast, fallback_tlb, false);
+                plan_ethernet_broadcast(plan, chips_to_exclude,
+                                        rows_to_exclude, cols_to_exclude_for_col_9_bcast, false);
             }
         }
         else {
-            log_assert(use_virtual_coords_for_eth_broadcast or valid_tensix_broadcast_grid(rows_to_exclude, cols_to_exclude, architecture_implementation.get()), 
+            log_assert(use_virtual_coords_for_eth_broadcast or valid_tensix_broadcast_grid(rows_to_exclude, cols_to_exclude, architecture_implementation), 
                         "Must broadcast to all tensix rows when ERISC FW is < 6.8.0.");
-            ethernet_broadcast_write(mem_ptr, size_in_bytes, address, chips_to_exclude,
-                                    rows_to_exclude, cols_to_exclude, fallback_tlb, use_virtual_coords_for_eth_broadcast);
+            plan_ethernet_broadcast(plan, chips_to_exclude,
+                                    rows_to_exclude, cols_to_exclude, use_virtual_coords_for_eth_broadcast);
         }
     }
     else {
-        auto architecture_implementation = tt::umd::architecture_implementation::create(static_cast<tt::umd::architecture>(arch_name));
+        auto architecture_implementation = m_pci_device_map.begin()->second->hdev->get_architecture_implementation();
         if(cols_to_exclude.find(0) == cols_to_exclude.end() or cols_to_exclude.find(5) == cols_to_exclude.end()) {
-            log_assert(!tensix_or_eth_in_broadcast(cols_to_exclude, architecture_implementation.get()), "Cannot broadcast to tensix/ethernet and DRAM simultaneously on Wormhole.");
+            log_assert(!tensix_or_eth_in_broadcast(cols_to_exclude, architecture_implementation), "Cannot broadcast to tensix/ethernet and DRAM simultaneously on Wormhole.");
             if(cols_to_exclude.find(0) == cols_to_exclude.end()) {
                 // When broadcast includes column zero Exclude PCIe, ARC and router cores from broadcast explictly, since writing to these is unsafe
                 // ERISC FW does not exclude these.
@@ -4331,91 +4604,208 @@ void tt_SiliconDevice::broadcast_write_to_cluster(const void *mem_ptr, uint32_t
                 std::set<uint32_t> rows_to_exclude_for_col_0_bcast = rows_to_exclude;
                 cols_to_exclude_for_col_0_bcast.insert(5);
                 rows_to_exclude_for_col_0_bcast.insert(unsafe_rows.begin(), unsafe_rows.end());
-                ethernet_broadcast_write(mem_ptr, size_in_bytes, address, chips_to_exclude,
-                                        rows_to_exclude_for_col_0_bcast, cols_to_exclude_for_col_0_bcast, fallback_tlb, false);
+                plan_ethernet_broadcast(plan, chips_to_exclude,
+                                        rows_to_exclude_for_col_0_bcast, cols_to_exclude_for_col_0_bcast, false);
             }
             if(cols_to_exclude.find(5) == cols_to_exclude.end()) {
                 std::set<uint32_t> cols_to_exclude_for_col_5_bcast = cols_to_exclude;
                 cols_to_exclude_for_col_5_bcast.insert(0);
-                ethernet_broadcast_write(mem_ptr, size_in_bytes, address, chips_to_exclude,
-                                        rows_to_exclude, cols_to_exclude_for_col_5_bcast, fallback_tlb, false);
+                plan_ethernet_broadcast(plan, chips_to_exclude,
+                                        rows_to_exclude, cols_to_exclude_for_col_5_bcast, false);
             }
         }
         else {
-            log_assert(use_virtual_coords_for_eth_broadcast or valid_tensix_broadcast_grid(rows_to_exclude, cols_to_exclude, architecture_implementation.get()), 
+            log_assert(use_virtual_coords_for_eth_broadcast or valid_tensix_broadcast_grid(rows_to_exclude, cols_to_exclude, architecture_implementation), 
                         "Must broadcast to all tensix rows when ERISC FW is < 6.8.0.");
-            ethernet_broadcast_write(mem_ptr, size_in_bytes, address, chips_to_exclude,
-                                    rows_to_exclude, cols_to_exclude, fallback_tlb, use_virtual_coords_for_eth_broadcast);
+            plan_ethernet_broadcast(plan, chips_to_exclude,
+                                    rows_to_exclude, cols_to_exclude, use_virtual_coords_for_eth_broadcast);
         }
     }
+    return plan;
 }
 
-int tt_SiliconDevice::remote_arc_msg(int chip, uint32_t msg_code, bool wait_for_done, uint32_t arg0, uint32_t arg1, int timeout, uint32_t *return_3, uint32_t *return_4) {
-    constexpr uint64_t ARC_RESET_SCRATCH_ADDR = 0x880030060;
-    constexpr uint64_t ARC_RESET_MISC_CNTL_ADDR = 0x880030100;
+void tt_issue_broadcast(tt_broadcast_io& io, tt_mmio_fan_out& fan_out, const tt_broadcast_plan& plan) {
+    for(const auto& broadcast_headers : plan.ethernet_broadcasts) {
+        std::vector<chip_id_t> mmio_groups = {};
+        for(const auto& mmio_group : broadcast_headers) {
+            mmio_groups.push_back(mmio_group.first);
+        }
+        fan_out.run_per_device(mmio_groups, [&] (chip_id_t mmio_chip) {
+            for(const auto& header : broadcast_headers.at(mmio_chip)) {
+                io.write_ethernet_broadcast(mmio_chip, header);
+            }
+        });
+    }
+    std::vector<chip_id_t> gateways = {};
+    for(const auto& gateway : plan.direct_writes_per_gateway) {
+        gateways.push_back(gateway.first);
+    }
+    fan_out.run_per_device(gateways, [&] (chip_id_t gateway) {
+        for(const auto& targets : plan.direct_writes_per_gateway.at(gateway)) {
+            for(const auto& grid : targets.grids) {
+                io.multicast_write(targets.chip, grid.start, grid.end);
+            }
+            for(const auto& core : targets.unicast_cores) {
+                io.write(targets.chip, core);
+            }
+        }
+    });
+}
 
-    auto core = tt_cxy_pair(chip, get_soc_descriptor(chip).arc_cores.at(0));
+// Broadcast payloads go through the same paths as any other write to the chip, which mark the cores they write dirty.
+class tt_SiliconDevice::broadcast_io : public tt_broadcast_io {
+   public:
+    broadcast_io(tt_SiliconDevice* device, const void* mem_ptr, std::uint32_t size_in_bytes, std::uint64_t address, const std::string& fallback_tlb) :
+        device(device), mem_ptr(mem_ptr), size_in_bytes(size_in_bytes), address(address), fallback_tlb(fallback_tlb) {}
 
-    if ((msg_code & 0xff00) != 0xaa00) {
-        log_error("Malformed message. msg_code is 0x{:x} but should be 0xaa..\n", msg_code);
+    void write_ethernet_broadcast(chip_id_t mmio_chip, const std::vector<int>& header) override {
+        // Write Target: x-y endpoint is a don't care. Initialize to tt_xy_pair(1, 1)
+        device->write_to_non_mmio_device(mem_ptr, size_in_bytes, tt_cxy_pair(mmio_chip, tt_xy_pair(1, 1)), address, true, header);
+    }
+    void multicast_write(chip_id_t chip, const tt_xy_pair& start, const tt_xy_pair& end) override {
+        device->pcie_broadcast_write(chip, mem_ptr, size_in_bytes, address, start, end, fallback_tlb);
+    }
+    void write(chip_id_t chip, const tt_xy_pair& core) override {
+        device->write_to_device(mem_ptr, size_in_bytes, tt_cxy_pair(chip, core), address, fallback_tlb);
     }
-    log_assert (arg0 <= 0xffff and arg1 <= 0xffff, "Only 16 bits allowed in arc_msg args"); // Only 16 bits are allowed
 
-    uint32_t fw_arg = arg0 | (arg1<<16);
-    int exit_code = 0;
+   private:
+    tt_SiliconDevice* device;
+    const void* mem_ptr;
+    std::uint32_t size_in_bytes;
+    std::uint64_t address;
+    const std::string& fallback_tlb;
+};
 
-    {
-        write_to_non_mmio_device(&fw_arg, sizeof(fw_arg),  core, ARC_RESET_SCRATCH_ADDR + 3 * 4);
-    }
+void tt_SiliconDevice::broadcast_write_to_cluster(const void *mem_ptr, uint32_t size_in_bytes, uint64_t address,
+                       const std::set<chip_id_t>& chips_to_exclude, std::set<uint32_t>& rows_to_exclude, std::set<uint32_t>& cols_to_exclude, const std::string& fallback_tlb) {
+    broadcast_write_to_cluster(mem_ptr, size_in_bytes, address, create_broadcast_plan(chips_to_exclude, rows_to_exclude, cols_to_exclude), fallback_tlb);
+}
 
-    {
-        write_to_non_mmio_device(&msg_code, sizeof(fw_arg), core, ARC_RESET_SCRATCH_ADDR + 5 * 4);
+void tt_SiliconDevice::broadcast_write_to_cluster(const void *mem_ptr, uint32_t size_in_bytes, uint64_t address, const tt_broadcast_plan& plan, const std::string& fallback_tlb) {
+    // The cores reached by a broadcast depend on the arch and ERISC FW, so conservatively treat all cores as written.
+    // Marked before and after the broadcast, like every other write (see tt_membar_dirty_cores).
+    const auto mark_target_chips = [&] {
+        for(const auto& chip : plan.target_chips) {
+            if(auto dirty_cores = get_membar_dirty_cores(chip)) {
+                dirty_cores->mark_all();
+            }
+        }
+    };
+    mark_target_chips();
+    broadcast_io io = broadcast_io(this, mem_ptr, size_in_bytes, address, fallback_tlb);
+    tt_issue_broadcast(io, mmio_fan_out, plan);
+    mark_target_chips();
+}
+
+void tt_SiliconDevice::start_io_workers(std::size_t max_workers_per_device) {
+    log_assert(io_worker_pools.empty(), "I/O workers are already started");
+    log_assert(max_workers_per_device > 0, "Need at least one I/O worker per device");
+    for (const auto& pci_device : m_pci_device_map) {
+        const chip_id_t mmio_chip = pci_device.first;
+        const chip_id_t physical_device_id = pci_device.second->id;
+        const int cores_allocated = tt::cpuset::tt_cpuset_allocator::get_num_cpu_cores_allocated_to_device(physical_device_id);
+        const std::size_t num_workers = std::max<std::size_t>(std::min<std::size_t>(std::max(cores_allocated, 0), max_workers_per_device), 1);
+        const std::vector<int> cpus = tt::cpuset::tt_cpuset_allocator::get_io_worker_cpus_for_device(physical_device_id, num_workers);
+        log_debug(LogSiliconDriver, "Starting {} I/O workers for device {} on PU's {}", num_workers, mmio_chip, cpus);
+        io_worker_pools[mmio_chip] = std::make_unique<tt_io_worker_pool>(num_workers, [cpus] (std::size_t worker) {
+            if (worker < cpus.size()) {
+                tt::cpuset::tt_cpuset_allocator::bind_thread_to_cpu(cpus.at(worker));
+            }
+        });
     }
+}
 
-    wait_for_non_mmio_flush();
-    uint32_t misc = 0;
-    read_from_non_mmio_device(&misc, core, ARC_RESET_MISC_CNTL_ADDR, 4);
+void tt_SiliconDevice::stop_io_workers() {
+    io_worker_pools.clear();
+}
 
-    if (misc & (1 << 16)) {
-        log_error("trigger_fw_int failed on device {}", chip);
-        return 1;
-    } else {
-        misc |= (1 << 16);
-        write_to_non_mmio_device(&misc, sizeof(misc), core, ARC_RESET_MISC_CNTL_ADDR);
+std::future<void> tt_SiliconDevice::submit_io(chip_id_t chip, std::function<void()> task) {
+    const chip_id_t mmio_chip = ndesc->is_chip_mmio_capable(chip) ? chip : ndesc->get_closest_mmio_capable_chip(chip);
+    auto pool = io_worker_pools.find(mmio_chip);
+    if (pool != io_worker_pools.end() && !tt_io_worker_pool::is_worker_thread()) {
+        return pool->second->submit(std::move(task));
     }
+    std::packaged_task<void()> in_place = std::packaged_task<void()>(std::move(task));
+    in_place();
+    return in_place.get_future();
+}
 
-    if (wait_for_done) {
-        uint32_t status = 0xbadbad;
-        auto timeout_seconds = std::chrono::seconds(timeout);
-        auto start = std::chrono::system_clock::now();
-        while (true) {
-            if (std::chrono::system_clock::now() - start > timeout_seconds) {
-                std::stringstream ss;
-                ss << std::hex << msg_code;
-                throw std::runtime_error("Timed out after waiting " + std::to_string(timeout) + " seconds for device " + std::to_string(chip) + " ARC to respond to message 0x" +  ss.str());
+std::future<void> tt_SiliconDevice::write_to_device_async(std::vector<tt_device_write> writes, const std::string& tlb_to_use) {
+    std::map<chip_id_t, std::vector<tt_device_write>> writes_per_mmio_chip = {};
+    for (const auto& write : writes) {
+        const chip_id_t chip = write.core.chip;
+        writes_per_mmio_chip[ndesc->is_chip_mmio_capable(chip) ? chip : ndesc->get_closest_mmio_capable_chip(chip)].push_back(write);
+    }
+    tt_io_task_group batch = tt_io_task_group(writes_per_mmio_chip.size());
+    for (auto& chip_writes : writes_per_mmio_chip) {
+        submit_io(chip_writes.first, batch.wrap([this, writes = std::move(chip_writes.second), tlb_to_use] {
+            for (const auto& write : writes) {
+                write_to_device(write.mem_ptr, write.size_in_bytes, write.core, write.addr, tlb_to_use);
             }
+        }));
+    }
+    return batch.get_future();
+}
 
-            uint32_t status = 0;
-            read_from_non_mmio_device(&status, core, ARC_RESET_SCRATCH_ADDR + 5 * 4, sizeof(status));
-            if ((status & 0xffff) == (msg_code & 0xff)) {
-                if (return_3 != nullptr) {
-                    read_from_non_mmio_device(return_3, core, ARC_RESET_SCRATCH_ADDR + 3 * 4, sizeof(uint32_t));
-                }
+std::future<void> tt_SiliconDevice::read_from_device_async(void* mem_ptr, tt_cxy_pair core, uint64_t addr, uint32_t size, const std::string& fallback_tlb) {
+    return submit_io(core.chip, [this, mem_ptr, core, addr, size, fallback_tlb] {
+        read_from_device(mem_ptr, core, addr, size, fallback_tlb);
+    });
+}
 
-                if (return_4 != nullptr) {
-                    read_from_non_mmio_device(return_4, core, ARC_RESET_SCRATCH_ADDR + 4 * 4, sizeof(uint32_t));
-                }
+std::future<void> tt_SiliconDevice::l1_membar_async(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores) {
+    return submit_io(chip, [this, chip, fallback_tlb, cores] {
+        l1_membar(chip, fallback_tlb, cores);
+    });
+}
 
-                exit_code = (status & 0xffff0000) >> 16;
-                break;
-            } else if (status == MSG_ERROR_REPLY) {
-                log_warning(LogSiliconDriver, "On device {}, message code 0x{:x} not recognized by FW", chip, msg_code);
-                exit_code = MSG_ERROR_REPLY;
-                break;
-            }
-        }
-    }
-    return exit_code;
+std::future<void> tt_SiliconDevice::dram_membar_async(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<uint32_t>& channels) {
+    return submit_io(chip, [this, chip, fallback_tlb, channels] {
+        dram_membar(chip, fallback_tlb, channels);
+    });
+}
+
+std::future<void> tt_SiliconDevice::write_to_sysmem_async(const void* mem_ptr, std::uint32_t size, uint64_t addr, uint16_t channel, chip_id_t src_device_id) {
+    return submit_io(src_device_id, [this, mem_ptr, size, addr, channel, src_device_id] {
+        write_to_sysmem(mem_ptr, size, addr, channel, src_device_id);
+    });
+}
+
+std::future<void> tt_SiliconDevice::read_from_sysmem_async(void* mem_ptr, uint64_t addr, uint16_t channel, uint32_t size, chip_id_t src_device_id) {
+    return submit_io(src_device_id, [this, mem_ptr, addr, channel, size, src_device_id] {
+        read_from_sysmem(mem_ptr, addr, channel, size, src_device_id);
+    });
+}
+
+std::size_t tt_SiliconDevice::get_num_io_workers(chip_id_t mmio_chip) const {
+    const tt_io_worker_pool* pool = get_io_worker_pool(mmio_chip);
+    return pool ? pool->get_num_workers() : 0;
+}
+
+tt_host_memory_placement tt_SiliconDevice::get_host_memory_placement(chip_id_t chip, bool use_hugepages) const {
+    const chip_id_t mmio_chip = ndesc->is_chip_mmio_capable(chip) ? chip : ndesc->get_closest_mmio_capable_chip(chip);
+    tt_host_memory_placement placement = {};
+    placement.physical_device_id = m_pci_device_map.at(mmio_chip)->id;
+    placement.use_hugepages = use_hugepages;
+    return placement;
+}
+
+tt_host_buffer tt_SiliconDevice::allocate_host_buffer(chip_id_t chip, std::size_t size, bool use_hugepages) {
+    return tt_host_buffer(size, get_host_memory_placement(chip, use_hugepages));
+}
+
+tt::numa_allocator tt_SiliconDevice::get_numa_allocator(chip_id_t chip, bool use_hugepages) {
+    return tt::numa_allocator(get_host_memory_placement(chip, use_hugepages));
+}
+
+tt_io_worker_pool* tt_SiliconDevice::get_io_worker_pool(chip_id_t mmio_chip) const {
+    auto pool = io_worker_pools.find(mmio_chip);
+    return pool == io_worker_pools.end() ? nullptr : pool->second.get();
+}
+
+void tt_SiliconDevice::pin_fan_out_worker(chip_id_t mmio_chip) {
+    tt::cpuset::tt_cpuset_allocator::bind_thread_to_cpuset(ndesc.get(), mmio_chip);
 }
 
 void tt_SiliconDevice::write_to_sysmem(const void* mem_ptr, std::uint32_t size,  uint64_t addr, uint16_t channel, chip_id_t src_device_id) {
@@ -4433,34 +4823,52 @@ void tt_SiliconDevice::read_from_sysmem(std::vector<uint32_t> &vec, uint64_t add
     read_dma_buffer(vec.data(), addr, channel, size, src_device_id);
 }
 
-void tt_SiliconDevice::set_membar_flag(const chip_id_t chip, const std::unordered_set<tt_xy_pair>& cores, const uint32_t barrier_value, const uint32_t barrier_addr, const std::string& fallback_tlb) {
-    tt_driver_atomics::sfence(); // Ensure that writes before this do not get reordered
-    std::unordered_set<tt_xy_pair> cores_synced = {};
-    std::vector<uint32_t> barrier_val_vec = {barrier_value};
-    for (const auto& core : cores) {
-        write_to_device(barrier_val_vec, tt_cxy_pair(chip, core), barrier_addr, fallback_tlb);
-    }
-    tt_driver_atomics::sfence(); // Ensure that all writes in the Host WC buffer are flushed
-    while (cores_synced.size() != cores.size()) {
-        for(const auto& core : cores) {
-            if (cores_synced.find(core) == cores_synced.end()) {
-                std::vector<uint32_t> readback_vec = {};
-                read_from_device(readback_vec, tt_cxy_pair(chip, core), barrier_addr, sizeof(std::uint32_t), fallback_tlb);
-                if (readback_vec.at(0) == barrier_value) {
-                    cores_synced.insert(core);
-                }
-                else {
-                    log_trace(LogSiliconDriver, "Waiting for core {} to recieve mem bar flag {} in function", core.str(), barrier_value);
-                }
-            }
-        }
+// Barrier flags go through the regular MMIO path, which uses the core's static TLB when it covers the flag and the fallback TLB otherwise.
+// Rectangles of Tensix cores are written with a single NOC multicast through the fallback TLB.
+class tt_SiliconDevice::membar_io : public tt_membar_io {
+   public:
+    membar_io(tt_SiliconDevice* device, chip_id_t chip, const std::string& fallback_tlb) : device(device), chip(chip), fallback_tlb(fallback_tlb), workers(device->workers_per_chip.at(chip)) {}
+
+    // Flag writes don't mark cores as dirty, or every barrier would leave its cores dirty.
+    void write_word(const tt_xy_pair& core, std::uint32_t address, std::uint32_t value) override {
+        device->write_device_memory(&value, sizeof(value), tt_cxy_pair(chip, core), address, fallback_tlb, false);
+    }
+    std::uint32_t read_word(const tt_xy_pair& core, std::uint32_t address) override {
+        std::uint32_t value = 0;
+        device->read_from_device(&value, tt_cxy_pair(chip, core), address, sizeof(value), fallback_tlb);
+        return value;
+    }
+    // Only Tensix cores are multicast to: NOC multicast only delivers to Tensix cores, ethernet and DRAM cores don't accept
+    // multicast writes. multicast_workaround also moves rectangles starting in column 0 (DRAM on WH) one column over.
+    bool can_multicast_to(const tt_xy_pair& core) const override {
+        return workers.find(core) != workers.end();
+    }
+    void multicast_write_word(const tt_xy_pair& start, const tt_xy_pair& end, std::uint32_t address, std::uint32_t value) override {
+        device->pcie_broadcast_write(chip, &value, sizeof(value), address, start, end, fallback_tlb, false);
     }
-    // Ensure that reads or writes after this do not get reordered.
+    // Ensure that all writes in the Host WC buffer are flushed
+    void flush_writes() override { tt_driver_atomics::sfence(); }
+    // Ensure that reads or writes after the barrier do not get reordered.
     // Reordering can cause races where data gets transferred before the barrier has returned
-    tt_driver_atomics::mfence(); 
+    void fence() override { tt_driver_atomics::mfence(); }
+
+   private:
+    tt_SiliconDevice* device;
+    chip_id_t chip;
+    const std::string& fallback_tlb;
+    const std::unordered_set<tt_xy_pair>& workers;
+};
+
+void tt_SiliconDevice::set_membar_flag(const chip_id_t chip, const std::unordered_set<tt_xy_pair>& cores, const uint32_t barrier_value, const uint32_t barrier_addr, const std::string& fallback_tlb) {
+    tt_driver_atomics::sfence(); // Ensure that writes before this do not get reordered
+    membar_io io = membar_io(this, chip, fallback_tlb);
+    tt_set_membar_flag(io, cores, barrier_addr, barrier_value);
 }
 
 void tt_SiliconDevice::insert_host_to_device_barrier(const chip_id_t chip, const std::unordered_set<tt_xy_pair>& cores, const uint32_t barrier_addr, const std::string& fallback_tlb) {
+    // SET/RESET would overwrite the flag of a split phase barrier, which then never completes
+    const auto in_flight = split_phase_membars_in_flight.find(chip);
+    log_assert(in_flight == split_phase_membars_in_flight.end() || *in_flight->second == 0, "Can't insert a blocking memory barrier on device {} while split phase barriers are in flight", chip);
     // Ensure that this memory barrier is atomic across processes/threads
     const scoped_lock<named_mutex> lock(*get_mutex(MEM_BARRIER_MUTEX_NAME, this->get_pci_device(chip)->id));
     set_membar_flag(chip, cores, tt_MemBarFlag::SET, barrier_addr, fallback_tlb);
@@ -4468,14 +4876,52 @@ void tt_SiliconDevice::insert_host_to_device_barrier(const chip_id_t chip, const
 }
 
 void tt_SiliconDevice::init_membars() {
+    std::vector<chip_id_t> mmio_chips = {};
     for(const auto& chip :  target_devices_in_cluster) {
         if (ndesc -> is_chip_mmio_capable(chip)) {
-            set_membar_flag(chip, workers_per_chip.at(chip), tt_MemBarFlag::RESET, l1_address_params.tensix_l1_barrier_base, "LARGE_WRITE_TLB");
-            set_membar_flag(chip, eth_cores, tt_MemBarFlag::RESET, l1_address_params.eth_l1_barrier_base, "LARGE_WRITE_TLB");
-            set_membar_flag(chip, dram_cores, tt_MemBarFlag::RESET, dram_address_params.DRAM_BARRIER_BASE, "LARGE_WRITE_TLB");
+            mmio_chips.push_back(chip);
+        }
+    }
+    // Barrier flags are reset through each device's own TLBs and mutexes, so devices are initialized concurrently.
+    tt_device_bringup bringup = tt_device_bringup(tt_device_bringup::get_default_max_threads(mmio_chips.size()),
+        [this] (chip_id_t logical_device_id) { tt::cpuset::tt_cpuset_allocator::bind_thread_to_cpuset(ndesc.get(), logical_device_id); },
+        [] () { tt::cpuset::tt_cpuset_allocator::unbind_thread_from_cpuset(); });
+    for (const auto& chip : mmio_chips) {
+        split_phase_membars_in_flight[chip] = std::make_shared<std::atomic<int>>(0);
+    }
+    bringup.run_per_device("init_membars", mmio_chips, [this] (chip_id_t chip) {
+        // Worker flags are multicast per rectangle. Ethernet and DRAM flags are written one core at a time, since those
+        // cores can't be multicast to (see membar_io::can_multicast_to).
+        set_membar_flag(chip, workers_per_chip.at(chip), tt_MemBarFlag::RESET, l1_address_params.tensix_l1_barrier_base, "LARGE_WRITE_TLB");
+        set_membar_flag(chip, eth_cores, tt_MemBarFlag::RESET, l1_address_params.eth_l1_barrier_base, "LARGE_WRITE_TLB");
+        set_membar_flag(chip, dram_cores, tt_MemBarFlag::RESET, dram_address_params.DRAM_BARRIER_BASE, "LARGE_WRITE_TLB");
+    });
+    const auto& timings = bringup.get_phase_timings();
+    bringup_phase_timings.insert(bringup_phase_timings.end(), timings.begin(), timings.end());
+}
+void tt_SiliconDevice::set_membar_dirty_tracking(bool enable) {
+    membar_dirty_cores.clear();
+    if (!enable) {
+        return;
+    }
+    for (const chip_id_t chip : target_devices_in_cluster) {
+        if (ndesc -> is_chip_mmio_capable(chip)) {
+            if (membar_dirty_cores.size() <= static_cast<std::size_t>(chip)) {
+                membar_dirty_cores.resize(chip + 1);
+            }
+            membar_dirty_cores[chip] = std::make_shared<tt_membar_dirty_cores>(get_soc_descriptor(chip).grid_size);
+            // Writes issued before tracking was enabled are unknown
+            membar_dirty_cores[chip]->mark_all();
+        }
+    }
+    const std::lock_guard<std::mutex> lock(static_tlb_writer_cores_mutex);
+    for (const auto& core : static_tlb_writer_cores) {
+        if (auto dirty_cores = get_membar_dirty_cores(core.chip)) {
+            dirty_cores->pin(core);
         }
     }
 }
+
 void tt_SiliconDevice::l1_membar(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores) {
     if (ndesc -> is_chip_mmio_capable(chip)) {
         const auto& all_workers = workers_per_chip.at(chip);
@@ -4494,8 +4940,21 @@ void tt_SiliconDevice::l1_membar(const chip_id_t chip, const std::string& fallba
                     log_fatal("Can only insert an L1 Memory barrier on Tensix or Ethernet cores.");
                 }
             }
+            if (auto dirty_cores = get_membar_dirty_cores(chip)) {
+                dirty_cores->clear(cores);
+            }
             insert_host_to_device_barrier(chip, workers_to_sync, l1_address_params.tensix_l1_barrier_base, fallback_tlb);
             insert_host_to_device_barrier(chip, eth_to_sync, l1_address_params.eth_l1_barrier_base, fallback_tlb);
+        } else if (auto dirty_cores = get_membar_dirty_cores(chip)) {
+            // Insert barrier on cores with L1 that were written since their last barrier
+            const auto workers_to_sync = dirty_cores->take(all_workers);
+            const auto eth_to_sync = dirty_cores->take(all_eth);
+            if (workers_to_sync.size()) {
+                insert_host_to_device_barrier(chip, workers_to_sync, l1_address_params.tensix_l1_barrier_base, fallback_tlb);
+            }
+            if (eth_to_sync.size()) {
+                insert_host_to_device_barrier(chip, eth_to_sync, l1_address_params.eth_l1_barrier_base, fallback_tlb);
+            }
         } else {
             // Insert barrier on all cores with L1
             insert_host_to_device_barrier(chip, all_workers, l1_address_params.tensix_l1_barrier_base, fallback_tlb);
@@ -4507,17 +4966,32 @@ void tt_SiliconDevice::l1_membar(const chip_id_t chip, const std::string& fallba
     }
 }
 
+void tt_SiliconDevice::insert_dram_barrier_on_all_cores(const chip_id_t chip, const std::string& fallback_tlb) {
+    if (auto dirty_cores = get_membar_dirty_cores(chip)) {
+        // Insert barrier on DRAM cores that were written since their last barrier
+        const auto cores_to_sync = dirty_cores->take(dram_cores);
+        if (cores_to_sync.size()) {
+            insert_host_to_device_barrier(chip, cores_to_sync, dram_address_params.DRAM_BARRIER_BASE, fallback_tlb);
+        }
+    } else {
+        // Insert Barrier on all DRAM Cores
+        insert_host_to_device_barrier(chip, dram_cores, dram_address_params.DRAM_BARRIER_BASE, fallback_tlb);
+    }
+}
+
 void tt_SiliconDevice::dram_membar(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores) {
     if (ndesc -> is_chip_mmio_capable(chip)) {
         if (cores.size()) {
             for(const auto& core : cores) {
                 log_assert(dram_cores.find(core) != dram_cores.end(), "Can only insert a DRAM Memory barrier on DRAM cores.");
             }
+            if (auto dirty_cores = get_membar_dirty_cores(chip)) {
+                dirty_cores->clear(cores);
+            }
             insert_host_to_device_barrier(chip, cores, dram_address_params.DRAM_BARRIER_BASE, fallback_tlb);
         }
         else {
-            // Insert Barrier on all DRAM Cores
-            insert_host_to_device_barrier(chip, dram_cores, dram_address_params.DRAM_BARRIER_BASE, fallback_tlb);
+            insert_dram_barrier_on_all_cores(chip, fallback_tlb);
         }
     }
     else {
@@ -4532,11 +5006,13 @@ void tt_SiliconDevice::dram_membar(const chip_id_t chip, const std::string& fall
             for(const auto& chan : channels) {
                 dram_cores_to_sync.insert(get_soc_descriptor(chip).get_core_for_dram_channel(chan, 0));
             }
+            if (auto dirty_cores = get_membar_dirty_cores(chip)) {
+                dirty_cores->clear(dram_cores_to_sync);
+            }
             insert_host_to_device_barrier(chip, dram_cores_to_sync, dram_address_params.DRAM_BARRIER_BASE, fallback_tlb);
         }
         else {
-            // Insert Barrier on all DRAM Cores
-            insert_host_to_device_barrier(chip, dram_cores, dram_address_params.DRAM_BARRIER_BASE, fallback_tlb);
+            insert_dram_barrier_on_all_cores(chip, fallback_tlb);
         }
     }
     else {
@@ -4544,6 +5020,87 @@ void tt_SiliconDevice::dram_membar(const chip_id_t chip, const std::string& fall
     }
 }
 
+tt_membar_token tt_SiliconDevice::begin_membar(const chip_id_t chip, const std::string& fallback_tlb, const std::unordered_set<tt_xy_pair>& cores, int timeout) {
+    tt_membar_token token = {};
+    token.chip = chip;
+    token.fallback_tlb = fallback_tlb;
+    token.timeout = timeout;
+    if (!ndesc -> is_chip_mmio_capable(chip)) {
+        token.remote = true;
+        return token;
+    }
+
+    const auto& all_workers = workers_per_chip.at(chip);
+    const std::unordered_set<tt_xy_pair>* cores_per_type[] = {&all_workers, &eth_cores, &dram_cores};
+    std::unordered_set<tt_xy_pair> cores_to_sync = {};
+    if (cores.size()) {
+        cores_to_sync = cores;
+        if (auto dirty_cores = get_membar_dirty_cores(chip)) {
+            dirty_cores->clear(cores);
+        }
+    } else if (auto dirty_cores = get_membar_dirty_cores(chip)) {
+        for (const auto* all_cores : cores_per_type) {
+            const auto dirty = dirty_cores->take(*all_cores);
+            cores_to_sync.insert(dirty.begin(), dirty.end());
+        }
+    } else {
+        for (const auto* all_cores : cores_per_type) {
+            cores_to_sync.insert(all_cores->begin(), all_cores->end());
+        }
+    }
+
+    for (const auto& core : cores_to_sync) {
+        if (all_workers.find(core) != all_workers.end()) {
+            token.targets.push_back({core, l1_address_params.tensix_l1_barrier_base});
+        } else if (eth_cores.find(core) != eth_cores.end()) {
+            token.targets.push_back({core, l1_address_params.eth_l1_barrier_base});
+        } else if (dram_cores.find(core) != dram_cores.end()) {
+            token.targets.push_back({core, dram_address_params.DRAM_BARRIER_BASE});
+        } else {
+            log_fatal("Can only insert a Memory barrier on Tensix, Ethernet or DRAM cores.");
+        }
+    }
+
+    // Counted until the token completes, times out or is dropped. The cores' dirty bits were cleared above, so unless
+    // the barrier completes they are marked again for the next one. Also covers tt_begin_membar throwing.
+    std::shared_ptr<std::atomic<int>> in_flight = split_phase_membars_in_flight.at(chip);
+    std::shared_ptr<tt_membar_dirty_cores> dirty_cores = static_cast<std::size_t>(chip) < membar_dirty_cores.size() ? membar_dirty_cores[chip] : nullptr;
+    (*in_flight)++;
+    token.in_flight = std::shared_ptr<tt_membar_in_flight>(new tt_membar_in_flight(), [in_flight, dirty_cores, cores_to_sync] (tt_membar_in_flight* state) {
+        if (dirty_cores && !state->completed) {
+            for (const auto& core : cores_to_sync) {
+                dirty_cores->mark(core);
+            }
+        }
+        (*in_flight)--;
+        delete state;
+    });
+
+    token.sequence = membar_sequence.next();
+    tt_driver_atomics::sfence(); // Ensure that writes before this do not get reordered
+    membar_io io = membar_io(this, chip, token.fallback_tlb);
+    // Flags are never posted between the SET and RESET of another process's blocking barrier
+    const scoped_lock<named_mutex> lock(*get_mutex(MEM_BARRIER_MUTEX_NAME, this->get_pci_device(chip)->id));
+    tt_begin_membar(io, token);
+    return token;
+}
+
+bool tt_SiliconDevice::test_membar(tt_membar_token& token) {
+    if (token.remote) {
+        wait_for_non_mmio_flush();
+        return true;
+    }
+    membar_io io = membar_io(this, token.chip, token.fallback_tlb);
+    return tt_test_membar(io, token, membar_sequence);
+}
+
+void tt_SiliconDevice::wait_membar(tt_membar_token& token) {
+    tt_arc_msg_backoff backoff = {};
+    while (!test_membar(token)) {
+        backoff.wait();
+    }
+}
+
 void tt_SiliconDevice::write_to_device(const void *mem_ptr, uint32_t size, tt_cxy_pair core, uint64_t addr, const std::string& fallback_tlb, bool send_epoch_cmd, bool last_send_epoch_cmd, bool ordered_with_prev_remote_write) {
     bool target_is_mmio_capable = ndesc -> is_chip_mmio_capable(core.chip);
     if(target_is_mmio_capable) {
@@ -4587,15 +5144,33 @@ void tt_SiliconDevice::write_epoch_cmd_to_device(std::vector<uint32_t> &vec, tt_
     write_epoch_cmd_to_device(vec.data(), vec.size() * sizeof(uint32_t), core, addr, fallback_tlb, last_send_epoch_cmd, ordered_with_prev_remote_write);
 }
 
+void tt_SiliconDevice::stage_rolled_write(const uint32_t* mem_ptr, uint32_t size_in_bytes, uint32_t unroll_count, std::vector<uint32_t>& staging) {
+    const uint32_t words_per_slot = size_in_bytes / sizeof(uint32_t);
+    staging.resize(words_per_slot * unroll_count);
+    for (uint32_t i = 0; i < unroll_count; i++) {
+        uint32_t* slot = staging.data() + i * words_per_slot;
+        memcpy(slot, mem_ptr, words_per_slot * sizeof(uint32_t));
+        if (words_per_slot) {
+            slot[0] = i; // slot id for debug
+        }
+    }
+}
+
+std::vector<uint32_t>& tt_SiliconDevice::get_rolled_write_staging() {
+    // Per thread, so concurrent rolled writes don't serialize on a shared buffer.
+    thread_local std::vector<uint32_t> staging = {};
+    return staging;
+}
+
 void tt_SiliconDevice::rolled_write_to_device(uint32_t* mem_ptr, uint32_t size_in_bytes, uint32_t unroll_count, tt_cxy_pair core, uint64_t addr, const std::string& fallback_tlb) {
     log_assert(!(size_in_bytes % 4), "{} only supports 4-byte aligned data", __FUNCTION__);
     bool target_is_mmio_capable = ndesc->is_chip_mmio_capable(core.chip);
 
     if (target_is_mmio_capable) {
-        for (int i=0; i<unroll_count; i++) {
-            *mem_ptr = i; // slot id for debug
-            write_device_memory(mem_ptr, size_in_bytes, core, addr + i * size_in_bytes, fallback_tlb);
-        }
+        // All slots are contiguous on device, so they are written with a single TLB mapping and lock.
+        std::vector<uint32_t>& staging = get_rolled_write_staging();
+        stage_rolled_write(mem_ptr, size_in_bytes, unroll_count, staging);
+        write_device_memory(staging.data(), staging.size() * sizeof(uint32_t), core, addr, fallback_tlb);
     }
     else {
         log_assert(arch_name != tt::ARCH::BLACKHOLE, "Non-MMIO targets not supported in Blackhole");    // MT: Use only dynamic TLBs and never program static
@@ -4616,7 +5191,7 @@ void tt_SiliconDevice::read_mmio_device_register(void* mem_ptr, tt_cxy_pair core
     const scoped_lock<named_mutex> lock(*get_mutex(fallback_tlb, pci_device -> id));
     LOG1 ("  dynamic tlb_index: %d\n", tlb_index);
 
-    auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, core, addr, harvested_coord_translation, TLB_DATA::Strict);
+    auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, core, addr, harvested_coord_translation.at(pci_device -> logical_id), TLB_DATA::Strict);
     // Align block to 4bytes if needed. 
     auto aligned_buf = tt_4_byte_aligned_buffer(mem_ptr, size);
     read_regs(dev, mapped_address, aligned_buf.block_size / sizeof(std::uint32_t), aligned_buf.local_storage);
@@ -4636,7 +5211,7 @@ void tt_SiliconDevice::write_mmio_device_register(const void* mem_ptr, tt_cxy_pa
     const scoped_lock<named_mutex> lock(*get_mutex(fallback_tlb, pci_device -> id));
     LOG1 ("  dynamic tlb_index: %d\n", tlb_index);
 
-    auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, core, addr, harvested_coord_translation, TLB_DATA::Strict);
+    auto [mapped_address, tlb_size] = set_dynamic_tlb(pci_device, tlb_index, core, addr, harvested_coord_translation.at(pci_device -> logical_id), TLB_DATA::Strict);
     // Align block to 4bytes if needed. 
     auto aligned_buf = tt_4_byte_aligned_buffer(mem_ptr, size);
     if(aligned_buf.input_size != aligned_buf.block_size) {
@@ -4669,33 +5244,15 @@ void tt_SiliconDevice::read_from_device(std::vector<uint32_t> &vec, tt_cxy_pair
 
 
 int tt_SiliconDevice::arc_msg(int logical_device_id, uint32_t msg_code, bool wait_for_done, uint32_t arg0, uint32_t arg1, int timeout, uint32_t *return_3, uint32_t *return_4) {
-    log_assert(arch_name != tt::ARCH::BLACKHOLE, "ARC messages not supported in Blackhole");
-    if(ndesc -> is_chip_mmio_capable(logical_device_id)) {
-        return pcie_arc_msg(logical_device_id, msg_code, wait_for_done, arg0, arg1, timeout, return_3, return_4);
-    }
-    else {
-        return remote_arc_msg(logical_device_id, msg_code, wait_for_done, arg0, arg1, timeout, return_3, return_4);
-    }
-}
-
-void tt_SiliconDevice::send_tensix_risc_reset_to_core(const tt_cxy_pair &core, const TensixSoftResetOptions &soft_resets) {
-    auto valid = soft_resets & ALL_TENSIX_SOFT_RESET;
-    uint32_t valid_val = (std::underlying_type<TensixSoftResetOptions>::type) valid;
-    write_to_device(&valid_val, sizeof(uint32_t), core, 0xFFB121B0, "REG_TLB");
-    tt_driver_atomics::sfence();
-}
-
-void tt_SiliconDevice::send_remote_tensix_risc_reset_to_core(const tt_cxy_pair &core, const TensixSoftResetOptions &soft_resets) {
-    auto valid = soft_resets & ALL_TENSIX_SOFT_RESET;
-    uint32_t valid_val = (std::underlying_type<TensixSoftResetOptions>::type) valid;
-    write_to_non_mmio_device(&valid_val, sizeof(uint32_t), core, 0xFFB121B0);
-    tt_driver_atomics::sfence();
+    return send_arc_msg(logical_device_id, msg_code, wait_for_done, arg0, arg1, timeout, return_3, return_4);
 }
 
 int tt_SiliconDevice::set_remote_power_state(const chip_id_t &chip, tt_DevicePowerState device_state) {
     auto mmio_capable_chip_logical = ndesc->get_closest_mmio_capable_chip(chip);
     struct PCIdevice* pci_device = get_pci_device(mmio_capable_chip_logical);
-    return remote_arc_msg(chip, get_power_state_arc_msg(pci_device, device_state), true, 0, 0, 1, NULL, NULL);
+    int exit_code = send_arc_msg(chip, get_power_state_arc_msg(pci_device, device_state), true, 0, 0, 1, NULL, NULL);
+    telemetry_cache.invalidate(chip);
+    return exit_code;
 }
 
 
@@ -4707,7 +5264,7 @@ void tt_SiliconDevice::enable_remote_ethernet_queue(const chip_id_t& chip, int t
         if (std::chrono::system_clock::now() - start > timeout_seconds) {
             throw std::runtime_error("Timed out after waiting " + std::to_string(timeout) + " seconds for DRAM to finish training");
         }
-        int msg_rt = remote_arc_msg(chip, 0xaa58, true, 0xFFFF, 0xFFFF, 1, &msg_success, NULL);
+        int msg_rt = send_arc_msg(chip, 0xaa58, true, 0xFFFF, 0xFFFF, 1, &msg_success, NULL);
         if (msg_rt == MSG_ERROR_REPLY) {
             break;
         }
@@ -4744,10 +5301,10 @@ void tt_SiliconDevice::broadcast_tensix_risc_reset_to_cluster(const TensixSoftRe
 void tt_SiliconDevice::set_power_state(tt_DevicePowerState device_state) {
     // MT Initial BH - ARC messages not supported in Blackhole
     if (arch_name != tt::ARCH::BLACKHOLE) {
+        // set_pcie_power_state covers all MMIO chips at once.
+        set_pcie_power_state(device_state);
         for(auto& chip : target_devices_in_cluster) {
-            if(ndesc -> is_chip_mmio_capable(chip)) {
-                set_pcie_power_state(device_state);
-            } else {
+            if(!ndesc -> is_chip_mmio_capable(chip)) {
                 int exit_code = set_remote_power_state(chip, device_state);
                 log_assert(exit_code == 0, "Failed to set power state to {} with exit code: {}", (int)device_state, exit_code);
             }
@@ -4791,15 +5348,19 @@ void tt_SiliconDevice::deassert_resets_and_set_power_state() {
     // MT Initial BH - ARC messages not supported in Blackhole
     if (arch_name != tt::ARCH::BLACKHOLE) {
         // Send ARC Messages to deassert RISCV resets
+        std::vector<tt_arc_msg_token> tokens = {};
         for (auto &device_it : m_pci_device_map){
-            arc_msg(device_it.first, 0xaa00 | device_it.second->hdev->get_architecture_implementation()->get_arc_message_deassert_riscv_reset(), true, 0, 0);
+            tokens.push_back(post_arc_msg(device_it.first, 0xaa00 | device_it.second->hdev->get_architecture_implementation()->get_arc_message_deassert_riscv_reset(), 0, 0));
+        }
+        for (auto& token : tokens) {
+            wait_arc_msg(token);
         }
         if(ndesc != nullptr) {
             for(const chip_id_t& chip : target_devices_in_cluster) {
                 if(!ndesc -> is_chip_mmio_capable(chip)) {
                     auto mmio_capable_chip_logical = ndesc->get_closest_mmio_capable_chip(chip);
                     struct PCIdevice* pci_device = get_pci_device(mmio_capable_chip_logical);
-                    remote_arc_msg(chip, 0xaa00 | pci_device->hdev->get_architecture_implementation()->get_arc_message_deassert_riscv_reset(), true, 0x0, 0x0, 1, NULL, NULL);
+                    send_arc_msg(chip, 0xaa00 | pci_device->hdev->get_architecture_implementation()->get_arc_message_deassert_riscv_reset(), true, 0x0, 0x0, 1, NULL, NULL);
                 }
             }
             enable_ethernet_queue(30);
@@ -4813,7 +5374,7 @@ void tt_SiliconDevice::verify_eth_fw() {
     for(const auto& chip : target_devices_in_cluster) {
         std::vector<uint32_t> mem_vector;
         std::vector<uint32_t> fw_versions;
-        for (tt_xy_pair &eth_core : get_soc_descriptor(chip).ethernet_cores) {
+        for (const tt_xy_pair &eth_core : get_soc_descriptor(chip).ethernet_cores) {
             read_from_device(mem_vector, tt_cxy_pair(chip, eth_core), l1_address_params.fw_version_addr, sizeof(uint32_t), "LARGE_READ_TLB");
             fw_versions.push_back(mem_vector.at(0));
         }
@@ -4880,7 +5441,17 @@ void tt_SiliconDevice::set_driver_eth_interface_params(const tt_driver_eth_inter
 }
 
 void tt_SiliconDevice::setup_core_to_tlb_map(std::function<std::int32_t(tt_xy_pair)> mapping_function) {
-    map_core_to_tlb = mapping_function;
+    // Resolve the static TLB of every core up front, so that accesses don't have to call the mapping function.
+    static_tlb_tables.clear();
+    for(const auto& [logical_device_id, pci_device] : m_pci_device_map) {
+        if(static_tlb_tables.size() <= static_cast<std::size_t>(logical_device_id)) {
+            static_tlb_tables.resize(logical_device_id + 1);
+        }
+        const auto configured_tlbs = tlb_config_map.find(logical_device_id);
+        static_tlb_tables[logical_device_id] = tt_static_tlb_table::create(
+            pci_device->hdev->get_architecture_implementation(), mapping_function,
+            configured_tlbs == tlb_config_map.end() ? std::unordered_map<std::int32_t, std::uint64_t>{} : configured_tlbs->second);
+    }
     tlbs_init = true;
 }
 
@@ -4905,6 +5476,48 @@ std::uint32_t tt_SiliconDevice::get_host_channel_size(std::uint32_t device_id, s
     return host_channel_size.at(device_id).at(channel);
 }
 
+tt_sysmem_ring tt_SiliconDevice::create_sysmem_ring(chip_id_t mmio_chip, uint16_t channel, std::uint64_t offset, std::uint64_t size, bool initialize) {
+    log_assert(offset + size <= get_host_channel_size(mmio_chip, channel), "Sysmem ring at offset {} of size {} does not fit in host channel {}", offset, size, channel);
+    void* region = host_dma_address(offset, mmio_chip, channel);
+    log_assert(region != nullptr, "Host channel {} of device {} is not mapped", channel, mmio_chip);
+    return tt_sysmem_ring(region, size, initialize);
+}
+
+// Address of the start of a host memory channel in the device's PCIe window. Matches the regions set up by
+// iatu_configure_peer_region: channel 3 is a smaller region, placed at index 4 so it still starts at 3GB.
+static std::uint64_t get_host_channel_device_offset(std::uint16_t channel) {
+    if (channel == 3) {
+        return 4 * std::uint64_t(805306368);
+    }
+    return channel * std::uint64_t(HUGEPAGE_REGION_SIZE);
+}
+
+tt_sysmem_allocator& tt_SiliconDevice::get_sysmem_allocator(chip_id_t mmio_chip) {
+    const std::lock_guard<std::mutex> lock(sysmem_allocators_mutex);
+    auto allocator = sysmem_allocators.find(mmio_chip);
+    if (allocator == sysmem_allocators.end()) {
+        log_assert(ndesc->is_chip_mmio_capable(mmio_chip), "Sysmem can only be allocated for MMIO chips, {} is a remote chip", mmio_chip);
+        allocator = sysmem_allocators.insert({mmio_chip, std::make_unique<tt_sysmem_allocator>()}).first;
+        for (std::uint16_t channel = 0; channel < get_num_host_channels(mmio_chip); channel++) {
+            const std::uint64_t arena_size = get_sysmem_arena_size(channel, get_host_channel_size(mmio_chip, channel), host_address_params);
+            if (arena_size == 0) {
+                continue;
+            }
+            allocator->second->add_channel(channel, host_dma_address(0, mmio_chip, channel), arena_size,
+                                           get_pcie_base_addr_from_device() + get_host_channel_device_offset(channel));
+        }
+    }
+    return *allocator->second;
+}
+
+std::uint64_t tt_SiliconDevice::get_sysmem_arena_size(std::uint16_t channel, std::uint64_t channel_size, const tt_driver_host_address_params& host_address_params) {
+    if (channel != 0) {
+        return channel_size;
+    }
+    // The ethernet routing buffers and the perf scratch live in DEVICE_TO_HOST_SCRATCH at the end of channel 0.
+    return std::min<std::uint64_t>(channel_size, host_address_params.eth_routing_buffers_start);
+}
+
 std::uint32_t tt_SiliconDevice::get_pcie_speed(std::uint32_t device_id) {
     int link_width = 0;
     int link_speed = 0;
@@ -310,3 +310,18 @@ std::ostream &operator<<(std::ostream &out, const tt::ARCH &arch_name) {
 
     return out;
 }
+
+std::size_t tt_soc_descriptor_map::num_unique_descriptors() const {
+    std::unordered_set<const tt_SocDescriptor*> unique_descriptors = {};
+    for (const auto& [chip, soc_descriptor] : descriptors) {
+        unique_descriptors.insert(soc_descriptor.get());
+    }
+    return unique_descriptors.size();
+}
+
+void tt_soc_descriptor_map::insert(chip_id_t chip, std::shared_ptr<const tt_SocDescriptor> soc_descriptor) {
+    if (soc_descriptor == nullptr) {
+        throw std::runtime_error("Cannot insert a null SOC descriptor for chip " + std::to_string(chip));
+    }
+    descriptors[chip] = std::move(soc_descriptor);
+}
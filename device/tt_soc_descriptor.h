@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <string>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -18,6 +19,7 @@
 
 #include "tt_xy_pair.h"
 #include "device/tt_arch_types.h"
+#include "device/tt_cluster_descriptor_types.h"
 
 namespace YAML {
     class Node;
@@ -184,5 +186,35 @@ class tt_SocDescriptor {
     void load_soc_features_from_device_descriptor(YAML::Node &device_descriptor_yaml);
 };
 
+//! tt_soc_descriptor_map holds the SOC descriptor of each chip in a cluster.
+/*!
+    Descriptors are immutable and shared: chips with the same layout (arch and harvesting mask) point to the same
+    tt_SocDescriptor, so copying the map or adding chips with a known layout doesn't copy any descriptor.
+*/
+class tt_soc_descriptor_map {
+    public:
+    using container = std::unordered_map<chip_id_t, std::shared_ptr<const tt_SocDescriptor>>;
+    using const_iterator = container::const_iterator;
+
+    const tt_SocDescriptor& at(chip_id_t chip) const { return *descriptors.at(chip); }
+    const std::shared_ptr<const tt_SocDescriptor>& get_shared(chip_id_t chip) const { return descriptors.at(chip); }
+    std::size_t count(chip_id_t chip) const { return descriptors.count(chip); }
+    std::size_t size() const { return descriptors.size(); }
+    bool empty() const { return descriptors.empty(); }
+    const_iterator begin() const { return descriptors.begin(); }
+    const_iterator end() const { return descriptors.end(); }
+    const_iterator find(chip_id_t chip) const { return descriptors.find(chip); }
+
+    // Number of distinct descriptor objects backing this map
+    std::size_t num_unique_descriptors() const;
+
+    void insert(chip_id_t chip, std::shared_ptr<const tt_SocDescriptor> soc_descriptor);
+    void emplace(chip_id_t chip, tt_SocDescriptor soc_descriptor) { insert(chip, std::make_shared<const tt_SocDescriptor>(std::move(soc_descriptor))); }
+    void clear() { descriptors.clear(); }
+
+    private:
+    container descriptors = {};
+};
+
 // Allocates a new soc descriptor on the heap. Returns an owning pointer.
 // std::unique_ptr<tt_SocDescriptor> load_soc_descriptor_from_yaml(std::string device_descriptor_file_path);
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_sysmem_allocator.h"
+
+#include <algorithm>
+
+#include "common/logger.hpp"
+
+void tt_sysmem_allocator::add_channel(std::uint16_t channel, void* host_base, std::uint64_t size, std::uint64_t device_base) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    log_assert(host_base != nullptr && size > 0, "Host memory channel {} is not mapped", channel);
+    for (const auto& arena : arenas) {
+        log_assert(arena.channel != channel, "Host memory channel {} was already added to the allocator", channel);
+    }
+    arenas.push_back({channel, static_cast<std::uint8_t*>(host_base), size, device_base, {{0, size}}, {}});
+}
+
+tt_sysmem_allocation tt_sysmem_allocator::allocate(std::uint64_t size, std::uint64_t align) {
+    log_assert(size > 0, "Cannot allocate an empty sysmem buffer");
+    log_assert(align > 0 && (align & (align - 1)) == 0, "Sysmem alignment {} is not a power of two", align);
+    const std::lock_guard<std::mutex> lock(mutex);
+    for (auto& arena : arenas) {
+        for (auto block = arena.free_blocks.begin(); block != arena.free_blocks.end(); block++) {
+            const auto [block_offset, block_size] = *block;
+            // Both address spaces must be aligned. Channels are hugepage aligned, so aligning one aligns both.
+            const std::uint64_t offset = (block_offset + align - 1) & ~(align - 1);
+            if (offset - block_offset + size > block_size) {
+                continue;
+            }
+            arena.free_blocks.erase(block);
+            if (offset > block_offset) {
+                arena.free_blocks.insert({block_offset, offset - block_offset});
+            }
+            if (offset + size < block_offset + block_size) {
+                arena.free_blocks.insert({offset + size, block_offset + block_size - offset - size});
+            }
+            arena.allocations.insert({offset, size});
+            return {arena.host_base + offset, arena.device_base + offset, arena.channel, offset, size};
+        }
+    }
+    return {};
+}
+
+void tt_sysmem_allocator::free(const tt_sysmem_allocation& allocation) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto arena = std::find_if(arenas.begin(), arenas.end(), [&] (const channel_arena& arena) { return arena.channel == allocation.channel; });
+    log_assert(arena != arenas.end(), "Freeing sysmem buffer from unknown channel {}", allocation.channel);
+    auto allocated = arena->allocations.find(allocation.offset);
+    log_assert(allocated != arena->allocations.end() && allocated->second == allocation.size,
+               "Freeing sysmem buffer at offset {} of channel {} that was not allocated", allocation.offset, allocation.channel);
+    arena->allocations.erase(allocated);
+
+    // Merge with the free blocks on either side
+    std::uint64_t offset = allocation.offset;
+    std::uint64_t size = allocation.size;
+    auto next = arena->free_blocks.lower_bound(offset);
+    if (next != arena->free_blocks.end() && offset + size == next->first) {
+        size += next->second;
+        next = arena->free_blocks.erase(next);
+    }
+    if (next != arena->free_blocks.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            arena->free_blocks.erase(prev);
+        }
+    }
+    arena->free_blocks.insert({offset, size});
+}
+
+void tt_sysmem_allocator::add_stats(const channel_arena& arena, tt_sysmem_allocator_stats& stats) {
+    stats.total_bytes += arena.size;
+    for (const auto& block : arena.free_blocks) {
+        stats.free_bytes += block.second;
+        stats.largest_free_block = std::max(stats.largest_free_block, block.second);
+    }
+    stats.allocated_bytes = stats.total_bytes - stats.free_bytes;
+    stats.num_free_blocks += arena.free_blocks.size();
+    stats.num_allocations += arena.allocations.size();
+}
+
+tt_sysmem_allocator_stats tt_sysmem_allocator::get_stats() const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    tt_sysmem_allocator_stats stats = {};
+    for (const auto& arena : arenas) {
+        add_stats(arena, stats);
+    }
+    return stats;
+}
+
+tt_sysmem_allocator_stats tt_sysmem_allocator::get_stats(std::uint16_t channel) const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    tt_sysmem_allocator_stats stats = {};
+    for (const auto& arena : arenas) {
+        if (arena.channel == channel) {
+            add_stats(arena, stats);
+        }
+    }
+    return stats;
+}
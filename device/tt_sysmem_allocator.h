@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+//! Buffer handed out by tt_sysmem_allocator.
+struct tt_sysmem_allocation {
+    void* host_ptr = nullptr;
+    // Address devices use to reach the buffer over PCIe
+    std::uint64_t device_address = 0;
+    std::uint16_t channel = 0;
+    // Offset of the buffer in its channel
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+
+    bool is_valid() const { return host_ptr != nullptr; }
+};
+
+struct tt_sysmem_allocator_stats {
+    std::uint64_t total_bytes = 0;
+    std::uint64_t allocated_bytes = 0;
+    std::uint64_t free_bytes = 0;
+    std::uint64_t largest_free_block = 0;
+    std::uint32_t num_free_blocks = 0;
+    std::uint32_t num_allocations = 0;
+
+    /**
+     * @brief Share of the free bytes that can't be handed out as one block (0 when all free space is contiguous).
+     */
+    double get_fragmentation() const { return free_bytes ? 1.0 - double(largest_free_block) / free_bytes : 0.0; }
+};
+
+//! Sub-allocates the host memory channels of one MMIO device.
+/*!
+    Each channel is an arena with a first fit free list, ordered by offset so freed blocks are merged with their
+    neighbours. Channels are tried in the order they were added. Allocations carry both the host pointer and the address
+    devices use to reach the buffer, so components sharing sysmem don't need to know the channel layout or iATU setup.
+    All methods are thread safe.
+*/
+class tt_sysmem_allocator {
+    public:
+    /**
+     * @brief Hand a channel to the allocator.
+     * \param host_base Host mapping of the channel (a hugepage or any other memory, ex: an anonymous mapping in tests)
+     * \param device_base Address of the start of the channel, as seen by the device
+     */
+    void add_channel(std::uint16_t channel, void* host_base, std::uint64_t size, std::uint64_t device_base);
+
+    /**
+     * @brief Allocate size bytes aligned to align (a power of two) in the host and device address spaces.
+     * \returns An invalid allocation if no channel has a large enough free block.
+     */
+    tt_sysmem_allocation allocate(std::uint64_t size, std::uint64_t align = 64);
+    void free(const tt_sysmem_allocation& allocation);
+
+    tt_sysmem_allocator_stats get_stats() const;
+    tt_sysmem_allocator_stats get_stats(std::uint16_t channel) const;
+
+    private:
+    struct channel_arena {
+        std::uint16_t channel;
+        std::uint8_t* host_base;
+        std::uint64_t size;
+        std::uint64_t device_base;
+        // offset -> size of free blocks, and of allocated blocks
+        std::map<std::uint64_t, std::uint64_t> free_blocks;
+        std::map<std::uint64_t, std::uint64_t> allocations;
+    };
+
+    static void add_stats(const channel_arena& arena, tt_sysmem_allocator_stats& stats);
+
+    mutable std::mutex mutex;
+    std::vector<channel_arena> arenas = {};
+};
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_sysmem_map.h"
+
+#include "common/logger.hpp"
+
+void tt_sysmem_map::add_channel(chip_id_t device, std::uint16_t channel, void* base, std::uint64_t size) {
+    log_assert(device >= 0, "Invalid device {} for host memory channel", device);
+    log_assert(channel < MAX_CHANNELS, "Invalid host memory channel {}", channel);
+    log_assert(base != nullptr && size > 0, "Host memory channel {} of device {} is not mapped", channel, device);
+    add_device(device);
+    auto& mapping = channels[device][channel];
+    log_assert(mapping.base == nullptr, "Host memory channel {} of device {} was already mapped", channel, device);
+    mapping = {static_cast<std::uint8_t*>(base), size};
+}
+
+void tt_sysmem_map::add_device(chip_id_t device) {
+    if (channels.size() <= static_cast<std::size_t>(device)) {
+        channels.resize(device + 1);
+    }
+}
+
+bool tt_sysmem_map::is_mapped(chip_id_t device, std::uint16_t channel) const {
+    return device >= 0 && static_cast<std::size_t>(device) < channels.size() && channel < MAX_CHANNELS && channels[device][channel].base != nullptr;
+}
+
+std::uint64_t tt_sysmem_map::get_channel_size(chip_id_t device, std::uint16_t channel) const {
+    return is_mapped(device, channel) ? channels[device][channel].size : 0;
+}
+
+tt_sysmem_span tt_sysmem_map::map(chip_id_t device, std::uint16_t channel, std::uint64_t offset, std::uint32_t size) const {
+    log_assert(is_mapped(device, channel), "Host memory channel {} of device {} is not mapped", channel, device);
+    const auto& mapping = channels[device][channel];
+    log_assert(offset <= mapping.size && size <= mapping.size - offset,
+        "Sysmem access of {} bytes at offset {} is out of bounds of host memory channel {} ({} bytes) of device {}", size, offset, channel, mapping.size, device);
+    return {mapping.base + offset, size};
+}
@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "device/tt_cluster_descriptor_types.h"
+#include "device/tt_sysmem_ring.h"
+
+//! Host mappings of the host memory channels of every MMIO device, in a flat [device][channel] table.
+/*!
+    Lookups index the table directly (no hashing), and hand out views into the mapping, so callers can read or write
+    sysmem in place instead of copying through a staging buffer. A view is bounds checked once, when it is created.
+*/
+class tt_sysmem_map {
+    public:
+    static constexpr std::size_t MAX_CHANNELS = 4;
+
+    /**
+     * @brief Register the host mapping of a channel. A channel can only be added once.
+     * \param base Host mapping of the channel (a hugepage, the DMA buffer stand-in, or any memory in tests)
+     */
+    void add_channel(chip_id_t device, std::uint16_t channel, void* base, std::uint64_t size);
+    /**
+     * @brief Make room for the channels of a device. Once all devices are added, channels can be added concurrently
+     * with lookups of other channels.
+     */
+    void add_device(chip_id_t device);
+    bool is_mapped(chip_id_t device, std::uint16_t channel) const;
+    std::uint64_t get_channel_size(chip_id_t device, std::uint16_t channel) const;
+
+    /**
+     * @brief View of size bytes at offset in a channel. Asserts that the channel is mapped and the range is inside it.
+     */
+    tt_sysmem_span map(chip_id_t device, std::uint16_t channel, std::uint64_t offset, std::uint32_t size) const;
+
+    private:
+    struct channel_mapping {
+        std::uint8_t* base = nullptr;
+        std::uint64_t size = 0;
+    };
+
+    // Indexed by logical device id, then channel
+    std::vector<std::array<channel_mapping, MAX_CHANNELS>> channels = {};
+};
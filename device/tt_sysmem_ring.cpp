@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_sysmem_ring.h"
+
+#include <algorithm>
+
+#include "common/logger.hpp"
+
+tt_sysmem_ring::tt_sysmem_ring(void* region, std::uint64_t region_size, bool initialize) {
+    log_assert(reinterpret_cast<std::uintptr_t>(region) % CACHE_LINE_SIZE == 0, "Sysmem ring must be {} byte aligned", CACHE_LINE_SIZE);
+    log_assert(region_size > DATA_OFFSET, "Sysmem ring region of {} bytes is too small", region_size);
+    const std::uint64_t max_capacity = std::min<std::uint64_t>(region_size - DATA_OFFSET, std::uint64_t(1) << 31);
+    capacity = 1;
+    while (std::uint64_t(capacity) * 2 <= max_capacity) {
+        capacity *= 2;
+    }
+
+    std::uint8_t* base = static_cast<std::uint8_t*>(region);
+    head = reinterpret_cast<std::uint32_t*>(base + HEAD_OFFSET);
+    tail = reinterpret_cast<std::uint32_t*>(base + TAIL_OFFSET);
+    data = base + DATA_OFFSET;
+    if (initialize) {
+        store_counter(head, 0);
+        store_counter(tail, 0);
+    }
+    cached_head = load_counter(head);
+    cached_tail = load_counter(tail);
+}
+
+tt_sysmem_span tt_sysmem_ring::reserve(std::uint32_t max_size) {
+    const std::uint32_t current_head = *head; // Only written by this side
+    if (capacity - (current_head - cached_tail) < max_size) {
+        cached_tail = load_counter(tail);
+    }
+    const std::uint32_t offset = current_head & (capacity - 1);
+    const std::uint32_t free_space = capacity - (current_head - cached_tail);
+    return {data + offset, std::min({max_size, free_space, capacity - offset})};
+}
+
+void tt_sysmem_ring::commit(std::uint32_t size) {
+    const std::uint32_t current_head = *head;
+    log_assert(current_head - cached_tail + size <= capacity, "Committing {} bytes overflows the sysmem ring", size);
+    store_counter(head, current_head + size);
+}
+
+tt_sysmem_span tt_sysmem_ring::peek() {
+    const std::uint32_t current_tail = *tail; // Only written by this side
+    const std::uint32_t offset = current_tail & (capacity - 1);
+    if (cached_head - current_tail < capacity - offset) {
+        // The producer may have committed more data since it was last checked.
+        cached_head = load_counter(head);
+    }
+    return {data + offset, std::min(cached_head - current_tail, capacity - offset)};
+}
+
+void tt_sysmem_ring::release(std::uint32_t size) {
+    const std::uint32_t current_tail = *tail;
+    log_assert(size <= cached_head - current_tail, "Releasing {} bytes, more than the sysmem ring holds", size);
+    store_counter(tail, current_tail + size);
+}
+
+std::uint32_t tt_sysmem_ring::get_size() const {
+    return load_counter(head) - load_counter(tail);
+}
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+//! Contiguous range of bytes inside a host memory channel (ex: a tt_sysmem_ring). Empty when size is 0.
+struct tt_sysmem_span {
+    std::uint8_t* data = nullptr;
+    std::uint32_t size = 0;
+};
+
+//! Single producer, single consumer byte ring placed in a host memory (hugepage) channel region.
+/*!
+    The region starts with two counters, each on its own cache line so the producer and consumer never write the same
+    line, followed by the data:
+        HEAD_OFFSET: bytes committed by the producer so far
+        TAIL_OFFSET: bytes released by the consumer so far
+        DATA_OFFSET: capacity bytes of data (a power of two)
+    Counters are free running 32 bit values, so fill level is head - tail. Either side can be a device that accesses the
+    region through the channel's PCIe address, by following the same protocol: write data before bumping head, and read
+    data before bumping tail. On the host, each side is driven through a tt_sysmem_ring object. Producer reserves space
+    and writes in place, consumer reads the returned spans in place, so data is never copied by the ring.
+*/
+class tt_sysmem_ring {
+    public:
+    static constexpr std::uint32_t CACHE_LINE_SIZE = 64;
+    static constexpr std::uint32_t HEAD_OFFSET = 0;
+    static constexpr std::uint32_t TAIL_OFFSET = CACHE_LINE_SIZE;
+    static constexpr std::uint32_t DATA_OFFSET = 2 * CACHE_LINE_SIZE;
+
+    /**
+     * @brief Attach to a ring in region.
+     * \param region Start of the ring. Must be CACHE_LINE_SIZE aligned.
+     * \param region_size Size of the region. The ring uses the largest power of two capacity that fits after the counters.
+     * \param initialize Reset head and tail. Only one side (the one created first) should do this.
+     */
+    tt_sysmem_ring(void* region, std::uint64_t region_size, bool initialize);
+
+    // Producer
+    /**
+     * @brief Contiguous free space at the head of the ring, of up to max_size bytes.
+     * The span can be shorter than requested when the ring is almost full or when it wraps around. Data written to it
+     * only becomes visible to the consumer after commit.
+     */
+    tt_sysmem_span reserve(std::uint32_t max_size);
+    /**
+     * @brief Publish size bytes written to the last reserved span.
+     */
+    void commit(std::uint32_t size);
+
+    // Consumer
+    /**
+     * @brief Contiguous committed data at the tail of the ring. Stays valid until it is released.
+     */
+    tt_sysmem_span peek();
+    /**
+     * @brief Hand size bytes at the tail back to the producer.
+     */
+    void release(std::uint32_t size);
+
+    std::uint32_t get_capacity() const { return capacity; }
+    std::uint32_t get_size() const;
+    /**
+     * @brief Smallest region holding a ring of capacity bytes.
+     */
+    static std::uint64_t get_region_size(std::uint32_t capacity) { return DATA_OFFSET + std::uint64_t(capacity); }
+
+    private:
+    // Counters may be updated by a device, or by another thread for a host side peer.
+    std::uint32_t load_counter(const std::uint32_t* counter) const { return __atomic_load_n(counter, __ATOMIC_ACQUIRE); }
+    void store_counter(std::uint32_t* counter, std::uint32_t value) { __atomic_store_n(counter, value, __ATOMIC_RELEASE); }
+
+    std::uint32_t* head;
+    std::uint32_t* tail;
+    std::uint8_t* data;
+    std::uint32_t capacity;
+    // Last value seen of the peer's counter, so the peer's cache line is only read when the cached value can't satisfy a request.
+    std::uint32_t cached_tail = 0;
+    std::uint32_t cached_head = 0;
+};
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "device/tt_sysmem_streaming.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "device/driver_atomics.h"
+
+void tt_sysmem_memcpy_streaming(void* dest, const void* src, std::size_t num_bytes) {
+#if defined(__x86_64__) || defined(__i386__)
+    auto* d = static_cast<std::uint8_t*>(dest);
+    const auto* s = static_cast<const std::uint8_t*>(src);
+    // Streaming stores need an aligned destination, the source is read with unaligned loads.
+    const std::size_t head = std::min(num_bytes, (16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16);
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    num_bytes -= head;
+
+    // A full cache line per iteration, so write combining buffers are flushed as complete lines.
+    for (; num_bytes >= 64; num_bytes -= 64, d += 64, s += 64) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+    }
+    for (; num_bytes >= 16; num_bytes -= 16, d += 16, s += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+    }
+    std::memcpy(d, s, num_bytes);
+#else
+    std::memcpy(dest, src, num_bytes);
+#endif
+    // Streaming stores are weakly ordered, make them visible before the device is told the data is there.
+    tt_driver_atomics::sfence();
+}
+
+void tt_sysmem_write(void* dest, const void* src, std::size_t num_bytes, std::size_t streaming_threshold) {
+    if (num_bytes >= streaming_threshold) {
+        tt_sysmem_memcpy_streaming(dest, src, num_bytes);
+    } else {
+        std::memcpy(dest, src, num_bytes);
+    }
+}
@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+
+// Writes to sysmem of at least this many bytes use streaming stores by default (see tt_sysmem_write). Chosen with the
+// BM_SysmemWrite* benchmarks (tests/benchmarks), where streaming stores are consistently faster from 64KB: smaller
+// writes evict little of the host's working set, and memcpy wins or ties.
+static constexpr std::size_t TT_SYSMEM_STREAMING_THRESHOLD = 64 * 1024;
+
+/**
+ * @brief Copy to host memory with non-temporal (streaming) stores, followed by an sfence.
+ * The data bypasses the CPU caches, which is what we want for buffers the device reads over PCIe: they don't evict the
+ * host's working set, and device reads don't snoop dirty lines out of the CPU. Bytes before the first 16 byte aligned
+ * destination address and after the last full 16 bytes are copied with scalar stores.
+ * Falls back to memcpy (and a fence) on architectures without streaming stores.
+ */
+void tt_sysmem_memcpy_streaming(void* dest, const void* src, std::size_t num_bytes);
+/**
+ * @brief Copy to host memory, streaming the data if it is at least streaming_threshold bytes and using memcpy otherwise.
+ */
+void tt_sysmem_write(void* dest, const void* src, std::size_t num_bytes, std::size_t streaming_threshold = TT_SYSMEM_STREAMING_THRESHOLD);
@@ -64,7 +64,8 @@ tt_VersimDevice::tt_VersimDevice(const std::string &sdesc_path, const std::strin
   }
 }
 
-std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_VersimDevice::get_virtual_soc_descriptors() {return soc_descriptor_per_chip;}
+std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_VersimDevice::get_virtual_soc_descriptors() {return get_soc_descriptor_copies();}
+const tt_soc_descriptor_map& tt_VersimDevice::get_virtual_soc_descriptor_map() {return soc_descriptor_per_chip;}
 
 tt_ClusterDescriptor* tt_VersimDevice::get_cluster_description() {return ndesc.get();}
 void tt_VersimDevice::start_device(const tt_device_params &device_params) {
@@ -98,10 +99,10 @@ void tt_VersimDevice::start(
      // TODO: For now create a temporary stuff from CA and populate from descriptor before passing back to versim-core
      // interface. mainly bypasses arch_configs etc from llir.  We can populate soc directly
      // MT: have to preserve ca_soc_descriptor object since versim references it at runtime
-     CA::xy_pair CA_grid_size((soc_descriptor_per_chip.begin() -> second).grid_size.x, (soc_descriptor_per_chip.begin() -> second).grid_size.y);
+     CA::xy_pair CA_grid_size((soc_descriptor_per_chip.begin() -> second)->grid_size.x, (soc_descriptor_per_chip.begin() -> second)->grid_size.y);
      // CA::Soc ca_soc_manager(CA_grid_size);
      std::unique_ptr<CA::Soc> p_ca_soc_manager_unique = std::make_unique<CA::Soc>(CA_grid_size);
-     translate_soc_descriptor_to_ca_soc(*p_ca_soc_manager_unique, (soc_descriptor_per_chip.begin() -> second));
+     translate_soc_descriptor_to_ca_soc(*p_ca_soc_manager_unique, *(soc_descriptor_per_chip.begin() -> second));
      // TODO: End
 
      std::cout << "Versim Device: turn_on_device ";
@@ -180,7 +181,7 @@ void tt_VersimDevice::write_to_device(std::vector<uint32_t> &vec, tt_cxy_pair co
   
   log_debug(tt::LogSiliconDriver, "Versim Device ({}): Write vector at target core {}, address: {}", get_sim_time(*versim), core.str(), addr);
 
-  bool aligned_32B = (soc_descriptor_per_chip.begin() -> second).cores.at(core).type == CoreType::DRAM;
+  bool aligned_32B = (soc_descriptor_per_chip.begin() -> second)->cores.at(core).type == CoreType::DRAM;
   // MT: Remove these completely
   CommandAssembler::xy_pair CA_target(core.x, core.y);
   CommandAssembler::memory CA_tensor_memory(addr, vec);
@@ -17,6 +17,11 @@ tt_VersimDevice::tt_VersimDevice(const std::string &sdesc_path, const std::strin
 tt_VersimDevice::~tt_VersimDevice () {}
 
 std::unordered_map<chip_id_t, tt_SocDescriptor>& tt_VersimDevice::get_virtual_soc_descriptors() {
+    throw std::runtime_error("tt_VersimDevice() -- VERSIM is not supported in this build\n");
+    return get_soc_descriptor_copies();
+}
+
+const tt_soc_descriptor_map& tt_VersimDevice::get_virtual_soc_descriptor_map() {
     throw std::runtime_error("tt_VersimDevice() -- VERSIM is not supported in this build\n");
     return soc_descriptor_per_chip;
 }
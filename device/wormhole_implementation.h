@@ -204,7 +204,7 @@ static constexpr uint32_t TENSIX_SOFT_RESET_ADDR = 0xFFB121B0;
 
 }  // namespace wormhole
 
-class wormhole_implementation : public architecture_implementation {
+class wormhole_implementation final : public architecture_implementation {
    public:
     architecture get_architecture() const override { return architecture::wormhole; }
     uint32_t get_arc_message_arc_get_harvesting() const override {
@@ -265,4 +265,41 @@ class wormhole_implementation : public architecture_implementation {
     std::pair<std::uint64_t, std::uint64_t> get_tlb_data(std::uint32_t tlb_index, const tlb_data& data) const override;
 };
 
+inline std::tuple<xy_pair, xy_pair> wormhole_implementation::multicast_workaround(xy_pair start, xy_pair end) const {
+    // When multicasting there is a rare case where including the multicasting node in the box can result in a backup
+    // and the multicasted data not reaching all endpoints specified. As a workaround we exclude the pci endpoint from
+    // the multicast. This doesn't cause any problems with making some tensix cores inaccessible because column 0 (which
+    // we are excluding) doesn't have tensix.
+    start.x = start.x == 0 ? 1 : start.x;
+    return std::make_tuple(start, end);
+}
+
+inline tlb_configuration wormhole_implementation::get_tlb_configuration(uint32_t tlb_index) const {
+    if (tlb_index >= wormhole::TLB_BASE_INDEX_16M) {
+        return tlb_configuration{
+            .size = wormhole::DYNAMIC_TLB_16M_SIZE,
+            .base = wormhole::DYNAMIC_TLB_16M_BASE,
+            .cfg_addr = wormhole::DYNAMIC_TLB_16M_CFG_ADDR,
+            .index_offset = tlb_index - wormhole::TLB_BASE_INDEX_16M,
+            .offset = wormhole::TLB_16M_OFFSET,
+        };
+    } else if (tlb_index >= wormhole::TLB_BASE_INDEX_2M) {
+        return tlb_configuration{
+            .size = wormhole::DYNAMIC_TLB_2M_SIZE,
+            .base = wormhole::DYNAMIC_TLB_2M_BASE,
+            .cfg_addr = wormhole::DYNAMIC_TLB_2M_CFG_ADDR,
+            .index_offset = tlb_index - wormhole::TLB_BASE_INDEX_2M,
+            .offset = wormhole::TLB_2M_OFFSET,
+        };
+    } else {
+        return tlb_configuration{
+            .size = wormhole::DYNAMIC_TLB_1M_SIZE,
+            .base = wormhole::DYNAMIC_TLB_1M_BASE,
+            .cfg_addr = wormhole::DYNAMIC_TLB_1M_CFG_ADDR,
+            .index_offset = tlb_index - wormhole::TLB_BASE_INDEX_1M,
+            .offset = wormhole::TLB_1M_OFFSET,
+        };
+    }
+}
+
 }  // namespace tt::umd
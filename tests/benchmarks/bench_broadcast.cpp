@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "device/tt_io_worker_pool.h"
+#include "tests/test_utils/broadcast_queue_model.hpp"
+
+namespace {
+
+constexpr int headers_per_gateway = 4;
+
+// Time per broadcast of a galaxy like plan through the driver's broadcast loop, with state.range(0) gateways whose
+// ethernet queues each take 50us per header. MMIO groups are issued concurrently on persistent fan out workers, so the
+// time per broadcast should stay flat as gateways are added.
+void BM_BroadcastThroughGateways(benchmark::State& state) {
+    std::vector<chip_id_t> gateways = {};
+    for (int gateway = 0; gateway < state.range(0); gateway++) {
+        gateways.push_back(gateway);
+    }
+    test_utils::broadcast_queue_model queues = test_utils::broadcast_queue_model(gateways);
+    queues.post_latency = std::chrono::microseconds(50);
+    const tt_broadcast_plan plan = test_utils::create_multi_gateway_plan(gateways, headers_per_gateway);
+    tt_mmio_fan_out fan_out = tt_mmio_fan_out();
+    for (auto _ : state) {
+        tt_issue_broadcast(queues, fan_out, plan);
+        state.PauseTiming();
+        queues.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_BroadcastThroughGateways)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
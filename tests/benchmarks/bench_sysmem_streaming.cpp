@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "device/tt_sysmem_streaming.h"
+
+namespace {
+
+constexpr std::size_t channel_size = 64 * 1024 * 1024;
+constexpr std::size_t working_set_size = 1024 * 1024;
+
+// Anonymous mapping standing in for a hugepage backed host memory channel.
+class anonymous_channel {
+    public:
+    explicit anonymous_channel(std::size_t size) : size(size) {
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Failed to map host memory channel stand-in");
+        }
+        std::memset(mapping, 0, size);
+    }
+    ~anonymous_channel() { munmap(mapping, size); }
+    std::uint8_t* data() const { return static_cast<std::uint8_t*>(mapping); }
+
+    private:
+    void* mapping;
+    std::size_t size;
+};
+
+// Each iteration writes a payload into the channel, then touches a hot host working set. Streaming stores are slower
+// than memcpy while the payload fits in the caches, but leave the working set cached.
+void run_sysmem_writes(benchmark::State& state, std::size_t streaming_threshold) {
+    const std::size_t size = state.range(0);
+    anonymous_channel channel = anonymous_channel(channel_size);
+    std::vector<std::uint8_t> src(size, 1);
+    std::vector<std::uint64_t> working_set(working_set_size / sizeof(std::uint64_t), 1);
+
+    std::size_t offset = 0;
+    for (auto _ : state) {
+        tt_sysmem_write(channel.data() + offset, src.data(), size, streaming_threshold);
+        offset = (offset + size) % (channel_size - size + 1);
+        std::uint64_t sum = 0;
+        for (std::size_t j = 0; j < working_set.size(); j += 8) {
+            sum += working_set[j];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+void BM_SysmemWriteMemcpy(benchmark::State& state) {
+    run_sysmem_writes(state, std::numeric_limits<std::size_t>::max());
+}
+
+void BM_SysmemWriteStreaming(benchmark::State& state) {
+    run_sysmem_writes(state, 0);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SysmemWriteMemcpy)->RangeMultiplier(4)->Range(16 * 1024, channel_size);
+BENCHMARK(BM_SysmemWriteStreaming)->RangeMultiplier(4)->Range(16 * 1024, channel_size);
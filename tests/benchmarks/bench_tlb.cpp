@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "device/architecture_implementation.h"
+#include "device/wormhole_implementation.h"
+
+namespace {
+
+// Every dynamic TLB, pointed at addresses inside, at the end of and across the window of each TLB size
+std::vector<std::pair<std::uint32_t, std::uint64_t>> get_dynamic_tlb_setup_cases() {
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> cases = {};
+    for (std::uint32_t tlb_index = tt::umd::wormhole::TLB_BASE_INDEX_2M; tlb_index < tt::umd::wormhole::INTERNAL_TLB_INDEX + 1; tlb_index++) {
+        for (std::uint64_t address : {0x0ULL, 0x100ULL, 0xFFFFCULL, 0x1FFFFCULL, 0x200000ULL, 0xFFFFFCULL, 0x1000000ULL, 0x30000000ULL}) {
+            cases.push_back({tlb_index, address});
+        }
+    }
+    return cases;
+}
+
+constexpr tt::umd::tlb_data setup_data = {.x_end = 1, .y_end = 1, .ordering = tt::umd::tlb_data::Strict, .static_vc = 1};
+
+// Dynamic TLB configuration computed through the vtable
+void BM_DynamicTLBSetupVirtual(benchmark::State& state) {
+    const auto architecture_implementation = tt::umd::architecture_implementation::create(tt::umd::architecture::wormhole_b0);
+    const auto cases = get_dynamic_tlb_setup_cases();
+    for (auto _ : state) {
+        for (const auto& [tlb_index, address] : cases) {
+            benchmark::DoNotOptimize(tt::umd::get_dynamic_tlb_setup(*architecture_implementation, tlb_index, address, setup_data));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * cases.size());
+}
+
+// Dynamic TLB configuration computed by the architecture specialised routine the driver resolves at device open
+void BM_DynamicTLBSetupSpecialised(benchmark::State& state) {
+    const tt::umd::tlb_operations* tlb_operations = tt::umd::architecture_implementation::get_tlb_operations(tt::umd::architecture::wormhole_b0);
+    const auto cases = get_dynamic_tlb_setup_cases();
+    for (auto _ : state) {
+        for (const auto& [tlb_index, address] : cases) {
+            benchmark::DoNotOptimize(tlb_operations->get_dynamic_tlb_setup(tlb_index, address, setup_data));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * cases.size());
+}
+
+}  // namespace
+
+BENCHMARK(BM_DynamicTLBSetupVirtual);
+BENCHMARK(BM_DynamicTLBSetupSpecialised);
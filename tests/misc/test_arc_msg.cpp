@@ -0,0 +1,319 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "device/tt_arc_msg.h"
+#include "device/tt_device_bringup.h"
+#include "tests/test_utils/arc_msg_model.hpp"
+#include "tests/test_utils/rendezvous.hpp"
+
+TEST(ArcMsg, RepliesAreReadBackFromScratch) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {0, 1000, 7};
+    arc.replies[0xaa52] = {3, 0, 0};
+
+    std::uint32_t return_3 = 0;
+    std::uint32_t return_4 = 0;
+    ASSERT_EQ(tt_send_arc_msg(arc, arc.get_regs(), 0, 0xaa34, true, 0x1234, 0xabcd, 1, &return_3, &return_4), 0);
+    ASSERT_EQ(return_3, 1000);
+    ASSERT_EQ(return_4, 7);
+    ASSERT_EQ(arc.messages.size(), 1);
+    ASSERT_EQ(arc.messages.at(0).msg_code, 0xaa34);
+    ASSERT_EQ(arc.messages.at(0).fw_arg, 0xabcd1234);
+    ASSERT_EQ(arc.num_flushes, 1);
+
+    // Exit codes are passed through, and messages the firmware doesn't know get the error reply
+    ASSERT_EQ(tt_send_arc_msg(arc, arc.get_regs(), 0, 0xaa52, true, 0, 0, 1, nullptr, nullptr), 3);
+    ASSERT_EQ(tt_send_arc_msg(arc, arc.get_regs(), 0, 0xaa99, true, 0, 0, 1, nullptr, nullptr), TT_ARC_MSG_ERROR_REPLY);
+
+    // Posted messages don't poll for the reply
+    arc.num_reads = 0;
+    ASSERT_EQ(tt_send_arc_msg(arc, arc.get_regs(), 0, 0xaa34, false, 0, 0, 1, nullptr, nullptr), 0);
+    ASSERT_EQ(arc.num_reads, 1);
+    ASSERT_EQ(arc.messages.size(), 4);
+}
+
+TEST(ArcMsg, BusyOrHungFirmware) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {};
+
+    // The interrupt of an earlier message is still pending, so the message isn't triggered
+    arc.set_reg(test_utils::arc_msg_model::MISC_CNTL, test_utils::arc_msg_model::FW_INT);
+    ASSERT_EQ(tt_send_arc_msg(arc, arc.get_regs(), 0, 0xaa34, true, 0, 0, 1, nullptr, nullptr), 1);
+    ASSERT_TRUE(arc.messages.empty());
+
+    arc.set_reg(test_utils::arc_msg_model::MISC_CNTL, 0);
+    arc.responds = false;
+    ASSERT_THROW(tt_send_arc_msg(arc, arc.get_regs(), 0, 0xaa34, true, 0, 0, 0, nullptr, nullptr), std::runtime_error);
+}
+
+TEST(ArcMsg, ConcurrentFanOutOverlapsRoundTrips) {
+    const std::vector<chip_id_t> devices = {0, 1, 2, 3};
+    std::vector<test_utils::arc_msg_model> arcs = std::vector<test_utils::arc_msg_model>(devices.size());
+    for (auto& arc : arcs) {
+        arc.replies[0xaa34] = {0, 1000, 0};
+    }
+
+    std::vector<std::uint32_t> clocks = std::vector<std::uint32_t>(devices.size(), 0);
+    test_utils::rendezvous in_flight = test_utils::rendezvous(devices.size());
+    tt_device_bringup(devices.size()).run_per_device("get_clocks", devices, [&] (chip_id_t device) {
+        auto& arc = arcs.at(device);
+        // Every device has to be mid round trip at the same time for the others to get past this
+        ASSERT_TRUE(in_flight.arrive_and_wait());
+        ASSERT_EQ(tt_send_arc_msg(arc, arc.get_regs(), device, 0xaa34, true, 0xffff, 0xffff, 1, &clocks.at(device), nullptr), 0);
+    });
+    for (const auto& clock : clocks) {
+        EXPECT_EQ(clock, 1000);
+    }
+}
+
+TEST(TelemetryCache, ValuesAreReusedWithinTTL) {
+    int num_reads = 0;
+    auto read = [&] () { return static_cast<std::uint32_t>(++num_reads); };
+
+    // Disabled by default
+    tt_telemetry_cache cache;
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 1);
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 2);
+
+    cache.set_ttl(std::chrono::hours(1));
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 3);
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 3);
+    // Keys and devices are cached separately
+    ASSERT_EQ(cache.get(0, 0xaa35, read), 4);
+    ASSERT_EQ(cache.get(1, 0xaa34, read), 5);
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 3);
+
+    cache.invalidate(0);
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 6);
+    ASSERT_EQ(cache.get(1, 0xaa34, read), 5);
+    cache.invalidate();
+    ASSERT_EQ(cache.get(1, 0xaa34, read), 7);
+
+    cache.set_ttl(std::chrono::milliseconds(20));
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 8);
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 8);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    ASSERT_EQ(cache.get(0, 0xaa34, read), 9);
+}
+
+TEST(TelemetryCache, FailedAndInvalidatedReadsArentCached) {
+    tt_telemetry_cache cache = tt_telemetry_cache(std::chrono::hours(1));
+    ASSERT_THROW(cache.get(0, 0xaa34, [] () -> std::uint32_t { throw std::runtime_error("ARC timed out"); }), std::runtime_error);
+    ASSERT_EQ(cache.get(0, 0xaa34, [] () { return 1000u; }), 1000);
+
+    // A power state change lands while the clock is being read. The cache isn't locked during reads.
+    ASSERT_EQ(cache.get(1, 0xaa34, [&] () { cache.invalidate(1); return 500u; }), 500);
+    ASSERT_EQ(cache.get(1, 0xaa34, [] () { return 1000u; }), 1000);
+    ASSERT_EQ(cache.get(1, 0xaa34, [] () { return 0u; }), 1000);
+}
+
+TEST(ArcMsg, PostedMessagesArePolledToCompletion) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {0, 1000, 7};
+    arc.response_latency = std::chrono::milliseconds(5);
+
+    tt_arc_mailbox mailbox = {};
+    tt_arc_msg_token token = mailbox.post(arc, arc.get_regs(), 0, 0xaa34, 0x1234, 0xabcd, 1);
+    ASSERT_FALSE(token.is_complete());
+    ASSERT_TRUE(mailbox.has_message_in_flight());
+    ASSERT_EQ(arc.messages.size(), 1);
+    ASSERT_EQ(arc.messages.at(0).fw_arg, 0xabcd1234);
+
+    int num_polls = 0;
+    while (!mailbox.test(arc, arc.get_regs(), token)) {
+        num_polls++;
+    }
+    ASSERT_GT(num_polls, 0);
+    ASSERT_TRUE(token.is_complete());
+    ASSERT_FALSE(mailbox.has_message_in_flight());
+    ASSERT_EQ(token.exit_code, 0);
+    ASSERT_EQ(token.return_3, 1000);
+    ASSERT_EQ(token.return_4, 7);
+
+    // Completed tokens don't touch the registers again
+    arc.num_reads = 0;
+    ASSERT_TRUE(mailbox.test(arc, arc.get_regs(), token));
+    ASSERT_EQ(arc.num_reads, 0);
+}
+
+TEST(ArcMsg, PostingWaitsForTheMessageInFlight) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {0, 1, 0};
+    arc.replies[0xaa35] = {2, 2, 0};
+    arc.response_latency = std::chrono::milliseconds(5);
+
+    tt_arc_mailbox mailbox = {};
+    tt_arc_msg_token first = mailbox.post(arc, arc.get_regs(), 0, 0xaa34, 0, 0, 1);
+    tt_arc_msg_token second = mailbox.post(arc, arc.get_regs(), 0, 0xaa35, 0, 0, 1);
+    ASSERT_EQ(arc.messages.size(), 2);
+
+    // The second post read the first reply before overwriting the mailbox, and kept it for the first token
+    arc.num_reads = 0;
+    ASSERT_TRUE(mailbox.test(arc, arc.get_regs(), first));
+    ASSERT_EQ(arc.num_reads, 0);
+    ASSERT_EQ(first.return_3, 1);
+    while (!mailbox.test(arc, arc.get_regs(), second)) {}
+    ASSERT_EQ(second.exit_code, 2);
+    ASSERT_EQ(second.return_3, 2);
+
+    // Fire and forget: the token of the first message is dropped
+    mailbox.post(arc, arc.get_regs(), 0, 0xaa34, 0, 0, 1);
+    tt_arc_msg_token last = mailbox.post(arc, arc.get_regs(), 0, 0xaa35, 0, 0, 1);
+    while (!mailbox.test(arc, arc.get_regs(), last)) {}
+    ASSERT_EQ(last.return_3, 2);
+    ASSERT_EQ(arc.messages.size(), 4);
+}
+
+TEST(ArcMsg, TimedOutMessagesThrowOnEveryTest) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {0, 1, 0};
+    arc.responds = false;
+
+    tt_arc_mailbox mailbox = {};
+    tt_arc_msg_token token = mailbox.post(arc, arc.get_regs(), 0, 0xaa34, 0, 0, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_THROW(mailbox.test(arc, arc.get_regs(), token), std::runtime_error);
+    ASSERT_THROW(mailbox.test(arc, arc.get_regs(), token), std::runtime_error);
+    ASSERT_FALSE(mailbox.has_message_in_flight());
+
+    // The firmware catches up on the message that timed out, and the next message doesn't wait for its reply
+    arc.responds = true;
+    arc.read_reg(test_utils::arc_msg_model::MISC_CNTL);
+    arc.num_reads = 0;
+    tt_arc_msg_token next = mailbox.post(arc, arc.get_regs(), 0, 0xaa34, 0, 0, 1);
+    ASSERT_EQ(arc.num_reads, 1);
+    while (!mailbox.test(arc, arc.get_regs(), next)) {}
+    ASSERT_EQ(next.return_3, 1);
+}
+
+TEST(ArcMsg, MessagesToDifferentChipsAreInFlightTogether) {
+    const int num_chips = 4;
+    std::vector<test_utils::arc_msg_model> arcs = std::vector<test_utils::arc_msg_model>(num_chips);
+    std::vector<tt_arc_mailbox> mailboxes = std::vector<tt_arc_mailbox>(num_chips);
+    for (auto& arc : arcs) {
+        arc.replies[0xaa34] = {0, 1000, 0};
+        arc.response_latency = std::chrono::milliseconds(20);
+    }
+
+    // A single thread posts to every chip before waiting on any of them
+    std::vector<tt_arc_msg_token> tokens = {};
+    for (int chip = 0; chip < num_chips; chip++) {
+        tokens.push_back(mailboxes.at(chip).post(arcs.at(chip), arcs.at(chip).get_regs(), chip, 0xaa34, 0, 0, 1));
+    }
+    for (const auto& arc : arcs) {
+        ASSERT_EQ(arc.messages.size(), 1);
+    }
+    for (auto& token : tokens) {
+        auto& arc = arcs.at(token.chip);
+        while (!mailboxes.at(token.chip).test(arc, arc.get_regs(), token)) {}
+        ASSERT_EQ(token.return_3, 1000);
+    }
+}
+
+TEST(ArcMsg, ConcurrentPostersShareTheMailbox) {
+    test_utils::arc_msg_model arc = {};
+    for (std::uint32_t msg_code = 0xaa10; msg_code < 0xaa20; msg_code++) {
+        arc.replies[msg_code] = {0, msg_code, 0};
+    }
+    arc.response_latency = std::chrono::microseconds(200);
+    arc.read_latency = std::chrono::microseconds(10);
+
+    tt_arc_mailbox mailbox = {};
+    std::vector<std::thread> threads = {};
+    for (std::uint32_t thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&, thread] {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                const std::uint32_t msg_code = 0xaa10 + thread * 4 + i;
+                tt_arc_msg_token token = mailbox.post(arc, arc.get_regs(), 0, msg_code, 0, 0, 1);
+                while (!mailbox.test(arc, arc.get_regs(), token)) {
+                    std::this_thread::yield();
+                }
+                EXPECT_EQ(token.return_3, msg_code);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(arc.messages.size(), 16);
+}
+
+TEST(ArcMsg, OtherProcessesWaitForTheReplyInFlight) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {0, 1, 0};
+    arc.replies[0xaa35] = {0, 2, 0};
+    arc.response_latency = std::chrono::milliseconds(5);
+    tt_arc_msg_in_flight_marker marker = {};
+    arc.in_flight_marker = &marker;
+
+    // Two processes sharing the chip, each with its own mailbox (the parent of the test stands in for the other one)
+    tt_arc_mailbox mailbox = tt_arc_mailbox(getpid());
+    tt_arc_mailbox other_mailbox = tt_arc_mailbox(getppid());
+    tt_arc_msg_token token = mailbox.post(arc, arc.get_regs(), 0, 0xaa34, 0, 0, 1);
+    ASSERT_EQ(marker.owner_pid, getpid());
+
+    // The other process can't post until the reply was read, even once the firmware replied
+    tt_arc_msg_token other_token = {};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_FALSE(other_mailbox.try_post(arc, arc.get_regs(), 0, 0xaa35, 0, 0, 1, other_token));
+    ASSERT_EQ(arc.messages.size(), 1);
+    ASSERT_TRUE(mailbox.test(arc, arc.get_regs(), token));
+    ASSERT_EQ(token.return_3, 1);
+    ASSERT_EQ(marker.owner_pid, 0);
+
+    ASSERT_TRUE(other_mailbox.try_post(arc, arc.get_regs(), 0, 0xaa35, 0, 0, 1, other_token));
+    ASSERT_EQ(marker.owner_pid, getppid());
+    while (!other_mailbox.test(arc, arc.get_regs(), other_token)) {}
+    ASSERT_EQ(other_token.return_3, 2);
+}
+
+TEST(ArcMsg, StaleInFlightMarkersAreIgnored) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {0, 1, 0};
+    tt_arc_msg_in_flight_marker marker = {};
+    arc.in_flight_marker = &marker;
+    tt_arc_mailbox mailbox = {};
+    tt_arc_msg_token token = {};
+
+    // The message of the other process timed out
+    marker.owner_pid = getppid();
+    marker.deadline_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    ASSERT_TRUE(mailbox.try_post(arc, arc.get_regs(), 0, 0xaa34, 0, 0, 1, token));
+    while (!mailbox.test(arc, arc.get_regs(), token)) {}
+
+    // The other process exited with its message in flight
+    const pid_t exited = fork();
+    if (exited == 0) {
+        _exit(0);
+    }
+    ASSERT_GT(exited, 0);
+    waitpid(exited, nullptr, 0);
+    marker.owner_pid = exited;
+    marker.deadline_ns = std::chrono::duration_cast<std::chrono::nanoseconds>((std::chrono::steady_clock::now() + std::chrono::hours(1)).time_since_epoch()).count();
+    ASSERT_TRUE(mailbox.try_post(arc, arc.get_regs(), 0, 0xaa34, 0, 0, 1, token));
+    while (!mailbox.test(arc, arc.get_regs(), token)) {}
+    ASSERT_EQ(marker.owner_pid, 0);
+}
+
+TEST(ArcMsg, WaitingForAReplyBacksOff) {
+    test_utils::arc_msg_model arc = {};
+    arc.replies[0xaa34] = {0, 1, 0};
+    arc.response_latency = std::chrono::milliseconds(50);
+
+    // Polling back to back would read the mailbox millions of times while the firmware handles the message.
+    std::uint32_t return_3 = 0;
+    ASSERT_EQ(tt_send_arc_msg(arc, arc.get_regs(), 0, 0xaa34, true, 0, 0, 1, &return_3, nullptr), 0);
+    ASSERT_EQ(return_3, 1);
+    ASSERT_LT(arc.num_reads, 200);
+}
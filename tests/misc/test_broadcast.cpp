@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tt_device.h"
+
+#include "device/tt_io_worker_pool.h"
+#include "device/tt_membar.h"
+#include "tests/test_utils/broadcast_queue_model.hpp"
+#include "tests/test_utils/generate_cluster_desc.hpp"
+
+namespace {
+std::unordered_set<tt_xy_pair> get_worker_cores(const tt_SocDescriptor& sdesc) {
+    std::unordered_set<tt_xy_pair> cores = {};
+    for (const auto& core : sdesc.workers) {
+        cores.insert(core);
+    }
+    return cores;
+}
+}
+
+TEST(EthernetBroadcast, MMIOGroupsAreIssuedConcurrently) {
+    constexpr int headers_per_gateway = 2;
+    tt_mmio_fan_out fan_out = tt_mmio_fan_out();
+    for (int num_gateways : {1, 2, 4}) {
+        std::vector<chip_id_t> gateways = {};
+        for (int gateway = 0; gateway < num_gateways; gateway++) {
+            gateways.push_back(gateway);
+        }
+        test_utils::broadcast_queue_model queues = test_utils::broadcast_queue_model(gateways, num_gateways);
+        const tt_broadcast_plan plan = test_utils::create_multi_gateway_plan(gateways, headers_per_gateway);
+        // Twice, to run on the fan out workers started by the first broadcast
+        for (int broadcast = 0; broadcast < 2; broadcast++) {
+            tt_issue_broadcast(queues, fan_out, plan);
+            ASSERT_TRUE(queues.all_gateways_posting) << "All " << num_gateways << " gateways should be posting at the same time";
+            for (const auto& gateway : gateways) {
+                // Headers of a group are posted in order, on that group's gateway
+                ASSERT_EQ(queues.get_posted_headers(gateway), std::vector<std::vector<int>>({{gateway, 0}, {gateway, 1}}));
+            }
+            queues.reset();
+        }
+    }
+}
+
+TEST(EthernetBroadcast, BroadcastsCompleteInOrder) {
+    // The second ethernet broadcast of a plan only starts once every group of the first one was posted, and direct
+    // writes are issued once all ethernet broadcasts are done.
+    const std::vector<chip_id_t> gateways = {0, 1, 2};
+    test_utils::broadcast_queue_model queues = test_utils::broadcast_queue_model(gateways);
+    tt_broadcast_plan plan = test_utils::create_multi_gateway_plan(gateways, 1);
+    plan.ethernet_broadcasts.push_back({{0, {{0, 1}}}, {2, {{2, 1}}}});
+    for (const auto& gateway : gateways) {
+        plan.direct_writes_per_gateway[gateway].push_back({gateway, {{tt_xy_pair(1, 1), tt_xy_pair(4, 5)}}, {tt_xy_pair(0, 0)}});
+    }
+    tt_mmio_fan_out fan_out = tt_mmio_fan_out();
+    tt_issue_broadcast(queues, fan_out, plan);
+    ASSERT_EQ(queues.get_posted_headers(0), std::vector<std::vector<int>>({{0, 0}, {0, 1}}));
+    ASSERT_EQ(queues.get_posted_headers(1), std::vector<std::vector<int>>({{1, 0}}));
+    ASSERT_EQ(queues.get_posted_headers(2), std::vector<std::vector<int>>({{2, 0}, {2, 1}}));
+    ASSERT_EQ(queues.num_direct_writes, 6);
+}
+
+TEST(EthernetBroadcast, SoftwareFallbackMulticastsToTensixRectangles) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto workers = get_worker_cores(sdesc);
+    auto get_written_cores = [] (const std::vector<tt_multicast_grid>& grids, const std::vector<tt_xy_pair>& unicast_cores) {
+        std::unordered_set<tt_xy_pair> written = {};
+        for (const auto& grid : grids) {
+            for (std::size_t y = grid.start.y; y <= grid.end.y; y++) {
+                for (std::size_t x = grid.start.x; x <= grid.end.x; x++) {
+                    EXPECT_TRUE(written.insert(tt_xy_pair(x, y)).second);
+                }
+            }
+        }
+        for (const auto& core : unicast_cores) {
+            EXPECT_TRUE(written.insert(core).second);
+        }
+        return written;
+    };
+
+    // Tensix only broadcast on an MMIO chip: one multicast per block of workers.
+    std::vector<tt_multicast_grid> grids = {};
+    std::vector<tt_xy_pair> unicast_cores = {};
+    tt_SiliconDevice::get_broadcast_targets(sdesc, {0, 6}, {0, 5}, true, grids, unicast_cores);
+    ASSERT_EQ(grids.size(), 4);
+    ASSERT_TRUE(unicast_cores.empty());
+    ASSERT_EQ(get_written_cores(grids, unicast_cores), workers);
+
+    // Remote chips can't be multicast to.
+    grids.clear();
+    tt_SiliconDevice::get_broadcast_targets(sdesc, {0, 6}, {0, 5}, false, grids, unicast_cores);
+    ASSERT_TRUE(grids.empty());
+    ASSERT_EQ(unicast_cores.size(), workers.size());
+
+    // Excluding rows and columns splits the rectangles. Non Tensix cores are still written one by one.
+    grids.clear();
+    unicast_cores.clear();
+    const std::set<uint32_t> rows_to_exclude = {2, 3, 4, 8, 9, 10};
+    const std::set<uint32_t> cols_to_exclude = {3, 7};
+    tt_SiliconDevice::get_broadcast_targets(sdesc, rows_to_exclude, cols_to_exclude, true, grids, unicast_cores);
+    std::unordered_set<tt_xy_pair> expected = {};
+    for (const auto& core : sdesc.cores) {
+        if (rows_to_exclude.find(core.first.y) == rows_to_exclude.end() && cols_to_exclude.find(core.first.x) == cols_to_exclude.end() &&
+            core.second.type != CoreType::HARVESTED) {
+            expected.insert(core.first);
+        }
+    }
+    ASSERT_EQ(get_written_cores(grids, unicast_cores), expected);
+    for (const auto& grid : grids) {
+        ASSERT_GE(grid.num_cores(), 2);
+        ASSERT_TRUE(workers.find(grid.start) != workers.end() && workers.find(grid.end) != workers.end());
+    }
+    for (const auto& core : unicast_cores) {
+        ASSERT_TRUE(workers.find(core) == workers.end() || std::none_of(grids.begin(), grids.end(), [&] (const tt_multicast_grid& grid) { return grid.contains(core); }));
+    }
+}
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "device/tt_device_bringup.h"
+#include "tests/test_utils/rendezvous.hpp"
+
+namespace {
+// Fake device/hugepage backend for bring-up tests. Tracks how many steps are running at once. Steps can wait on a
+// rendezvous, to check that they run concurrently without depending on how long they take.
+struct fake_bringup_backend {
+    std::atomic<int> active_steps = 0;
+    std::atomic<int> max_active_steps = 0;
+    std::mutex mutex;
+    std::map<chip_id_t, std::thread::id> pinned_thread = {};
+    std::map<chip_id_t, std::thread::id> opened_on_thread = {};
+    std::map<chip_id_t, int> num_opens = {};
+    std::map<chip_id_t, std::uint64_t> hugepage_address = {};
+
+    void pin(chip_id_t device) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        pinned_thread[device] = std::this_thread::get_id();
+    }
+
+    void run_step(test_utils::rendezvous* in_flight) {
+        int active = ++active_steps;
+        int max_active = max_active_steps.load();
+        while (active > max_active && !max_active_steps.compare_exchange_weak(max_active, active)) {}
+        if (in_flight) {
+            EXPECT_TRUE(in_flight->arrive_and_wait()) << "Devices were not initialized at the same time";
+        }
+        active_steps--;
+    }
+
+    void open_device(chip_id_t device, test_utils::rendezvous* in_flight = nullptr) {
+        run_step(in_flight);
+        const std::lock_guard<std::mutex> lock(mutex);
+        opened_on_thread[device] = std::this_thread::get_id();
+        num_opens[device]++;
+    }
+
+    void init_hugepage(chip_id_t device, test_utils::rendezvous* in_flight = nullptr) {
+        run_step(in_flight);
+        const std::lock_guard<std::mutex> lock(mutex);
+        hugepage_address[device] = 0x40000000ULL * (device + 1);
+    }
+};
+}
+
+TEST(DeviceBringup, PerDevicePhasesRunConcurrently) {
+    const std::vector<chip_id_t> devices = {0, 1, 2, 3};
+    fake_bringup_backend backend;
+    test_utils::rendezvous devices_opening = test_utils::rendezvous(devices.size());
+    test_utils::rendezvous hugepages_initializing = test_utils::rendezvous(devices.size());
+    tt_device_bringup bringup = tt_device_bringup(devices.size(), [&] (chip_id_t device) { backend.pin(device); });
+
+    bringup.run_per_device("open_devices", devices, [&] (chip_id_t device) { backend.open_device(device, &devices_opening); });
+    bringup.run_per_device("init_hugepages", devices, [&] (chip_id_t device) { backend.init_hugepage(device, &hugepages_initializing); });
+
+    ASSERT_EQ(backend.max_active_steps, devices.size()) << "All devices should have been initialized at the same time";
+    for (const auto& device : devices) {
+        ASSERT_EQ(backend.num_opens.at(device), 1);
+        ASSERT_EQ(backend.hugepage_address.at(device), 0x40000000ULL * (device + 1));
+        ASSERT_NE(backend.opened_on_thread.at(device), std::this_thread::get_id()) << "Steps should run on worker threads";
+    }
+    // Workers are pinned to each device they initialize, right before initializing it
+    for (const auto& [device, thread_id] : backend.pinned_thread) {
+        ASSERT_NE(thread_id, std::this_thread::get_id());
+    }
+    ASSERT_EQ(backend.pinned_thread.size(), devices.size());
+
+    const auto& timings = bringup.get_phase_timings();
+    ASSERT_EQ(timings.size(), 2);
+    ASSERT_EQ(timings.at(0).phase, "open_devices");
+    ASSERT_EQ(timings.at(1).phase, "init_hugepages");
+    for (const auto& timing : timings) {
+        ASSERT_EQ(timing.num_devices, devices.size());
+    }
+}
+
+TEST(DeviceBringup, ThreadPoolIsBounded) {
+    std::vector<chip_id_t> devices = {};
+    for (chip_id_t device = 0; device < 8; device++) {
+        devices.push_back(device);
+    }
+    fake_bringup_backend backend;
+    std::atomic<int> num_unpins = 0;
+    tt_device_bringup bringup = tt_device_bringup(2, [&] (chip_id_t device) { backend.pin(device); }, [&] () { num_unpins++; });
+    bringup.run_per_device("open_devices", devices, [&] (chip_id_t device) { backend.open_device(device); });
+
+    ASSERT_LE(backend.max_active_steps, 2);
+    ASSERT_EQ(num_unpins, devices.size()) << "Workers must be unpinned after each device, since the next one can be on another NUMA node";
+    std::set<std::thread::id> worker_threads = {};
+    for (const auto& device : devices) {
+        ASSERT_EQ(backend.num_opens.at(device), 1) << "Each device must be opened exactly once";
+        worker_threads.insert(backend.opened_on_thread.at(device));
+    }
+    ASSERT_LE(worker_threads.size(), 2);
+}
+
+TEST(DeviceBringup, SerialPhasesAreOrdered) {
+    const std::vector<chip_id_t> devices = {0, 1, 2, 3};
+    fake_bringup_backend backend;
+    std::vector<std::string> log = {};
+    tt_device_bringup bringup = tt_device_bringup(4);
+
+    bringup.run_per_device("open_devices", devices, [&] (chip_id_t device) { backend.open_device(device); });
+    bringup.run_serial("configure_devices", [&] () {
+        // Cross device steps only run once every device is open
+        ASSERT_EQ(backend.num_opens.size(), devices.size());
+        log.push_back("configure_devices");
+    });
+    bringup.run_per_device("init_hugepages", devices, [&] (chip_id_t device) { backend.init_hugepage(device); });
+    bringup.run_serial("init_dmabufs", [&] () {
+        ASSERT_EQ(backend.hugepage_address.size(), devices.size());
+        log.push_back("init_dmabufs");
+    });
+
+    ASSERT_EQ(log, std::vector<std::string>({"configure_devices", "init_dmabufs"}));
+    std::vector<std::string> phases = {};
+    for (const auto& timing : bringup.get_phase_timings()) {
+        phases.push_back(timing.phase);
+    }
+    ASSERT_EQ(phases, std::vector<std::string>({"open_devices", "configure_devices", "init_hugepages", "init_dmabufs"}));
+    ASSERT_EQ(bringup.get_phase_timings().at(1).num_devices, 0);
+}
+
+TEST(DeviceBringup, FailuresPropagateAfterAllDevicesFinish) {
+    const std::vector<chip_id_t> devices = {0, 1, 2, 3};
+    fake_bringup_backend backend;
+    tt_device_bringup bringup = tt_device_bringup(4);
+    EXPECT_THROW(bringup.run_per_device("open_devices", devices, [&] (chip_id_t device) {
+        backend.open_device(device);
+        if (device == 2) {
+            throw std::runtime_error("Failed to open device 2");
+        }
+    }), std::runtime_error);
+    // No step may still be running once the failure is reported
+    ASSERT_EQ(backend.active_steps, 0);
+    ASSERT_EQ(backend.num_opens.size(), devices.size());
+    ASSERT_EQ(bringup.get_phase_timings().size(), 1);
+}
+
+TEST(DeviceBringup, SingleThreadRunsOnCallingThread) {
+    const std::vector<chip_id_t> devices = {0, 1};
+    fake_bringup_backend backend;
+    bool pinned = false;
+    tt_device_bringup bringup = tt_device_bringup(1, [&] (chip_id_t device) { pinned = true; });
+    bringup.run_per_device("open_devices", devices, [&] (chip_id_t device) { backend.open_device(device); });
+    for (const auto& device : devices) {
+        ASSERT_EQ(backend.opened_on_thread.at(device), std::this_thread::get_id());
+    }
+    ASSERT_FALSE(pinned) << "The calling thread must never be pinned";
+    ASSERT_EQ(tt_device_bringup::get_default_max_threads(0), 1);
+    ASSERT_LE(tt_device_bringup::get_default_max_threads(4), 4);
+}
+
+TEST(DeviceBringup, MMIODeviceBringupRunsStepsInOrder) {
+    const std::vector<chip_id_t> devices = {0, 1, 2, 3};
+    fake_bringup_backend backend;
+    test_utils::rendezvous devices_opening = test_utils::rendezvous(devices.size());
+    std::vector<std::string> serial_steps = {};
+    std::atomic<int> num_hugepage_fds = 0;
+
+    tt_mmio_device_bringup_steps steps = {};
+    steps.allocate_device = [&] (chip_id_t device) {
+        ASSERT_TRUE(backend.num_opens.empty()) << "Devices are allocated before any of them is opened";
+        serial_steps.push_back("allocate_device " + std::to_string(device));
+    };
+    steps.open_device = [&] (chip_id_t device) { backend.open_device(device, &devices_opening); };
+    steps.configure_device = [&] (chip_id_t device) {
+        ASSERT_EQ(backend.num_opens.size(), devices.size()) << "Devices are configured once every device is open";
+        serial_steps.push_back("configure_device " + std::to_string(device));
+    };
+    steps.open_hugepage_fds = [&] (chip_id_t device) { num_hugepage_fds++; };
+    steps.start_hugepage_init = [&] {
+        ASSERT_EQ(num_hugepage_fds, devices.size());
+        serial_steps.push_back("start_hugepage_init");
+    };
+    steps.init_hugepages = [&] (chip_id_t device) { backend.init_hugepage(device); };
+
+    tt_device_bringup bringup = tt_device_bringup(devices.size());
+    bringup.bring_up_mmio_devices(devices, steps);
+
+    ASSERT_EQ(backend.max_active_steps, devices.size()) << "Devices should have been opened at the same time";
+    ASSERT_EQ(serial_steps, std::vector<std::string>({"allocate_device 0", "allocate_device 1", "allocate_device 2", "allocate_device 3",
+        "configure_device 0", "configure_device 1", "configure_device 2", "configure_device 3", "start_hugepage_init"}));
+    ASSERT_EQ(backend.hugepage_address.size(), devices.size());
+    std::vector<std::string> phases = {};
+    for (const auto& timing : bringup.get_phase_timings()) {
+        phases.push_back(timing.phase);
+    }
+    ASSERT_EQ(phases, std::vector<std::string>({"allocate_devices", "open_devices", "configure_devices", "open_hugepage_fds", "start_hugepage_init", "init_hugepages"}));
+}
+
+TEST(DeviceBringup, MMIODeviceBringupSkipsHugepageSteps) {
+    // skip_driver_allocs: no hugepage steps are set
+    const std::vector<chip_id_t> devices = {0, 1};
+    tt_mmio_device_bringup_steps steps = {};
+    steps.allocate_device = [] (chip_id_t device) {};
+    steps.open_device = [] (chip_id_t device) {};
+    steps.configure_device = [] (chip_id_t device) {};
+    steps.open_hugepage_fds = [] (chip_id_t device) {};
+
+    tt_device_bringup bringup = tt_device_bringup(devices.size());
+    bringup.bring_up_mmio_devices(devices, steps);
+    ASSERT_EQ(bringup.get_phase_timings().size(), 4);
+    ASSERT_EQ(bringup.get_phase_timings().back().phase, "open_hugepage_fds");
+}
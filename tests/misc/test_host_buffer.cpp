@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "device/tt_host_buffer.h"
+
+TEST(HostBuffer, BuffersAreMappedInPages) {
+    tt_host_buffer buffer = tt_host_buffer(5000, tt_host_memory_placement{});
+    ASSERT_EQ(buffer.size(), 5000);
+    ASSERT_NE(buffer.data(), nullptr);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % sysconf(_SC_PAGESIZE), 0);
+    ASSERT_FALSE(buffer.is_numa_bound());
+    ASSERT_FALSE(buffer.is_hugepage_backed());
+    std::memset(buffer.data(), 0xab, buffer.size());
+
+    tt_host_buffer moved = std::move(buffer);
+    ASSERT_EQ(buffer.data(), nullptr);
+    ASSERT_EQ(buffer.size(), 0);
+    ASSERT_EQ(static_cast<std::uint8_t*>(moved.data())[4999], 0xab);
+
+    ASSERT_EQ(tt_host_buffer(0, tt_host_memory_placement{}).data(), nullptr);
+}
+
+TEST(HostBuffer, HugepageBuffersAreMappedIn2MBUnits) {
+    tt_host_memory_placement placement = {};
+    placement.use_hugepages = true;
+    // Backed by transparent hugepages when no 2MB hugepages are reserved
+    tt_host_memory_mapping mapping = tt_map_host_memory(TT_HOST_BUFFER_HUGEPAGE_SIZE + 1, placement);
+    ASSERT_NE(mapping.addr, nullptr);
+    ASSERT_EQ(mapping.size, 2 * TT_HOST_BUFFER_HUGEPAGE_SIZE);
+    std::memset(mapping.addr, 0, mapping.size);
+    tt_unmap_host_memory(mapping.addr, TT_HOST_BUFFER_HUGEPAGE_SIZE + 1, placement);
+}
+
+TEST(HostBuffer, DevicesWithoutKnownNumaNodeGetUnboundMemory) {
+    tt_host_memory_placement placement = {};
+    placement.physical_device_id = 1000;
+    tt_host_buffer buffer = tt_host_buffer(4096, placement);
+    ASSERT_NE(buffer.data(), nullptr);
+    ASSERT_FALSE(buffer.is_numa_bound());
+    std::memset(buffer.data(), 0, buffer.size());
+}
+
+TEST(HostBuffer, NumaVectorsKeepTheirPlacement) {
+    tt_host_memory_placement placement = {};
+    placement.physical_device_id = 1000;
+    placement.use_hugepages = true;
+    tt::numa_vector vec = tt::numa_vector(tt::numa_allocator(placement));
+    for (std::uint32_t i = 0; i < 100000; i++) {
+        vec.push_back(i);
+    }
+    tt::numa_vector copy = vec;
+    ASSERT_EQ(copy.get_allocator().get_placement(), placement);
+    ASSERT_TRUE(std::equal(copy.begin(), copy.end(), vec.begin(), vec.end()));
+
+    tt::numa_vector assigned = {};
+    assigned = copy;
+    ASSERT_EQ(assigned.get_allocator(), vec.get_allocator());
+    ASSERT_NE(assigned.get_allocator(), tt::numa_allocator());
+    // Rebound allocators share the placement
+    ASSERT_EQ(tt::basic_numa_allocator<std::uint8_t>(vec.get_allocator()).get_placement(), placement);
+}
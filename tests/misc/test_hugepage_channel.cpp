@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <sys/mman.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "device/tt_hugepage_channel.h"
+#include "tests/test_utils/hugepage_model.hpp"
+
+TEST(HugepageChannel, IOMMUPinsChannelAsOneRange) {
+    constexpr std::uint64_t channel_size = 64 * 1024 * 1024;
+    test_utils::hugepage_model model = {};
+    model.iommu = true;
+    const tt_hugepage_channel channel = tt_map_hugepage_channel(model.get_ops(), 0, channel_size, model.page_size);
+
+    ASSERT_TRUE(channel.is_valid());
+    ASSERT_EQ(model.pins.size(), 1);
+    ASSERT_EQ(model.pins[0].offset, 0);
+    ASSERT_EQ(model.pins[0].size, channel_size);
+    ASSERT_EQ(channel.get_iova(0x1234), channel.iova + 0x1234);
+    ASSERT_EQ(channel.get_host_address(channel_size - 1), static_cast<std::uint8_t*>(channel.mapping) + channel_size - 1);
+    ASSERT_THROW(channel.get_host_address(channel_size), std::runtime_error);
+    ASSERT_THROW(channel.get_iova(channel_size), std::runtime_error);
+    munmap(channel.mapping, channel.size);
+}
+
+TEST(HugepageChannel, PhysicallyContiguousChannelIsPinnedWithoutIOMMU) {
+    constexpr std::size_t page_size = 2 << 20;
+    test_utils::hugepage_model model = {};
+    model.physical_runs = {32};
+    const tt_hugepage_channel channel = tt_map_hugepage_channel(model.get_ops(), 0, 32 * page_size, page_size);
+
+    ASSERT_TRUE(channel.is_valid());
+    ASSERT_EQ(model.pins.size(), 1);
+    ASSERT_EQ(channel.iova, test_utils::hugepage_model::get_physical_address(0));
+    ASSERT_EQ(channel.get_iova(13 * page_size + 8), test_utils::hugepage_model::get_physical_address(0) + 13 * page_size + 8);
+    munmap(channel.mapping, channel.size);
+}
+
+TEST(HugepageChannel, ChannelsThatDontFitOneiATURegionAreUnmapped) {
+    constexpr std::size_t page_size = 2 << 20;
+    test_utils::hugepage_model model = {};
+    // Scattered 2MB pages without an IOMMU can't be pinned as one range, and the channel isn't split.
+    model.physical_runs = {8, 8, 8, 8};
+    ASSERT_FALSE(tt_map_hugepage_channel(model.get_ops(), 0, 32 * page_size, page_size).is_valid());
+    ASSERT_EQ(model.pins.size(), 1);
+    ASSERT_EQ(model.num_unmaps, model.num_maps);
+
+    model.has_mount = false;
+    ASSERT_FALSE(tt_map_hugepage_channel(model.get_ops(), 0, 32 * page_size, page_size).is_valid());
+    ASSERT_EQ(model.num_maps, 1);
+}
+
+TEST(HugepageChannel, ConcurrentFirstTouchLoadsChannelOnce) {
+    std::mutex loads_mutex;
+    std::map<std::pair<chip_id_t, std::uint16_t>, int> loads = {};
+    std::atomic<bool> loaded = false;
+    tt_hugepage_channel_loader loader = {};
+    loader.start(tt_hugepage_init_mode::OnFirstUse, {0, 1}, 2, [&] (chip_id_t device, std::uint16_t channel) {
+        {
+            const std::lock_guard<std::mutex> lock(loads_mutex);
+            loads[{device, channel}]++;
+        }
+        // Give other threads time to touch the channel while it is loading
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (device == 1 && channel == 1) {
+            loaded = true;
+        }
+    });
+    ASSERT_FALSE(loader.is_ready(1, 1));
+
+    std::vector<std::thread> threads = {};
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&] {
+            loader.wait_for_channel(1, 1);
+            // Every thread returns only once the channel is loaded
+            EXPECT_TRUE(loaded.load());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(loads.size(), 1);
+    ASSERT_EQ(loads.at({1, 1}), 1);
+    ASSERT_TRUE(loader.is_ready(1, 1));
+    ASSERT_FALSE(loader.is_ready(0, 0));
+    // Channels the loader doesn't manage are always ready
+    loader.wait_for_channel(2, 0);
+    ASSERT_TRUE(loader.is_ready(0, 3));
+}
+
+TEST(HugepageChannel, BackgroundLoadDoesntBlockReadyChannels) {
+    std::atomic<bool> release_channel_1 = false;
+    std::atomic<int> num_loads = 0;
+    tt_hugepage_channel_loader loader = {};
+    loader.start(tt_hugepage_init_mode::Background, {0}, 2, [&] (chip_id_t device, std::uint16_t channel) {
+        while (channel == 1 && !release_channel_1) {
+            std::this_thread::yield();
+        }
+        num_loads++;
+    });
+
+    // Channel 0 becomes ready while the background thread is stuck on channel 1
+    loader.wait_for_channel(0, 0);
+    ASSERT_FALSE(loader.is_ready(0, 1));
+    std::thread waiter([&] { loader.wait_for_channel(0, 1); });
+    release_channel_1 = true;
+    waiter.join();
+    ASSERT_TRUE(loader.is_ready(0, 1));
+    ASSERT_EQ(num_loads, 2);
+}
+
+TEST(HugepageChannel, LoadErrorsAreRethrownToEveryAccessor) {
+    int num_loads = 0;
+    tt_hugepage_channel_loader loader = {};
+    loader.start(tt_hugepage_init_mode::Background, {0}, 2, [&] (chip_id_t device, std::uint16_t channel) {
+        num_loads++;
+        if (channel == 0) {
+            throw std::runtime_error("no hugepages");
+        }
+    });
+    ASSERT_THROW(loader.wait_for_channel(0, 0), std::runtime_error);
+    ASSERT_THROW(loader.wait_for_channel(0, 0), std::runtime_error);
+    loader.wait_for_channel(0, 1);
+    loader.stop();
+    ASSERT_EQ(num_loads, 2);
+
+    tt_hugepage_channel_loader eager_loader = {};
+    ASSERT_THROW(eager_loader.start(tt_hugepage_init_mode::Eager, {0}, 1, [] (chip_id_t, std::uint16_t) { throw std::runtime_error("no hugepages"); }), std::runtime_error);
+}
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "device/cpuset_lib.hpp"
+#include "device/tt_io_worker_pool.h"
+#include "tests/test_utils/hwloc_topology_model.hpp"
+
+TEST(IOWorkerCpus, WorkersAreSpreadOverTheL3sOfTheDevicePackage) {
+    test_utils::hwloc_topology_model host = {};
+    host.num_packages = 2;
+    host.num_l3_per_package = 2;
+    host.num_cores_per_l3 = 4;
+    host.num_pus_per_core = 2;
+    host.pci_devices = {{"0000:41:00.0", 0}, {"0000:c1:00.0", 1}};
+    hwloc_topology_t topology = host.load();
+
+    // Package 1 has cores 8-11 under its first L3 and cores 12-15 under its second one.
+    auto cpus = tt::cpuset::get_io_worker_cpus(topology, host.get_pci_device("0000:c1:00.0"), 4);
+    ASSERT_EQ(cpus, std::vector<int>({host.get_first_pu_of_core(8), host.get_first_pu_of_core(12), host.get_first_pu_of_core(9), host.get_first_pu_of_core(13)}));
+
+    cpus = tt::cpuset::get_io_worker_cpus(topology, host.get_pci_device("0000:41:00.0"), 2);
+    ASSERT_EQ(cpus, std::vector<int>({host.get_first_pu_of_core(0), host.get_first_pu_of_core(4)}));
+}
+
+TEST(IOWorkerCpus, WorkersWrapAroundOnceEveryCoreHasOne) {
+    test_utils::hwloc_topology_model host = {};
+    host.num_packages = 2;
+    host.num_l3_per_package = 2;
+    host.num_cores_per_l3 = 2;
+    host.num_pus_per_core = 2;
+    host.pci_devices = {{"0000:c1:00.0", 1}};
+    hwloc_topology_t topology = host.load();
+
+    const auto cpus = tt::cpuset::get_io_worker_cpus(topology, host.get_pci_device("0000:c1:00.0"), 6);
+    ASSERT_EQ(cpus, std::vector<int>({host.get_first_pu_of_core(4), host.get_first_pu_of_core(6), host.get_first_pu_of_core(5), host.get_first_pu_of_core(7),
+                                      host.get_first_pu_of_core(4), host.get_first_pu_of_core(6)}));
+    // SMT siblings are never used
+    for (const int cpu : cpus) {
+        ASSERT_EQ(cpu % host.num_pus_per_core, 0);
+    }
+}
+
+TEST(IOWorkerCpus, DevicesWithoutPackageUseAllCpus) {
+    test_utils::hwloc_topology_model host = {};
+    host.num_packages = 2;
+    host.num_l3_per_package = 1;
+    host.num_cores_per_l3 = 2;
+    host.num_pus_per_core = 1;
+    host.pci_devices = {{"0000:05:00.0", -1}};
+    hwloc_topology_t topology = host.load();
+
+    const std::vector<int> all_packages = {host.get_first_pu_of_core(0), host.get_first_pu_of_core(2), host.get_first_pu_of_core(1), host.get_first_pu_of_core(3)};
+    ASSERT_EQ(tt::cpuset::get_io_worker_cpus(topology, host.get_pci_device("0000:05:00.0"), 4), all_packages);
+    // Devices that aren't in the topology
+    ASSERT_EQ(tt::cpuset::get_io_worker_cpus(topology, nullptr, 4), all_packages);
+    ASSERT_TRUE(tt::cpuset::get_io_worker_cpus(topology, nullptr, 0).empty());
+}
+
+TEST(IOWorkerCpus, CoresOfThePackageAreUsedInOrderWithoutL3) {
+    test_utils::hwloc_topology_model host = {};
+    host.num_packages = 2;
+    host.num_l3_per_package = 0;
+    host.num_cores_per_l3 = 3;
+    host.num_pus_per_core = 2;
+    host.pci_devices = {{"0000:c1:00.0", 1}};
+    hwloc_topology_t topology = host.load();
+
+    const auto cpus = tt::cpuset::get_io_worker_cpus(topology, host.get_pci_device("0000:c1:00.0"), 4);
+    ASSERT_EQ(cpus, std::vector<int>({host.get_first_pu_of_core(3), host.get_first_pu_of_core(4), host.get_first_pu_of_core(5), host.get_first_pu_of_core(3)}));
+}
+
+TEST(IOWorkerPool, EachWorkerIsPinnedOnce) {
+    std::mutex pinned_mutex;
+    std::vector<std::size_t> pinned = {};
+    {
+        tt_io_worker_pool pool = tt_io_worker_pool(3, [&] (std::size_t worker) {
+            const std::lock_guard<std::mutex> lock(pinned_mutex);
+            pinned.push_back(worker);
+        });
+        ASSERT_EQ(pool.get_num_workers(), 3);
+    }
+    std::sort(pinned.begin(), pinned.end());
+    ASSERT_EQ(pinned, std::vector<std::size_t>({0, 1, 2}));
+}
+
+TEST(IOWorkerPool, TasksRunOnWorkers) {
+    tt_io_worker_pool pool = tt_io_worker_pool(2);
+    ASSERT_FALSE(tt_io_worker_pool::is_worker_thread());
+
+    std::atomic<int> num_on_workers = 0;
+    std::vector<std::future<void>> done = {};
+    for (int i = 0; i < 16; i++) {
+        done.push_back(pool.submit([&] {
+            if (tt_io_worker_pool::is_worker_thread()) {
+                num_on_workers++;
+            }
+        }));
+    }
+    for (auto& task : done) {
+        task.get();
+    }
+    ASSERT_EQ(num_on_workers, 16);
+}
+
+TEST(IOWorkerPool, ExceptionsAreRethrownByTheFuture) {
+    tt_io_worker_pool pool = tt_io_worker_pool(1);
+    auto failed = pool.submit([] { throw std::runtime_error("transfer failed"); });
+    auto succeeded = pool.submit([] {});
+    ASSERT_THROW(failed.get(), std::runtime_error);
+    // The worker keeps running tasks after one threw
+    succeeded.get();
+}
+
+TEST(IOWorkerPool, QueuedTasksRunBeforeTheWorkersStop) {
+    std::atomic<int> num_done = 0;
+    {
+        tt_io_worker_pool pool = tt_io_worker_pool(1);
+        pool.submit([] { std::this_thread::sleep_for(std::chrono::milliseconds(10)); });
+        for (int i = 0; i < 8; i++) {
+            pool.submit([&] { num_done++; });
+        }
+    }
+    ASSERT_EQ(num_done, 8);
+}
+
+TEST(IOWorkerPool, TaskGroupsCompleteOnceEveryTaskRan) {
+    tt_io_worker_pool first_device = tt_io_worker_pool(1);
+    tt_io_worker_pool second_device = tt_io_worker_pool(2);
+    std::atomic<int> num_done = 0;
+    std::future<void> done;
+    {
+        tt_io_task_group group = tt_io_task_group(3);
+        done = group.get_future();
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        first_device.submit(group.wrap([&, released] { released.wait(); num_done++; }));
+        second_device.submit(group.wrap([&] { num_done++; }));
+        second_device.submit(group.wrap([&] { num_done++; }));
+        // The group isn't done while one of its tasks is still waiting
+        ASSERT_EQ(done.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+        release.set_value();
+    }
+    done.get();
+    ASSERT_EQ(num_done, 3);
+
+    // Empty groups are done right away
+    tt_io_task_group empty = tt_io_task_group(0);
+    ASSERT_EQ(empty.get_future().wait_for(std::chrono::seconds(0)), std::future_status::ready);
+}
+
+TEST(IOWorkerPool, TaskGroupsRethrowTheFirstErrorOnceEveryTaskRan) {
+    tt_io_worker_pool pool = tt_io_worker_pool(1);
+    std::atomic<int> num_done = 0;
+    tt_io_task_group group = tt_io_task_group(3);
+    pool.submit(group.wrap([] { throw std::runtime_error("first"); }));
+    pool.submit(group.wrap([] { throw std::logic_error("second"); }));
+    pool.submit(group.wrap([&] { num_done++; }));
+    ASSERT_THROW(group.get_future().get(), std::runtime_error);
+    ASSERT_EQ(num_done, 1);
+}
@@ -0,0 +1,355 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tt_device.h"
+
+#include "device/tt_membar.h"
+#include "tests/test_utils/generate_cluster_desc.hpp"
+#include "tests/test_utils/membar_device_model.hpp"
+
+namespace {
+std::unordered_set<tt_xy_pair> get_worker_cores(const tt_SocDescriptor& sdesc) {
+    std::unordered_set<tt_xy_pair> cores = {};
+    for (const auto& core : sdesc.workers) {
+        cores.insert(core);
+    }
+    return cores;
+}
+
+// Barrier flag addresses of the WH address maps
+constexpr std::uint32_t L1_BARRIER_BASE = 0x16dfc0;
+constexpr std::uint32_t ERISC_BARRIER_BASE = 0x11FE0;
+}
+
+TEST(MemBar, AllFlagsArePostedBeforePolling) {
+    const auto cores = get_worker_cores(tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml")));
+    test_utils::membar_device_model device;
+    device.visibility_delay = 3;
+    tt_set_membar_flag(device, cores, L1_BARRIER_BASE, 187);
+
+    for (const auto& core : cores) {
+        ASSERT_EQ(device.get_word(core, L1_BARRIER_BASE), 187);
+    }
+    ASSERT_EQ(device.num_writes, cores.size());
+    // Every write is in flight before the first poll, so each core is read visibility_delay + 1 times.
+    ASSERT_EQ(device.num_reads, cores.size() * (device.visibility_delay + 1));
+    for (std::size_t i = 0; i < cores.size(); i++) {
+        ASSERT_TRUE(device.accesses.at(i).is_write);
+    }
+    for (std::size_t i = cores.size(); i < device.accesses.size(); i++) {
+        ASSERT_FALSE(device.accesses.at(i).is_write);
+    }
+    ASSERT_EQ(device.num_flushes, 1);
+    ASSERT_EQ(device.num_fences, 1);
+}
+
+TEST(MemBar, CoresArePolledUntilTheirFlagLands) {
+    const std::unordered_set<tt_xy_pair> cores = {tt_xy_pair(1, 1), tt_xy_pair(2, 1)};
+    test_utils::membar_device_model device;
+    device.visibility_delay = 4;
+
+    tt_set_membar_flag(device, cores, 0, 7);
+    std::map<tt_xy_pair, int> reads_per_core = {};
+    for (const auto& access : device.accesses) {
+        if (!access.is_write) {
+            reads_per_core[access.core]++;
+        }
+    }
+    ASSERT_EQ(reads_per_core.at(tt_xy_pair(1, 1)), 5);
+    ASSERT_EQ(reads_per_core.at(tt_xy_pair(2, 1)), 5);
+
+    // A barrier on more cores than the bitmap can track is rejected.
+    std::unordered_set<tt_xy_pair> too_many_cores = {};
+    for (std::size_t i = 0; i <= TT_MEMBAR_MAX_CORES; i++) {
+        too_many_cores.insert(tt_xy_pair(i, 0));
+    }
+    ASSERT_THROW(tt_set_membar_flag(device, too_many_cores, 0, 7), std::runtime_error);
+}
+
+TEST(MemBar, MulticastFlagReachesOnlyTargetCores) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto workers = get_worker_cores(sdesc);
+    test_utils::membar_device_model device;
+    device.multicast_cores = workers;
+    device.visibility_delay = 1;
+    tt_set_membar_flag(device, workers, L1_BARRIER_BASE, 187);
+
+    // Workers are split into 4 blocks by the DRAM column and the ethernet row, each taking one multicast.
+    ASSERT_EQ(device.num_multicasts, 4);
+    ASSERT_EQ(device.num_writes, 0);
+    std::unordered_set<tt_xy_pair> written_cores = {};
+    for (const auto& access : device.accesses) {
+        if (access.is_write) {
+            written_cores.insert(access.core);
+        }
+    }
+    ASSERT_EQ(written_cores, workers);
+    for (const auto& core : workers) {
+        ASSERT_EQ(device.get_word(core, L1_BARRIER_BASE), 187);
+    }
+    ASSERT_EQ(device.num_reads, 2 * workers.size());
+}
+
+TEST(MemBar, IrregularCoreSetsFallBackToUnicast) {
+    // An L shape, an isolated core and an ethernet core, which can't be multicast to.
+    const std::unordered_set<tt_xy_pair> cores = {
+        tt_xy_pair(1, 1), tt_xy_pair(2, 1), tt_xy_pair(3, 1), tt_xy_pair(1, 2), tt_xy_pair(1, 3), tt_xy_pair(7, 4), tt_xy_pair(1, 0)};
+    test_utils::membar_device_model device;
+    for (std::size_t x = 1; x < 10; x++) {
+        for (std::size_t y = 1; y < 6; y++) {
+            device.multicast_cores.insert(tt_xy_pair(x, y));
+        }
+    }
+    tt_set_membar_flag(device, cores, 0, 5);
+
+    std::unordered_set<tt_xy_pair> written_cores = {};
+    for (const auto& access : device.accesses) {
+        if (access.is_write) {
+            ASSERT_TRUE(written_cores.insert(access.core).second) << "Core " << access.core.str() << " was written more than once";
+        }
+    }
+    ASSERT_EQ(written_cores, cores);
+    ASSERT_EQ(device.num_multicasts, 2);
+    ASSERT_EQ(device.num_writes, 2);
+    // Cores next to the target set never see the flag.
+    ASSERT_EQ(device.get_word(tt_xy_pair(2, 2), 0), 0);
+    ASSERT_EQ(device.get_word(tt_xy_pair(7, 5), 0), 0);
+
+    const auto grids = tt_get_multicast_grids({tt_xy_pair(1, 1), tt_xy_pair(2, 1), tt_xy_pair(1, 2), tt_xy_pair(2, 2), tt_xy_pair(3, 2)});
+    ASSERT_EQ(grids.size(), 1);
+    ASSERT_EQ(grids.at(0).start, tt_xy_pair(1, 1));
+    ASSERT_EQ(grids.at(0).end, tt_xy_pair(2, 2));
+}
+
+TEST(MemBar, DirtyCoresAreTakenOnce) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto workers = get_worker_cores(sdesc);
+    const std::unordered_set<tt_xy_pair> dram_cores = {tt_xy_pair(0, 0), tt_xy_pair(0, 1), tt_xy_pair(5, 0)};
+    tt_membar_dirty_cores dirty_cores = tt_membar_dirty_cores(sdesc.grid_size);
+
+    const std::unordered_set<tt_xy_pair> written_workers = {tt_xy_pair(1, 1), tt_xy_pair(6, 7), tt_xy_pair(9, 11)};
+    for (const auto& core : written_workers) {
+        dirty_cores.mark(core);
+        dirty_cores.mark(core);
+    }
+    dirty_cores.mark(tt_xy_pair(5, 0));
+
+    ASSERT_EQ(dirty_cores.take(workers), written_workers);
+    ASSERT_TRUE(dirty_cores.take(workers).empty()) << "Barriers clear the cores they flush";
+    ASSERT_EQ(dirty_cores.take(dram_cores), std::unordered_set<tt_xy_pair>({tt_xy_pair(5, 0)}));
+
+    // Explicit barriers clear only the cores they target
+    dirty_cores.mark(tt_xy_pair(1, 1));
+    dirty_cores.mark(tt_xy_pair(2, 1));
+    dirty_cores.clear({tt_xy_pair(1, 1)});
+    ASSERT_FALSE(dirty_cores.is_dirty(tt_xy_pair(1, 1)));
+    ASSERT_TRUE(dirty_cores.is_dirty(tt_xy_pair(2, 1)));
+
+    dirty_cores.mark_all();
+    ASSERT_EQ(dirty_cores.take(workers), workers);
+    ASSERT_THROW(dirty_cores.mark(tt_xy_pair(sdesc.grid_size.x, 0)), std::runtime_error);
+    ASSERT_THROW(tt_membar_dirty_cores(tt_xy_pair(17, 16)), std::runtime_error);
+}
+
+TEST(MemBar, DirtyCoresMarkedConcurrently) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto workers = get_worker_cores(sdesc);
+    const std::vector<tt_xy_pair> worker_list(workers.begin(), workers.end());
+    tt_membar_dirty_cores dirty_cores = tt_membar_dirty_cores(sdesc.grid_size);
+
+    constexpr int num_threads = 4;
+    std::vector<std::thread> threads = {};
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = t; i < worker_list.size(); i += num_threads) {
+                dirty_cores.mark(worker_list.at(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(dirty_cores.take(workers), workers);
+}
+
+TEST(MemBar, DirtyCoresCoverMulticastsAndUntrackedWriters) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto workers = get_worker_cores(sdesc);
+    tt_membar_dirty_cores dirty_cores = tt_membar_dirty_cores(sdesc.grid_size);
+
+    // Multicasts mark their whole rectangle, clamped to the grid
+    dirty_cores.mark_grid(tt_xy_pair(1, 1), tt_xy_pair(2, 2));
+    ASSERT_EQ(dirty_cores.take(workers), std::unordered_set<tt_xy_pair>({tt_xy_pair(1, 1), tt_xy_pair(2, 1), tt_xy_pair(1, 2), tt_xy_pair(2, 2)}));
+    dirty_cores.mark_grid(tt_xy_pair(9, 11), tt_xy_pair(20, 20));
+    ASSERT_EQ(dirty_cores.take(workers), std::unordered_set<tt_xy_pair>({tt_xy_pair(9, 11)}));
+
+    // Cores written through a static TLB writer are flushed by every barrier
+    dirty_cores.pin(tt_xy_pair(3, 3));
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(dirty_cores.take(workers), std::unordered_set<tt_xy_pair>({tt_xy_pair(3, 3)}));
+    }
+    dirty_cores.clear({tt_xy_pair(3, 3)});
+    ASSERT_TRUE(dirty_cores.is_dirty(tt_xy_pair(3, 3)));
+
+    // A barrier taking the cores while a write is being issued flushes the core, and the next barrier does too
+    dirty_cores.mark(tt_xy_pair(4, 4));
+    ASSERT_TRUE(dirty_cores.take(workers).count(tt_xy_pair(4, 4)));
+    dirty_cores.mark(tt_xy_pair(4, 4));
+    ASSERT_TRUE(dirty_cores.take(workers).count(tt_xy_pair(4, 4)));
+    ASSERT_FALSE(dirty_cores.take(workers).count(tt_xy_pair(4, 4)));
+}
+
+TEST(MemBar, DirtyTrackingOnlyFlushesWrittenCores) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto workers = get_worker_cores(sdesc);
+    tt_membar_dirty_cores dirty_cores = tt_membar_dirty_cores(sdesc.grid_size);
+    const std::vector<tt_xy_pair> written_workers = {tt_xy_pair(1, 1), tt_xy_pair(2, 1), tt_xy_pair(3, 1)};
+    constexpr int num_barriers = 20;
+
+    test_utils::membar_device_model device;
+    for (int i = 0; i < num_barriers; i++) {
+        for (const auto& core : written_workers) {
+            dirty_cores.mark(core);
+        }
+        const auto cores = dirty_cores.take(workers);
+        tt_set_membar_flag(device, cores, L1_BARRIER_BASE, tt_MemBarFlag::SET);
+        tt_set_membar_flag(device, cores, L1_BARRIER_BASE, tt_MemBarFlag::RESET);
+    }
+    ASSERT_EQ(device.num_writes, 2 * num_barriers * written_workers.size());
+}
+
+TEST(MemBar, SplitPhaseBarrierCompletesIncrementally) {
+    test_utils::membar_device_model device;
+    device.visibility_delay = 2;
+    tt_membar_sequence sequence = tt_membar_sequence(0);
+    tt_membar_token token = {};
+    token.sequence = sequence.next();
+    token.targets = {
+        {tt_xy_pair(1, 1), L1_BARRIER_BASE},
+        {tt_xy_pair(2, 1), L1_BARRIER_BASE},
+        {tt_xy_pair(1, 0), ERISC_BARRIER_BASE},
+        {tt_xy_pair(0, 0), 0}};
+
+    tt_begin_membar(device, token);
+    ASSERT_EQ(device.num_writes, token.targets.size());
+    ASSERT_EQ(device.num_reads, 0) << "begin must not wait for acknowledgement";
+    ASSERT_FALSE(token.is_complete());
+
+    // Every test polls each pending core once, so the host is free between calls.
+    ASSERT_FALSE(tt_test_membar(device, token, sequence));
+    ASSERT_FALSE(tt_test_membar(device, token, sequence));
+    ASSERT_EQ(device.num_reads, 2 * token.targets.size());
+    ASSERT_TRUE(tt_test_membar(device, token, sequence));
+    ASSERT_EQ(device.num_fences, 1);
+    for (const auto& target : token.targets) {
+        ASSERT_EQ(device.get_word(target.core, target.address), token.sequence);
+    }
+
+    // Completed barriers don't touch the device again.
+    device.reset_counters();
+    ASSERT_TRUE(tt_test_membar(device, token, sequence));
+    ASSERT_EQ(device.num_reads, 0);
+}
+
+TEST(MemBar, SplitPhaseBarriersCanOverlap) {
+    const std::unordered_set<tt_xy_pair> cores = {tt_xy_pair(1, 1), tt_xy_pair(2, 1), tt_xy_pair(3, 1)};
+    test_utils::membar_device_model device;
+    device.multicast_cores = cores;
+    tt_membar_sequence sequence = tt_membar_sequence(0x7fffffff); // wraps around
+    tt_membar_token first = {};
+    tt_membar_token second = {};
+    for (auto* token : {&first, &second}) {
+        token->sequence = sequence.next();
+        for (const auto& core : cores) {
+            token->targets.push_back({core, 0});
+        }
+        tt_begin_membar(device, *token);
+    }
+    ASSERT_EQ(device.num_multicasts, 2);
+    ASSERT_NE(first.sequence, second.sequence);
+
+    // The second barrier overwrote the flags of the first one, which acknowledges both.
+    ASSERT_TRUE(tt_test_membar(device, first, sequence));
+    ASSERT_TRUE(tt_test_membar(device, second, sequence));
+
+    // Blocking barrier flags and values from other sequences don't acknowledge a barrier.
+    ASSERT_FALSE(sequence.acknowledges(tt_MemBarFlag::SET, second.sequence));
+    ASSERT_FALSE(sequence.acknowledges(tt_MemBarFlag::RESET, second.sequence));
+    ASSERT_FALSE(sequence.acknowledges(first.sequence, second.sequence));
+    ASSERT_FALSE(sequence.acknowledges(second.sequence + 1, second.sequence));
+    ASSERT_TRUE(sequence.acknowledges(second.sequence, first.sequence));
+}
+
+TEST(MemBar, SplitPhaseBarrierTimesOutWhenItsFlagIsOverwritten) {
+    test_utils::membar_device_model device;
+    tt_membar_sequence sequence = tt_membar_sequence(0);
+    int num_in_flight = 1;
+    int num_completed = 0;
+    const auto release = [&num_in_flight, &num_completed] (tt_membar_in_flight* state) {
+        num_in_flight--;
+        num_completed += state->completed;
+        delete state;
+    };
+    tt_membar_token token = {};
+    token.sequence = sequence.next();
+    token.targets = {{tt_xy_pair(1, 1), L1_BARRIER_BASE}, {tt_xy_pair(2, 1), L1_BARRIER_BASE}};
+    token.in_flight = std::shared_ptr<tt_membar_in_flight>(new tt_membar_in_flight(), release);
+
+    tt_begin_membar(device, token);
+    ASSERT_GT(token.deadline, std::chrono::steady_clock::now());
+    // A blocking barrier (or another process) overwrote one of the flags before it was acknowledged
+    tt_set_membar_flag(device, {tt_xy_pair(2, 1)}, L1_BARRIER_BASE, tt_MemBarFlag::RESET);
+    ASSERT_FALSE(tt_test_membar(device, token, sequence));
+    ASSERT_EQ(num_in_flight, 1);
+
+    token.deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    ASSERT_THROW(tt_test_membar(device, token, sequence), std::runtime_error);
+    ASSERT_THROW(tt_test_membar(device, token, sequence), std::runtime_error) << "Keeps throwing once timed out";
+    ASSERT_EQ(num_in_flight, 0) << "Timed out barriers are no longer in flight";
+    ASSERT_EQ(num_completed, 0) << "Timed out barriers didn't complete";
+
+    // Completed barriers release their in flight marker, and don't time out afterwards
+    tt_membar_token completed = {};
+    completed.sequence = sequence.next();
+    completed.targets = {{tt_xy_pair(1, 1), L1_BARRIER_BASE}};
+    completed.in_flight = std::shared_ptr<tt_membar_in_flight>(new tt_membar_in_flight(), release);
+    num_in_flight = 1;
+    tt_begin_membar(device, completed);
+    ASSERT_TRUE(tt_test_membar(device, completed, sequence));
+    ASSERT_EQ(num_in_flight, 0);
+    ASSERT_EQ(num_completed, 1);
+    completed.deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    ASSERT_TRUE(tt_test_membar(device, completed, sequence));
+}
+
+TEST(MemBar, DroppedSplitPhaseBarriersDontComplete) {
+    test_utils::membar_device_model device;
+    tt_membar_sequence sequence = tt_membar_sequence(0);
+    std::unordered_set<tt_xy_pair> released_cores = {};
+    {
+        tt_membar_token token = {};
+        token.sequence = sequence.next();
+        token.targets = {{tt_xy_pair(1, 1), L1_BARRIER_BASE}};
+        // Like tt_SiliconDevice::begin_membar, hand the cores back to dirty tracking unless the barrier completes
+        token.in_flight = std::shared_ptr<tt_membar_in_flight>(new tt_membar_in_flight(), [&released_cores] (tt_membar_in_flight* state) {
+            if (!state->completed) {
+                released_cores.insert(tt_xy_pair(1, 1));
+            }
+            delete state;
+        });
+        // Dropped while the flag is still in flight
+        device.visibility_delay = 2;
+        tt_begin_membar(device, token);
+        ASSERT_FALSE(tt_test_membar(device, token, sequence));
+    }
+    ASSERT_EQ(released_cores, std::unordered_set<tt_xy_pair>({tt_xy_pair(1, 1)}));
+}
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tt_device.h"
+
+#include "device/tt_membar.h"
+#include "tests/test_utils/generate_cluster_desc.hpp"
+
+namespace {
+std::unordered_set<tt_xy_pair> get_worker_cores(const tt_SocDescriptor& sdesc) {
+    return std::unordered_set<tt_xy_pair>(sdesc.workers.begin(), sdesc.workers.end());
+}
+
+std::unordered_set<tt_xy_pair> get_eth_cores(const tt_SocDescriptor& sdesc) {
+    return std::unordered_set<tt_xy_pair>(sdesc.ethernet_cores.begin(), sdesc.ethernet_cores.end());
+}
+
+// Cores written by a reset, and how many writes it takes.
+std::unordered_set<tt_xy_pair> get_reset_cores(const std::vector<tt_multicast_grid>& grids, const std::vector<tt_xy_pair>& unicast_cores) {
+    std::unordered_set<tt_xy_pair> reset = {};
+    for (const auto& grid : grids) {
+        for (std::size_t y = grid.start.y; y <= grid.end.y; y++) {
+            for (std::size_t x = grid.start.x; x <= grid.end.x; x++) {
+                EXPECT_TRUE(reset.insert(tt_xy_pair(x, y)).second) << "Core reset twice";
+            }
+        }
+    }
+    for (const auto& core : unicast_cores) {
+        EXPECT_TRUE(reset.insert(core).second) << "Core reset twice";
+    }
+    return reset;
+}
+}
+
+TEST(RiscReset, RectanglesAreMulticastAndOtherCoresUnicast) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto workers = get_worker_cores(sdesc);
+    const auto eth_cores = get_eth_cores(sdesc);
+    std::vector<tt_multicast_grid> grids = {};
+    std::vector<tt_xy_pair> unicast_cores = {};
+
+    // All Tensix cores of the chip take one multicast per rectangle, ethernet cores are written one by one.
+    std::unordered_set<tt_xy_pair> cores = workers;
+    cores.insert(eth_cores.begin(), eth_cores.end());
+    tt_SiliconDevice::get_risc_reset_targets(0, workers, eth_cores, cores, true, grids, unicast_cores);
+    ASSERT_EQ(get_reset_cores(grids, unicast_cores), cores);
+    ASSERT_LT(grids.size(), workers.size() / 4);
+    ASSERT_EQ(unicast_cores.size(), eth_cores.size());
+    for (const auto& grid : grids) {
+        ASSERT_GE(grid.num_cores(), 2);
+        for (std::size_t y = grid.start.y; y <= grid.end.y; y++) {
+            for (std::size_t x = grid.start.x; x <= grid.end.x; x++) {
+                ASSERT_TRUE(workers.find(tt_xy_pair(x, y)) != workers.end()) << "Only Tensix cores can be multicast to";
+            }
+        }
+    }
+
+    // A lone core isn't worth a multicast
+    tt_SiliconDevice::get_risc_reset_targets(0, workers, eth_cores, {tt_xy_pair(1, 1)}, true, grids, unicast_cores);
+    ASSERT_TRUE(grids.empty());
+    ASSERT_EQ(unicast_cores, std::vector<tt_xy_pair>({tt_xy_pair(1, 1)}));
+
+    // Remote chips can't be multicast to, so every core costs one round trip.
+    tt_SiliconDevice::get_risc_reset_targets(1, workers, eth_cores, cores, false, grids, unicast_cores);
+    ASSERT_TRUE(grids.empty());
+    ASSERT_EQ(unicast_cores.size(), cores.size());
+    ASSERT_EQ(get_reset_cores(grids, unicast_cores), cores);
+}
+
+TEST(RiscReset, OnlyTensixAndEthernetCoresCanBeReset) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto eth_cores = get_eth_cores(sdesc);
+    std::vector<tt_multicast_grid> grids = {};
+    std::vector<tt_xy_pair> unicast_cores = {};
+
+    // Harvested rows are left out of the chip's workers, like in tt_SiliconDevice::populate_cores.
+    const std::size_t harvested_row = sdesc.workers.front().y;
+    std::unordered_set<tt_xy_pair> workers = {};
+    std::unordered_set<tt_xy_pair> harvested = {};
+    for (const auto& core : sdesc.workers) {
+        (core.y == harvested_row ? harvested : workers).insert(core);
+    }
+    ASSERT_FALSE(harvested.empty());
+    for (const auto& core : harvested) {
+        for (const bool use_multicast : {true, false}) {
+            ASSERT_THROW(tt_SiliconDevice::get_risc_reset_targets(0, workers, eth_cores, {core}, use_multicast, grids, unicast_cores), std::runtime_error)
+                << "Harvested core " << core.str();
+        }
+    }
+
+    for (const auto& core : {sdesc.dram_cores.at(0).at(0), sdesc.arc_cores.at(0), sdesc.pcie_cores.at(0)}) {
+        ASSERT_THROW(tt_SiliconDevice::get_risc_reset_targets(0, workers, eth_cores, {core}, true, grids, unicast_cores), std::runtime_error)
+            << "Core " << core.str();
+    }
+    // A single bad core rejects the whole set
+    std::unordered_set<tt_xy_pair> cores = workers;
+    cores.insert(*harvested.begin());
+    ASSERT_THROW(tt_SiliconDevice::get_risc_reset_targets(0, workers, eth_cores, cores, true, grids, unicast_cores), std::runtime_error);
+}
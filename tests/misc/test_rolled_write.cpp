@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tt_device.h"
+
+#include "device/tt_eth_queue.h"
+#include "tests/test_utils/eth_queue_model.hpp"
+
+namespace {
+// host_mem::address_map and ERISC firmware (eth_interface.h) parameters on WH
+constexpr uint32_t ETH_ROUTING_BLOCK_SIZE = 32 * 1024;
+constexpr uint32_t ETH_ROUTING_BUFFERS_START = 896 * 1024 * 1024;
+constexpr uint32_t CMD_BUF_SIZE = 4;
+
+tt_driver_eth_interface_params get_eth_params() {
+    tt_driver_eth_interface_params eth_params = {};
+    eth_params.cmd_buf_size = CMD_BUF_SIZE;
+    eth_params.cmd_buf_size_mask = CMD_BUF_SIZE - 1;
+    eth_params.cmd_buf_ptr_mask = (CMD_BUF_SIZE << 1) - 1;
+    eth_params.request_cmd_queue_base = 0x11000 + 128;
+    eth_params.cmd_counters_size_bytes = 32;
+    eth_params.remote_update_ptr_size_bytes = 16;
+    eth_params.request_routing_cmd_queue_base = eth_params.request_cmd_queue_base + 2 * 16 + 32;
+    eth_params.cmd_wr_req = 0x1 << 0;
+    eth_params.cmd_data_block_dram = 0x1 << 4;
+    eth_params.cmd_data_block = 0x1 << 6;
+    return eth_params;
+}
+}
+
+TEST(RolledWrite, StagedWriteMatchesPerSlotWrites) {
+    // Emulate a BAR with host memory: the reference writes every slot separately (patching the caller's buffer, as
+    // rolled_write_to_device used to), the staged version writes all slots at once.
+    const uint32_t base = 0x40;
+    for (const uint32_t size_in_bytes : {4u, 16u, 1024u}) {
+        for (const uint32_t unroll_count : {1u, 3u, 64u}) {
+            std::vector<uint32_t> data(size_in_bytes / sizeof(uint32_t));
+            for (std::size_t i = 0; i < data.size(); i++) {
+                data[i] = 0xabcd0000 + i;
+            }
+            const std::vector<uint32_t> original = data;
+            std::vector<uint8_t> reference_bar(base + size_in_bytes * unroll_count + 64, 0xee);
+            std::vector<uint8_t> staged_bar = reference_bar;
+
+            std::vector<uint32_t> reference_data = data;
+            for (uint32_t i = 0; i < unroll_count; i++) {
+                reference_data[0] = i;
+                std::memcpy(reference_bar.data() + base + i * size_in_bytes, reference_data.data(), size_in_bytes);
+            }
+
+            std::vector<uint32_t> staging = {};
+            tt_SiliconDevice::stage_rolled_write(data.data(), size_in_bytes, unroll_count, staging);
+            ASSERT_EQ(staging.size() * sizeof(uint32_t), size_in_bytes * unroll_count);
+            std::memcpy(staged_bar.data() + base, staging.data(), staging.size() * sizeof(uint32_t));
+
+            ASSERT_EQ(staged_bar, reference_bar) << "size " << size_in_bytes << " unroll " << unroll_count;
+            ASSERT_EQ(data, original) << "Caller's buffer was modified";
+        }
+    }
+}
+
+TEST(RolledWrite, StagingBufferIsReused) {
+    const std::vector<uint32_t> data(256, 0x12345678);
+    std::vector<uint32_t>& staging = tt_SiliconDevice::get_rolled_write_staging();
+    ASSERT_EQ(&staging, &tt_SiliconDevice::get_rolled_write_staging());
+
+    tt_SiliconDevice::stage_rolled_write(data.data(), data.size() * sizeof(uint32_t), 64, staging);
+    const uint32_t* buffer = staging.data();
+    for (const uint32_t unroll_count : {1u, 32u, 64u, 7u}) {
+        tt_SiliconDevice::stage_rolled_write(data.data(), data.size() * sizeof(uint32_t), unroll_count, staging);
+        ASSERT_EQ(staging.size(), data.size() * unroll_count);
+        ASSERT_EQ(staging.data(), buffer) << "Writes that fit in the buffer must not reallocate it";
+    }
+
+    // Threads don't share a buffer
+    const std::vector<uint32_t>* other_staging = nullptr;
+    std::thread([&other_staging] { other_staging = &tt_SiliconDevice::get_rolled_write_staging(); }).join();
+    ASSERT_NE(other_staging, &staging);
+}
+
+TEST(RolledWrite, RemoteRolledWriteStagesEachBlockOnce) {
+    // Run the real command loop against emulated ethernet queues, and check what was staged in host memory and what
+    // the firmware copied to the remote core.
+    const uint32_t block_size = ETH_ROUTING_BLOCK_SIZE;
+    const tt_driver_eth_interface_params eth_params = get_eth_params();
+    tt_driver_host_address_params host_params = {};
+    host_params.eth_routing_block_size = block_size;
+    host_params.eth_routing_buffers_start = ETH_ROUTING_BUFFERS_START;
+    constexpr int num_queues = 2;
+    const uint64_t address = 0x100;
+
+    for (const uint32_t size_in_bytes : {32u, 1024u, 12u * 1024u}) {
+        for (const uint32_t unroll_count : {1u, 7u, 100u}) {
+            std::vector<uint32_t> data(size_in_bytes / sizeof(uint32_t));
+            for (std::size_t i = 0; i < data.size(); i++) {
+                data[i] = 0x5a5a0000 + i;
+            }
+            std::vector<uint32_t> expected = {};
+            tt_SiliconDevice::stage_rolled_write(data.data(), size_in_bytes, unroll_count, expected);
+            const std::vector<uint32_t> slots_per_cmd = tt_SiliconDevice::get_rolled_write_commands(size_in_bytes, unroll_count, block_size);
+
+            test_utils::eth_queue_model queues = test_utils::eth_queue_model(eth_params, num_queues);
+            int active_queue = 0;
+            std::vector<uint32_t> staging = {};
+            tt_rolled_write_to_remote(queues, eth_params, host_params, active_queue, data.data(), size_in_bytes, unroll_count, address, staging);
+            queues.drain_all();
+
+            // Each command stages one block, holding as many slots as fit, in its queue's routing buffers
+            ASSERT_EQ(queues.num_commands, slots_per_cmd.size());
+            ASSERT_EQ(queues.sysmem_writes.size(), slots_per_cmd.size());
+            uint64_t bytes_staged = 0;
+            for (std::size_t i = 0; i < queues.sysmem_writes.size(); i++) {
+                const auto& write = queues.sysmem_writes.at(i);
+                ASSERT_EQ(write.size_in_bytes, slots_per_cmd.at(i) * size_in_bytes);
+                ASSERT_LE(write.size_in_bytes, block_size);
+                ASSERT_GE(write.address, ETH_ROUTING_BUFFERS_START);
+                ASSERT_LT(write.address, ETH_ROUTING_BUFFERS_START + num_queues * CMD_BUF_SIZE * block_size);
+                ASSERT_EQ((write.address - ETH_ROUTING_BUFFERS_START) % block_size, 0);
+                bytes_staged += write.size_in_bytes;
+            }
+            ASSERT_EQ(bytes_staged, uint64_t(size_in_bytes) * unroll_count) << "Each slot must be staged exactly once";
+            // The wptr is only published when a queue fills up, and once at the end
+            ASSERT_LE(queues.num_wptr_publishes, queues.num_commands);
+            if (slots_per_cmd.size() < CMD_BUF_SIZE) {
+                ASSERT_EQ(queues.num_wptr_publishes, 1);
+            }
+
+            // Blocks are only reused once the firmware handled them, so the remote core got every slot
+            ASSERT_EQ(queues.remote_memory.size(), address + expected.size() * sizeof(uint32_t));
+            ASSERT_EQ(std::memcmp(queues.remote_memory.data() + address, expected.data(), expected.size() * sizeof(uint32_t)), 0)
+                << "size " << size_in_bytes << " unroll " << unroll_count;
+        }
+    }
+    ASSERT_TRUE(tt_SiliconDevice::get_rolled_write_commands(0, 10, block_size).empty());
+    ASSERT_TRUE(tt_SiliconDevice::get_rolled_write_commands(64, 0, block_size).empty());
+}
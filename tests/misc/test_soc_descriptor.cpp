@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <malloc.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tt_device.h"
+
+#include "tests/test_utils/generate_cluster_desc.hpp"
+
+namespace {
+// Heap bytes allocated and freed by this test binary, used to measure what building the descriptors costs.
+std::atomic<std::size_t> heap_bytes_allocated = 0;
+std::atomic<std::size_t> heap_bytes_freed = 0;
+}
+
+void* operator new(std::size_t size) {
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    heap_bytes_allocated += malloc_usable_size(ptr);
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        heap_bytes_freed += malloc_usable_size(ptr);
+        std::free(ptr);
+    }
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+struct heap_usage {
+    std::size_t allocated = 0;
+    std::size_t held = 0;
+};
+
+// Heap bytes allocated while running build, and bytes still held by what it built once it returns.
+template <typename T, typename F>
+heap_usage measure_heap_usage(T& result, F&& build) {
+    const std::size_t allocated_before = heap_bytes_allocated;
+    const std::size_t freed_before = heap_bytes_freed;
+    result = build();
+    const std::size_t allocated = heap_bytes_allocated - allocated_before;
+    return {allocated, allocated - (heap_bytes_freed - freed_before)};
+}
+
+std::unordered_map<chip_id_t, uint32_t> get_synthetic_harvesting_masks(int num_chips, const std::vector<uint32_t>& masks) {
+    std::unordered_map<chip_id_t, uint32_t> harvesting_masks = {};
+    for(int chip = 0; chip < num_chips; chip++) {
+        harvesting_masks.insert({chip, masks.at(chip % masks.size())});
+    }
+    return harvesting_masks;
+}
+}
+
+TEST(SocDescriptorSharing, SyntheticClusterSharesDescriptorsPerLayout) {
+    // 128 chips with 5 distinct harvesting masks must be backed by 5 descriptors
+    const int num_chips = 128;
+    const std::vector<uint32_t> masks = {0, 1 << 1, 1 << 7, (1 << 1) | (1 << 8), 1 << 11};
+    const std::string sdesc_path = test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml");
+    const auto harvesting_masks = get_synthetic_harvesting_masks(num_chips, masks);
+
+    const tt_soc_descriptor_map sdesc_per_chip = tt_SiliconDevice::create_soc_descriptors(tt::ARCH::WORMHOLE_B0, sdesc_path, harvesting_masks, true);
+    ASSERT_EQ(sdesc_per_chip.size(), num_chips);
+    ASSERT_EQ(sdesc_per_chip.num_unique_descriptors(), masks.size());
+
+    // Each chip must see the same descriptor as if it had been harvested on its own
+    std::unordered_map<uint32_t, tt_SocDescriptor> reference_sdescs = {};
+    for(const auto& mask : masks) {
+        tt_SocDescriptor sdesc = tt_SocDescriptor(sdesc_path);
+        tt_SiliconDevice::harvest_rows_in_soc_descriptor(tt::ARCH::WORMHOLE_B0, sdesc, mask);
+        reference_sdescs.insert({mask, sdesc});
+    }
+    for(int chip = 0; chip < num_chips; chip++) {
+        const auto& expected = reference_sdescs.at(harvesting_masks.at(chip));
+        const tt_SocDescriptor& sdesc = sdesc_per_chip.at(chip);
+        ASSERT_EQ(sdesc.workers, expected.workers) << "Chip " << chip;
+        ASSERT_EQ(sdesc.harvested_workers, expected.harvested_workers) << "Chip " << chip;
+        ASSERT_EQ(sdesc.worker_grid_size, expected.worker_grid_size) << "Chip " << chip;
+        ASSERT_EQ(sdesc.routing_y_to_worker_y, expected.routing_y_to_worker_y) << "Chip " << chip;
+        ASSERT_EQ(sdesc.worker_log_to_routing_y, expected.worker_log_to_routing_y) << "Chip " << chip;
+        for(const auto& [core, core_desc] : expected.cores) {
+            ASSERT_EQ(sdesc.cores.at(core).type, core_desc.type) << "Chip " << chip << " core " << core.str();
+        }
+        // Chips with the same layout point to the same object
+        ASSERT_EQ(&sdesc, &sdesc_per_chip.at(chip % masks.size()));
+    }
+
+    // Copying the map (as get_virtual_soc_descriptor_map() users do) only copies pointers
+    const tt_soc_descriptor_map copy = sdesc_per_chip;
+    for(int chip = 0; chip < num_chips; chip++) {
+        ASSERT_EQ(copy.get_shared(chip), sdesc_per_chip.get_shared(chip));
+    }
+
+    // Without harvesting all chips share the unharvested descriptor
+    const tt_soc_descriptor_map unharvested = tt_SiliconDevice::create_soc_descriptors(tt::ARCH::WORMHOLE_B0, sdesc_path, harvesting_masks, false);
+    ASSERT_EQ(unharvested.num_unique_descriptors(), 1);
+    ASSERT_EQ(unharvested.at(num_chips - 1).workers, tt_SocDescriptor(sdesc_path).workers);
+}
+
+TEST(SocDescriptorSharing, SyntheticClusterMemoryAndStartup) {
+    // A 128 chip cluster must cost about as much as its 5 layouts, both in memory held and in work done at startup
+    const int num_chips = 128;
+    const std::vector<uint32_t> masks = {0, 1 << 1, 1 << 7, (1 << 1) | (1 << 8), 1 << 11};
+    const std::string sdesc_path = test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml");
+    const auto harvesting_masks = get_synthetic_harvesting_masks(num_chips, masks);
+    const auto one_chip_per_layout = get_synthetic_harvesting_masks(masks.size(), masks);
+
+    tt_soc_descriptor_map per_layout = {};
+    const heap_usage layouts_usage = measure_heap_usage(per_layout, [&] {
+        return tt_SiliconDevice::create_soc_descriptors(tt::ARCH::WORMHOLE_B0, sdesc_path, one_chip_per_layout, true);
+    });
+    tt_soc_descriptor_map shared = {};
+    const heap_usage shared_usage = measure_heap_usage(shared, [&] {
+        return tt_SiliconDevice::create_soc_descriptors(tt::ARCH::WORMHOLE_B0, sdesc_path, harvesting_masks, true);
+    });
+    // How descriptors used to be populated: one harvested copy of the descriptor per chip
+    std::unordered_map<chip_id_t, tt_SocDescriptor> per_chip_copies = {};
+    const heap_usage copies_usage = measure_heap_usage(per_chip_copies, [&] {
+        std::unordered_map<chip_id_t, tt_SocDescriptor> copies = {};
+        const auto default_sdesc = tt_SocDescriptor(sdesc_path);
+        for(const auto& [chip, mask] : harvesting_masks) {
+            auto sdesc = default_sdesc;
+            tt_SiliconDevice::harvest_rows_in_soc_descriptor(tt::ARCH::WORMHOLE_B0, sdesc, mask);
+            copies.insert({chip, std::move(sdesc)});
+        }
+        return copies;
+    });
+    ASSERT_EQ(shared.size(), num_chips);
+    ASSERT_EQ(per_chip_copies.size(), num_chips);
+
+    // The extra chips only add map entries and shared pointers, never a descriptor
+    const std::size_t max_bytes_per_extra_chip = 256;
+    const std::size_t extra_chips = num_chips - masks.size();
+    EXPECT_LE(shared_usage.held, layouts_usage.held + extra_chips * max_bytes_per_extra_chip);
+    EXPECT_LE(shared_usage.allocated, layouts_usage.allocated + extra_chips * max_bytes_per_extra_chip);
+    // Per chip copies hold a descriptor for every chip, and allocate at least that much more while starting up
+    const std::size_t descriptor_size = copies_usage.held / num_chips;
+    EXPECT_GT(descriptor_size, max_bytes_per_extra_chip);
+    EXPECT_GT(copies_usage.held, 10 * shared_usage.held);
+    EXPECT_GT(copies_usage.allocated, shared_usage.allocated + extra_chips * descriptor_size);
+}
@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tt_device.h"
+
+#include "device/tt_sysmem_allocator.h"
+#include "device/tt_sysmem_map.h"
+#include "device/tt_sysmem_ring.h"
+#include "device/tt_sysmem_streaming.h"
+
+namespace {
+// Cache line aligned stand-in for a hugepage channel region.
+class sysmem_region {
+    public:
+    explicit sysmem_region(std::size_t size) :
+        region_size(size), bytes(static_cast<std::uint8_t*>(std::aligned_alloc(tt_sysmem_ring::CACHE_LINE_SIZE, (size + 63) / 64 * 64)), std::free) {
+        std::memset(bytes.get(), 0, size);
+    }
+    std::uint8_t* data() const { return bytes.get(); }
+    std::size_t size() const { return region_size; }
+
+    private:
+    std::size_t region_size;
+    std::unique_ptr<std::uint8_t, decltype(&std::free)> bytes;
+};
+
+// Stream num_bytes of a known pattern through a ring from a producer thread to a consumer thread, copying at most
+// chunk_size bytes per reserve/peek.
+void stream_through_sysmem_ring(std::size_t region_size, std::uint64_t num_bytes, std::uint32_t chunk_size, bool device_produces) {
+    sysmem_region region = sysmem_region(region_size);
+    tt_sysmem_ring producer = tt_sysmem_ring(region.data(), region.size(), true);
+    tt_sysmem_ring consumer = tt_sysmem_ring(region.data(), region.size(), false);
+    auto pattern = [] (std::uint64_t i) { return static_cast<std::uint8_t>((i * 7) ^ (i >> 8)); };
+
+    std::atomic<bool> mismatch = false;
+    auto produce = [&] {
+        for (std::uint64_t sent = 0; sent < num_bytes;) {
+            tt_sysmem_span span = producer.reserve(std::min<std::uint64_t>(chunk_size, num_bytes - sent));
+            if (!span.size) {
+                std::this_thread::yield(); // The peer may be sharing this CPU
+                continue;
+            }
+            for (std::uint32_t i = 0; i < span.size; i++) {
+                span.data[i] = pattern(sent + i);
+            }
+            producer.commit(span.size);
+            sent += span.size;
+        }
+    };
+    auto consume = [&] {
+        for (std::uint64_t received = 0; received < num_bytes;) {
+            tt_sysmem_span span = consumer.peek();
+            span.size = std::min(span.size, chunk_size);
+            if (!span.size) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::uint32_t i = 0; i < span.size; i++) {
+                if (span.data[i] != pattern(received + i)) {
+                    mismatch = true;
+                }
+            }
+            consumer.release(span.size);
+            received += span.size;
+        }
+    };
+
+    // The thread standing in for the device is started second, the host side runs on the test thread.
+    std::thread device_thread = device_produces ? std::thread(produce) : std::thread(consume);
+    if (device_produces) {
+        consume();
+    } else {
+        produce();
+    }
+    device_thread.join();
+
+    EXPECT_FALSE(mismatch) << "Data read from the ring does not match what was written";
+    EXPECT_EQ(producer.get_size(), 0);
+}
+}
+
+TEST(SysmemRing, CountersAreOnSeparateCacheLines) {
+    ASSERT_GE(tt_sysmem_ring::TAIL_OFFSET - tt_sysmem_ring::HEAD_OFFSET, tt_sysmem_ring::CACHE_LINE_SIZE);
+    ASSERT_GE(tt_sysmem_ring::DATA_OFFSET - tt_sysmem_ring::TAIL_OFFSET, tt_sysmem_ring::CACHE_LINE_SIZE);
+
+    // Capacity is the largest power of two that fits, so a region that isn't exactly sized wastes the rest.
+    sysmem_region region = sysmem_region(tt_sysmem_ring::get_region_size(4096) + 1000);
+    tt_sysmem_ring ring = tt_sysmem_ring(region.data(), region.size(), true);
+    ASSERT_EQ(ring.get_capacity(), 4096);
+}
+
+TEST(SysmemRing, SpansWrapAroundTheEnd) {
+    sysmem_region region = sysmem_region(tt_sysmem_ring::get_region_size(256));
+    tt_sysmem_ring producer = tt_sysmem_ring(region.data(), region.size(), true);
+    tt_sysmem_ring consumer = tt_sysmem_ring(region.data(), region.size(), false);
+
+    ASSERT_EQ(consumer.peek().size, 0);
+    tt_sysmem_span span = producer.reserve(200);
+    ASSERT_EQ(span.size, 200);
+    ASSERT_EQ(span.data, region.data() + tt_sysmem_ring::DATA_OFFSET);
+    std::memset(span.data, 0xab, span.size);
+    producer.commit(span.size);
+
+    // Only 56 bytes are free until the consumer releases data.
+    ASSERT_EQ(producer.reserve(200).size, 56);
+    ASSERT_EQ(consumer.peek().size, 200);
+    ASSERT_EQ(consumer.peek().data[199], 0xab);
+    consumer.release(150);
+
+    // Free space wraps around, and is handed out in two spans.
+    span = producer.reserve(200);
+    ASSERT_EQ(span.size, 56);
+    producer.commit(span.size);
+    span = producer.reserve(200);
+    ASSERT_EQ(span.size, 150);
+    ASSERT_EQ(span.data, region.data() + tt_sysmem_ring::DATA_OFFSET);
+    producer.commit(span.size);
+    ASSERT_EQ(producer.reserve(1).size, 0);
+
+    ASSERT_EQ(consumer.peek().size, 106);
+    consumer.release(106);
+    ASSERT_EQ(consumer.peek().size, 150);
+    consumer.release(150);
+    ASSERT_EQ(consumer.get_size(), 0);
+
+    // Counters are visible to the device at fixed offsets.
+    std::uint32_t head = 0;
+    std::memcpy(&head, region.data() + tt_sysmem_ring::HEAD_OFFSET, sizeof(head));
+    ASSERT_EQ(head, 406);
+}
+
+TEST(SysmemRing, HostToDeviceStream) {
+    stream_through_sysmem_ring(tt_sysmem_ring::get_region_size(64 * 1024), 16 * 1024 * 1024, 4096, false);
+}
+
+TEST(SysmemRing, DeviceToHostStream) {
+    stream_through_sysmem_ring(tt_sysmem_ring::get_region_size(64 * 1024), 16 * 1024 * 1024, 4096, true);
+    // Odd sized chunks make spans straddle the end of the ring.
+    stream_through_sysmem_ring(tt_sysmem_ring::get_region_size(1024), 1024 * 1024, 333, true);
+}
+
+namespace {
+// Anonymous mapping standing in for a hugepage backed host memory channel.
+class anonymous_channel {
+    public:
+    explicit anonymous_channel(std::size_t size) : size(size) {
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        EXPECT_NE(mapping, MAP_FAILED);
+    }
+    ~anonymous_channel() { munmap(mapping, size); }
+    std::uint8_t* data() const { return static_cast<std::uint8_t*>(mapping); }
+
+    private:
+    void* mapping;
+    std::size_t size;
+};
+}
+
+TEST(SysmemAllocator, AllocationsAreAlignedAndDeviceVisible) {
+    constexpr std::size_t channel_size = 16 * 1024 * 1024;
+    constexpr std::uint64_t device_base = 0x800000000;
+    anonymous_channel channel_0 = anonymous_channel(channel_size);
+    anonymous_channel channel_1 = anonymous_channel(channel_size);
+    tt_sysmem_allocator allocator = {};
+    allocator.add_channel(0, channel_0.data(), channel_size, device_base);
+    allocator.add_channel(1, channel_1.data(), channel_size, device_base + (1 << 30));
+
+    const tt_sysmem_allocation a = allocator.allocate(100, 64);
+    const tt_sysmem_allocation b = allocator.allocate(4096, 4096);
+    ASSERT_TRUE(a.is_valid() && b.is_valid());
+    ASSERT_EQ(a.channel, 0);
+    ASSERT_EQ(a.host_ptr, channel_0.data());
+    ASSERT_EQ(a.device_address, device_base);
+    ASSERT_EQ(b.offset, 4096);
+    ASSERT_EQ(b.device_address % 4096, 0);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b.host_ptr) % 4096, 0);
+    ASSERT_EQ(static_cast<std::uint8_t*>(b.host_ptr) - channel_0.data(), b.device_address - device_base);
+    std::memset(b.host_ptr, 0xff, b.size);
+
+    // Allocations that don't fit in channel 0 spill into channel 1
+    const tt_sysmem_allocation c = allocator.allocate(channel_size - 4096);
+    ASSERT_TRUE(c.is_valid());
+    ASSERT_EQ(c.channel, 1);
+    ASSERT_EQ(c.device_address, device_base + (1 << 30));
+    ASSERT_FALSE(allocator.allocate(channel_size).is_valid());
+
+    tt_sysmem_allocator_stats stats = allocator.get_stats();
+    ASSERT_EQ(stats.total_bytes, 2 * channel_size);
+    ASSERT_EQ(stats.num_allocations, 3);
+    ASSERT_EQ(allocator.get_stats(1).allocated_bytes, channel_size - 4096);
+
+    allocator.free(a);
+    allocator.free(b);
+    allocator.free(c);
+    stats = allocator.get_stats();
+    ASSERT_EQ(stats.allocated_bytes, 0);
+    ASSERT_EQ(stats.num_free_blocks, 2) << "Freed blocks should be merged back into one block per channel";
+    ASSERT_EQ(stats.get_fragmentation(), 0.5);
+}
+
+TEST(SysmemAllocator, FreedBlocksAreReusedAndMerged) {
+    constexpr std::size_t channel_size = 1024 * 1024;
+    anonymous_channel channel = anonymous_channel(channel_size);
+    tt_sysmem_allocator allocator = {};
+    allocator.add_channel(0, channel.data(), channel_size, 0);
+
+    std::vector<tt_sysmem_allocation> buffers = {};
+    for (int i = 0; i < 16; i++) {
+        buffers.push_back(allocator.allocate(64 * 1024));
+        ASSERT_TRUE(buffers.back().is_valid());
+    }
+    ASSERT_FALSE(allocator.allocate(1).is_valid());
+
+    // Free every other buffer: half the channel is free, but no block is larger than a single buffer.
+    for (int i = 0; i < 16; i += 2) {
+        allocator.free(buffers[i]);
+    }
+    tt_sysmem_allocator_stats stats = allocator.get_stats();
+    ASSERT_EQ(stats.free_bytes, channel_size / 2);
+    ASSERT_EQ(stats.largest_free_block, 64 * 1024);
+    ASSERT_EQ(stats.num_free_blocks, 8);
+    ASSERT_DOUBLE_EQ(stats.get_fragmentation(), 1.0 - 1.0 / 8);
+    ASSERT_FALSE(allocator.allocate(128 * 1024).is_valid());
+    ASSERT_EQ(allocator.allocate(64 * 1024).offset, 0) << "First fit should reuse the lowest free block";
+
+    for (int i = 1; i < 16; i += 2) {
+        allocator.free(buffers[i]);
+    }
+    stats = allocator.get_stats();
+    ASSERT_EQ(stats.num_free_blocks, 1);
+    ASSERT_EQ(stats.largest_free_block, channel_size - 64 * 1024);
+    ASSERT_THROW(allocator.free(buffers[1]), std::runtime_error);
+}
+
+TEST(SysmemAllocator, ChannelZeroScratchIsNeverAllocated) {
+    // Channels are 1GB. host_mem::address_map puts DEVICE_TO_HOST_SCRATCH (ethernet routing buffers, then perf scratch)
+    // in the last 128MB of channel 0.
+    constexpr std::uint64_t channel_size = 1024 * 1024 * 1024;
+    tt_driver_host_address_params host_address_params = {};
+    host_address_params.eth_routing_buffers_start = 896 * 1024 * 1024;
+    host_address_params.eth_routing_block_size = 32 * 1024;
+    const std::uint64_t scratch_start = host_address_params.eth_routing_buffers_start;
+
+    ASSERT_EQ(tt_SiliconDevice::get_sysmem_arena_size(0, channel_size, host_address_params), scratch_start);
+    ASSERT_EQ(tt_SiliconDevice::get_sysmem_arena_size(1, channel_size, host_address_params), channel_size);
+    ASSERT_EQ(tt_SiliconDevice::get_sysmem_arena_size(0, 256 * 1024 * 1024, host_address_params), 256 * 1024 * 1024);
+
+    // Allocate all of channel 0, in blocks that don't divide the arena evenly, and check none reaches the scratch region.
+    anonymous_channel channel_0 = anonymous_channel(channel_size);
+    tt_sysmem_allocator allocator = {};
+    allocator.add_channel(0, channel_0.data(), tt_SiliconDevice::get_sysmem_arena_size(0, channel_size, host_address_params), 0);
+    std::uint64_t allocated = 0;
+    for (const std::uint64_t size : {std::uint64_t(384) << 20, std::uint64_t(100) << 20, std::uint64_t(7) << 20, std::uint64_t(1) << 20, std::uint64_t(4096), std::uint64_t(64)}) {
+        for (tt_sysmem_allocation allocation = allocator.allocate(size); allocation.is_valid(); allocation = allocator.allocate(size)) {
+            ASSERT_LE(allocation.offset + allocation.size, scratch_start) << "Allocation of " << size << " bytes overlaps the scratch region";
+            allocated += allocation.size;
+        }
+    }
+    ASSERT_EQ(allocated, scratch_start) << "The rest of channel 0 should still be handed out";
+    ASSERT_EQ(allocator.get_stats(0).total_bytes, scratch_start);
+}
+
+TEST(SysmemMap, ViewsAreBoundsCheckedAndAliasTheChannel) {
+    constexpr std::size_t channel_size = 1024 * 1024;
+    anonymous_channel channel_0 = anonymous_channel(channel_size);
+    anonymous_channel channel_3 = anonymous_channel(channel_size);
+    tt_sysmem_map sysmem_map = {};
+    sysmem_map.add_channel(1, 0, channel_0.data(), channel_size);
+    sysmem_map.add_channel(1, 3, channel_3.data(), channel_size);
+
+    ASSERT_TRUE(sysmem_map.is_mapped(1, 0));
+    ASSERT_FALSE(sysmem_map.is_mapped(0, 0));
+    ASSERT_FALSE(sysmem_map.is_mapped(1, 1));
+    ASSERT_FALSE(sysmem_map.is_mapped(2, 0));
+    ASSERT_EQ(sysmem_map.get_channel_size(1, 3), channel_size);
+
+    // Views point into the channel, so writes through a view are seen through any other view of the same bytes
+    const tt_sysmem_span view = sysmem_map.map(1, 3, 4096, 256);
+    ASSERT_EQ(view.data, channel_3.data() + 4096);
+    ASSERT_EQ(view.size, 256);
+    std::memset(view.data, 0xab, view.size);
+    ASSERT_EQ(sysmem_map.map(1, 3, 4096 + 255, 1).data[0], 0xab);
+    ASSERT_EQ(sysmem_map.map(1, 0, 0, channel_size).size, channel_size);
+    ASSERT_EQ(sysmem_map.map(1, 0, channel_size, 0).size, 0);
+
+    ASSERT_THROW(sysmem_map.map(1, 0, channel_size - 4, 8), std::runtime_error);
+    ASSERT_THROW(sysmem_map.map(1, 0, std::uint64_t(1) << 63, 8), std::runtime_error);
+    ASSERT_THROW(sysmem_map.map(1, 1, 0, 8), std::runtime_error);
+    ASSERT_THROW(sysmem_map.map(4, 0, 0, 8), std::runtime_error);
+    ASSERT_THROW(sysmem_map.add_channel(1, 0, channel_0.data(), channel_size), std::runtime_error);
+}
+
+TEST(SysmemStreaming, UnalignedHeadAndTailAreCopied) {
+    std::vector<std::uint8_t> src(4096 + 64);
+    for (std::size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+    for (std::size_t dest_offset : {0, 1, 15, 16, 33}) {
+        for (std::size_t src_offset : {0, 5}) {
+            for (std::size_t size : {0, 1, 15, 16, 17, 63, 64, 65, 1000, 4096}) {
+                std::vector<std::uint8_t> dest(4096 + 128, 0xee);
+                tt_sysmem_memcpy_streaming(dest.data() + dest_offset, src.data() + src_offset, size);
+                ASSERT_EQ(std::memcmp(dest.data() + dest_offset, src.data() + src_offset, size), 0) << "size " << size << " dest offset " << dest_offset;
+                for (std::size_t i = 0; i < dest_offset; i++) {
+                    ASSERT_EQ(dest[i], 0xee);
+                }
+                for (std::size_t i = dest_offset + size; i < dest.size(); i++) {
+                    ASSERT_EQ(dest[i], 0xee) << "size " << size << " dest offset " << dest_offset << " wrote past the end";
+                }
+            }
+        }
+    }
+}
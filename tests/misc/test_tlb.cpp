@@ -0,0 +1,312 @@
+// SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tt_device.h"
+
+#include "device/architecture_implementation.h"
+#include "device/blackhole_implementation.h"
+#include "device/wormhole_implementation.h"
+#include "tests/test_utils/generate_cluster_desc.hpp"
+
+namespace {
+// Core to static TLB mapping used by the WH tests: ethernet cores first, then one 1MB TLB per worker.
+std::int32_t get_wh_static_tlb_index(tt_xy_pair target) {
+    bool is_eth_location = std::find(std::cbegin(tt::umd::wormhole::ETH_LOCATIONS), std::cend(tt::umd::wormhole::ETH_LOCATIONS), target) != std::cend(tt::umd::wormhole::ETH_LOCATIONS);
+    bool is_tensix_location = std::find(std::cbegin(tt::umd::wormhole::T6_X_LOCATIONS), std::cend(tt::umd::wormhole::T6_X_LOCATIONS), target.x) != std::cend(tt::umd::wormhole::T6_X_LOCATIONS) &&
+                            std::find(std::cbegin(tt::umd::wormhole::T6_Y_LOCATIONS), std::cend(tt::umd::wormhole::T6_Y_LOCATIONS), target.y) != std::cend(tt::umd::wormhole::T6_Y_LOCATIONS);
+    if (is_eth_location) {
+        if (target.y == 6) {
+            target.y = 1;
+        }
+
+        if (target.x >= 5) {
+            target.x -= 1;
+        }
+        target.x -= 1;
+
+        int flat_index = target.y * 8 + target.x;
+        int tlb_index = flat_index;
+        return tlb_index;
+
+    } else if (is_tensix_location) {
+        if (target.x >= 5) {
+            target.x -= 1;
+        }
+        target.x -= 1;
+
+        if (target.y >= 6) {
+            target.y -= 1;
+        }
+        target.y -= 1;
+
+        int flat_index = target.y * 8 + target.x;
+
+        // All 80 get single 1MB TLB.
+        int tlb_index = tt::umd::wormhole::ETH_LOCATIONS.size() + flat_index;
+
+        return tlb_index;
+    } else {
+        return -1;
+    }
+}
+
+// Core to static TLB mapping used by the BH tests: ethernet cores first, then one 2MB TLB per worker.
+std::int32_t get_bh_static_tlb_index(tt_xy_pair target) {
+    bool is_eth_location = std::find(std::begin(tt::umd::blackhole::ETH_LOCATIONS), std::end(tt::umd::blackhole::ETH_LOCATIONS), target) != std::end(tt::umd::blackhole::ETH_LOCATIONS);
+    bool is_tensix_location = std::find(std::begin(tt::umd::blackhole::T6_X_LOCATIONS), std::end(tt::umd::blackhole::T6_X_LOCATIONS), target.x) != std::end(tt::umd::blackhole::T6_X_LOCATIONS) &&
+                            std::find(std::begin(tt::umd::blackhole::T6_Y_LOCATIONS), std::end(tt::umd::blackhole::T6_Y_LOCATIONS), target.y) != std::end(tt::umd::blackhole::T6_Y_LOCATIONS);
+    if (is_eth_location) {
+        if (target.y == 6) {
+            target.y = 1;
+        }
+
+        if (target.x >= 5) {
+            target.x -= 1;
+        }
+        target.x -= 1;
+
+        int flat_index = target.y * 14 + target.x;
+        int tlb_index = flat_index;
+        return tlb_index;
+
+    } else if (is_tensix_location) {
+        if (target.x >= 8) {
+            target.x -= 2;
+        }
+        target.x -= 1;  // First x index is 1
+
+        target.y -= 2;  // First y index is 2
+
+        int flat_index = target.y * 14 + target.x;
+
+        // All 140 get single 2MB TLB.
+        int tlb_index = tt::umd::blackhole::ETH_LOCATIONS.size() + flat_index;
+
+        return tlb_index;
+    } else {
+        return -1;
+    }
+}
+
+// l1_mem::address_map::NCRISC_FIRMWARE_BASE, the same on WH and BH
+constexpr std::uint64_t NCRISC_FIRMWARE_BASE = 20 * 1024;
+}
+
+namespace {
+std::unordered_map<tt_xy_pair, tt_xy_pair> get_reference_wh_coord_translation(bool identity_map) {
+    // Reference NOC translation for WH: workers and ethernet cores are moved to the translated coordinate space, all other cores are untouched.
+    std::unordered_map<tt_xy_pair, tt_xy_pair> translation_map = {};
+    for(std::size_t x = 0; x < tt::umd::wormhole::GRID_SIZE_X; x++) {
+        for(std::size_t y = 0; y < tt::umd::wormhole::GRID_SIZE_Y; y++) {
+            tt_xy_pair core = tt_xy_pair(x, y);
+            tt_xy_pair translated_core = core;
+            bool is_worker = std::find(tt::umd::wormhole::T6_X_LOCATIONS.begin(), tt::umd::wormhole::T6_X_LOCATIONS.end(), x) != tt::umd::wormhole::T6_X_LOCATIONS.end() &&
+                            std::find(tt::umd::wormhole::T6_Y_LOCATIONS.begin(), tt::umd::wormhole::T6_Y_LOCATIONS.end(), y) != tt::umd::wormhole::T6_Y_LOCATIONS.end();
+            bool is_eth = std::find(tt::umd::wormhole::ETH_LOCATIONS.begin(), tt::umd::wormhole::ETH_LOCATIONS.end(), core) != tt::umd::wormhole::ETH_LOCATIONS.end();
+            if(!identity_map && (is_worker || is_eth)) {
+                translated_core.x = x <= 4 ? x + 17 : x + 16;
+                if(is_worker) translated_core.y = y <= 5 ? y + 17 : y + 16;
+                else translated_core.y = y == 0 ? 16 : 17;
+            }
+            translation_map.insert({core, translated_core});
+        }
+    }
+    return translation_map;
+}
+}
+
+TEST(CoordTranslationWH, FlatTableMatchesReferenceForAllHarvestingMasks) {
+    const tt_SocDescriptor default_sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const auto& harvesting_noc_locations = tt::umd::wormhole::HARVESTING_NOC_LOCATIONS;
+
+    for(uint32_t harvesting_mask = 0; harvesting_mask < (1 << harvesting_noc_locations.size()); harvesting_mask++) {
+        uint32_t harvested_noc_rows = 0;
+        for(int pos = 0; pos < harvesting_noc_locations.size(); pos++) {
+            if((harvesting_mask >> pos) & 1) harvested_noc_rows |= (1 << harvesting_noc_locations.at(pos));
+        }
+        tt_SocDescriptor sdesc = default_sdesc;
+        tt_SiliconDevice::harvest_rows_in_soc_descriptor(tt::ARCH::WORMHOLE_B0, sdesc, harvested_noc_rows);
+
+        for(bool identity_map : {true, false}) {
+            // Built for every chip like the driver does, so each harvesting mask gets its own table
+            const auto reference = get_reference_wh_coord_translation(identity_map);
+            const tt_coord_translation_table table = tt_SiliconDevice::create_harvested_coord_translation(tt::ARCH::WORMHOLE_B0, identity_map);
+            ASSERT_EQ(table.identity, identity_map);
+            ASSERT_EQ(table.grid_size, tt_xy_pair(tt::umd::wormhole::GRID_SIZE_X, tt::umd::wormhole::GRID_SIZE_Y));
+
+            std::vector<tt_xy_pair> cores = {};
+            for(const auto& core : sdesc.cores) {
+                cores.push_back(core.first);
+                ASSERT_EQ(table.translate(core.first), reference.at(core.first)) << "Translation mismatch for core " << core.first.str() << " with harvesting mask " << harvesting_mask;
+            }
+            // Batch translation must agree with per core translation
+            std::vector<tt_xy_pair> translated_cores(cores.size());
+            table.translate(cores.data(), translated_cores.data(), cores.size());
+            for(int i = 0; i < cores.size(); i++) {
+                ASSERT_EQ(translated_cores.at(i), reference.at(cores.at(i))) << "Batch translation mismatch for core " << cores.at(i).str() << " with harvesting mask " << harvesting_mask;
+            }
+        }
+    }
+}
+
+TEST(CoordTranslationWH, IdentityTablesBoundsCheck) {
+    for(const auto& arch : {tt::ARCH::GRAYSKULL, tt::ARCH::WORMHOLE_B0, tt::ARCH::BLACKHOLE}) {
+        const tt_coord_translation_table table = tt_SiliconDevice::create_harvested_coord_translation(arch, true);
+        ASSERT_TRUE(table.identity);
+        ASSERT_TRUE(table.translated_coords.empty()) << "Identity tables should not store any entries";
+        for(std::size_t x = 0; x < table.grid_size.x; x++) {
+            for(std::size_t y = 0; y < table.grid_size.y; y++) {
+                ASSERT_EQ(table.translate(tt_xy_pair(x, y)), tt_xy_pair(x, y));
+            }
+        }
+        EXPECT_THROW(table.translate(tt_xy_pair(table.grid_size.x, 0)), std::out_of_range);
+        EXPECT_THROW(table.translate(tt_xy_pair(0, table.grid_size.y)), std::out_of_range);
+    }
+}
+
+TEST(StaticTLBTableWH, MatchesCoreToTLBMapping) {
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const tt::umd::wormhole_implementation architecture_implementation;
+    tt_static_tlb_table table = tt_static_tlb_table::create(&architecture_implementation, get_wh_static_tlb_index);
+    ASSERT_EQ(table.grid_size, tt_xy_pair(tt::umd::wormhole::GRID_SIZE_X, tt::umd::wormhole::GRID_SIZE_Y));
+
+    // Statically map a 1MB TLB to each worker, starting from address NCRISC_FIRMWARE_BASE
+    const std::uint64_t tlb_size = 1 << 20;
+    const std::uint64_t mapped_base = (NCRISC_FIRMWARE_BASE / tlb_size) * tlb_size;
+    for(const auto& core : sdesc.workers) {
+        table.configure(get_wh_static_tlb_index(core), mapped_base);
+    }
+
+    for(const auto& [core, core_desc] : sdesc.cores) {
+        const tt_static_tlb_entry* entry = table.get(core);
+        const auto tlb_data = architecture_implementation.describe_tlb(get_wh_static_tlb_index(core));
+        if(!tlb_data.has_value()) {
+            ASSERT_EQ(entry, nullptr) << "Core " << core.str() << " should not have a static TLB";
+            continue;
+        }
+        ASSERT_NE(entry, nullptr) << "Core " << core.str() << " should have a static TLB";
+        ASSERT_EQ(entry->tlb_index, get_wh_static_tlb_index(core));
+        ASSERT_EQ(entry->bar_offset, std::get<0>(tlb_data.value()));
+        ASSERT_EQ(entry->size, std::get<1>(tlb_data.value()));
+
+        bool is_worker = std::find(sdesc.workers.begin(), sdesc.workers.end(), core) != sdesc.workers.end();
+        ASSERT_EQ(entry->configured, is_worker) << "Only workers were configured, core " << core.str();
+        if(is_worker) {
+            ASSERT_EQ(entry->mapped_base, mapped_base);
+            EXPECT_TRUE(entry->contains(NCRISC_FIRMWARE_BASE, 4));
+            EXPECT_TRUE(entry->contains(mapped_base + tlb_size - 4, 4));
+            EXPECT_FALSE(entry->contains(mapped_base + tlb_size - 4, 8)) << "Access crossing the end of the TLB window must use a dynamic TLB";
+            EXPECT_FALSE(entry->contains(mapped_base + tlb_size, 4));
+        } else {
+            EXPECT_FALSE(entry->contains(mapped_base, 4)) << "Unconfigured TLBs must not be used for accesses";
+        }
+    }
+    ASSERT_EQ(table.get(tt_xy_pair(tt::umd::wormhole::GRID_SIZE_X, 0)), nullptr);
+    ASSERT_EQ(table.get(tt_xy_pair(0, tt::umd::wormhole::GRID_SIZE_Y)), nullptr);
+}
+
+TEST(StaticTLBTableWH, ConfigurationBeforeSetup) {
+    // configure_tlb may be called before setup_core_to_tlb_map. The table must pick up existing configurations when it is built.
+    const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"));
+    const tt::umd::wormhole_implementation architecture_implementation;
+    std::unordered_map<std::int32_t, std::uint64_t> configured_tlbs = {};
+    for(const auto& core : sdesc.workers) {
+        configured_tlbs.insert({get_wh_static_tlb_index(core), 0x100000});
+    }
+    tt_static_tlb_table table = tt_static_tlb_table::create(&architecture_implementation, get_wh_static_tlb_index, configured_tlbs);
+    for(const auto& core : sdesc.workers) {
+        ASSERT_TRUE(table.get(core)->contains(0x100000, 0x100000));
+    }
+    // Reconfiguring a TLB moves its window
+    const auto& core = sdesc.workers.at(0);
+    table.configure(get_wh_static_tlb_index(core), 0x200000);
+    ASSERT_FALSE(table.get(core)->contains(0x100000, 4));
+    ASSERT_TRUE(table.get(core)->contains(0x200000, 4));
+    ASSERT_TRUE(table.get(sdesc.workers.at(1))->contains(0x100000, 4));
+}
+
+namespace {
+std::vector<std::pair<std::uint32_t, std::uint64_t>> get_dynamic_tlb_setup_cases() {
+    // Every dynamic TLB, pointed at addresses inside, at the end of and across the window of each TLB size
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> cases = {};
+    for(std::uint32_t tlb_index = tt::umd::wormhole::TLB_BASE_INDEX_2M; tlb_index < tt::umd::wormhole::INTERNAL_TLB_INDEX + 1; tlb_index++) {
+        for(std::uint64_t address : {0x0ULL, 0x100ULL, 0xFFFFCULL, 0x1FFFFCULL, 0x200000ULL, 0xFFFFFCULL, 0x1000000ULL, 0x30000000ULL}) {
+            cases.push_back({tlb_index, address});
+        }
+    }
+    return cases;
+}
+}
+
+TEST(DynamicTLBSetupWH, SpecialisedMatchesVirtual) {
+    const auto architecture_implementation = tt::umd::architecture_implementation::create(tt::umd::architecture::wormhole_b0);
+    const tt::umd::tlb_operations* tlb_operations = tt::umd::architecture_implementation::get_tlb_operations(tt::umd::architecture::wormhole_b0);
+    ASSERT_NE(tlb_operations, nullptr);
+    ASSERT_EQ(tt::umd::architecture_implementation::get_tlb_operations(tt::umd::architecture::invalid), nullptr);
+
+    const tt::umd::tlb_data data = {.x_end = 9, .y_end = 11, .x_start = 1, .y_start = 1, .mcast = 1, .ordering = tt::umd::tlb_data::Posted, .static_vc = 1};
+    for(const auto& [tlb_index, address] : get_dynamic_tlb_setup_cases()) {
+        const tt::umd::tlb_setup expected = tt::umd::get_dynamic_tlb_setup(*architecture_implementation, tlb_index, address, data);
+        const tt::umd::tlb_setup specialised = tlb_operations->get_dynamic_tlb_setup(tlb_index, address, data);
+        ASSERT_EQ(specialised.bar_offset, expected.bar_offset) << "TLB " << tlb_index << " address " << address;
+        ASSERT_EQ(specialised.remaining_size, expected.remaining_size) << "TLB " << tlb_index << " address " << address;
+        ASSERT_EQ(specialised.cfg_reg, expected.cfg_reg) << "TLB " << tlb_index << " address " << address;
+        ASSERT_EQ(specialised.cfg_reg_size, expected.cfg_reg_size) << "TLB " << tlb_index << " address " << address;
+        ASSERT_EQ(specialised.cfg_data, expected.cfg_data) << "TLB " << tlb_index << " address " << address;
+        ASSERT_EQ(tlb_operations->describe_tlb(tlb_index), architecture_implementation->describe_tlb(tlb_index)) << "TLB " << tlb_index;
+        ASSERT_EQ(tlb_operations->get_tlb_data(tlb_index, data), architecture_implementation->get_tlb_data(tlb_index, data)) << "TLB " << tlb_index;
+
+        // Sanity check against the raw TLB layout
+        const auto tlb_configuration = architecture_implementation->get_tlb_configuration(tlb_index);
+        ASSERT_EQ(specialised.bar_offset + specialised.remaining_size, tlb_configuration.base + tlb_configuration.size * (tlb_configuration.index_offset + 1));
+    }
+    for(const auto& [start, end] : std::vector<std::pair<tt_xy_pair, tt_xy_pair>>{{{0, 0}, {9, 11}}, {{1, 1}, {4, 5}}}) {
+        ASSERT_EQ(tlb_operations->multicast_workaround(start, end), architecture_implementation->multicast_workaround(start, end));
+    }
+}
+
+TEST(StaticTLBTableBH, MatchesCoreToTLBMapping) {
+    for(const auto& sdesc_path : {"tests/soc_descs/blackhole_140_arch.yaml", "tests/soc_descs/blackhole_140_arch_no_eth.yaml"}) {
+        const tt_SocDescriptor sdesc = tt_SocDescriptor(test_utils::GetAbsPath(sdesc_path));
+        const tt::umd::blackhole_implementation architecture_implementation;
+        tt_static_tlb_table table = tt_static_tlb_table::create(&architecture_implementation, get_bh_static_tlb_index);
+        ASSERT_EQ(table.grid_size, tt_xy_pair(tt::umd::blackhole::GRID_SIZE_X, tt::umd::blackhole::GRID_SIZE_Y));
+
+        // Statically map a 2MB TLB to each worker, starting from address NCRISC_FIRMWARE_BASE
+        const std::uint64_t tlb_size = 1 << 21;
+        const std::uint64_t mapped_base = (NCRISC_FIRMWARE_BASE / tlb_size) * tlb_size;
+        std::set<std::int32_t> configured_tlbs = {};
+        for(const auto& core : sdesc.workers) {
+            table.configure(get_bh_static_tlb_index(core), mapped_base);
+            configured_tlbs.insert(get_bh_static_tlb_index(core));
+        }
+
+        for(const auto& [core, core_desc] : sdesc.cores) {
+            const tt_static_tlb_entry* entry = table.get(core);
+            const auto tlb_data = architecture_implementation.describe_tlb(get_bh_static_tlb_index(core));
+            if(!tlb_data.has_value()) {
+                ASSERT_EQ(entry, nullptr) << "Core " << core.str() << " should not have a static TLB";
+                continue;
+            }
+            ASSERT_NE(entry, nullptr) << "Core " << core.str() << " should have a static TLB";
+            ASSERT_EQ(entry->tlb_index, get_bh_static_tlb_index(core));
+            ASSERT_EQ(entry->bar_offset, std::get<0>(tlb_data.value()));
+            ASSERT_EQ(entry->size, std::get<1>(tlb_data.value()));
+
+            // Cores sharing a TLB index with a worker share its configuration
+            bool configured = configured_tlbs.find(entry->tlb_index) != configured_tlbs.end();
+            ASSERT_EQ(entry->configured, configured) << "Only worker TLBs were configured, core " << core.str();
+            if(configured) {
+                EXPECT_TRUE(entry->contains(NCRISC_FIRMWARE_BASE, 4));
+                EXPECT_FALSE(entry->contains(mapped_base + tlb_size - 4, 8)) << "Access crossing the end of the TLB window must use a dynamic TLB";
+            }
+        }
+        ASSERT_EQ(table.get(tt_xy_pair(tt::umd::blackhole::GRID_SIZE_X, 0)), nullptr);
+    }
+}
@@ -28,6 +28,13 @@ endif
 
 DEVICE_UNIT_TESTS_LDFLAGS = -L$(LIBDIR) -lyaml-cpp -lhwloc -lgtest -lgtest_main -lpthread -lstdc++fs
 
+# Host only tests that don't depend on the architecture, built into their own executable for every arch
+MISC_UNIT_TESTS_SRCS = $(wildcard $(UMD_HOME)/tests/misc/*.cpp) $(UMD_HOME)/tests/unit_test_main.cpp
+
+# Benchmarks only use the host side of the driver, and are built into their own executable
+DEVICE_BENCHMARKS_SRCS = $(wildcard $(UMD_HOME)/tests/benchmarks/*.cpp)
+DEVICE_BENCHMARKS_LDFLAGS = -L$(LIBDIR) -lyaml-cpp -lhwloc -lbenchmark -lbenchmark_main -lpthread -lstdc++fs
+
 DEVICE_UNIT_TESTS_OBJS = $(addprefix $(OBJDIR)/, $(DEVICE_UNIT_TESTS_SRCS:.cpp=.o))
 DEVICE_UNIT_TESTS_DEPS = $(addprefix $(OBJDIR)/, $(DEVICE_UNIT_TESTS_SRCS:.cpp=.d))
 
@@ -57,6 +64,8 @@ DEVICE_UNIT_TESTS_DEPS = $(UMD_DEVICE_LIB)
 device/tests: $(OUT)/tests/device_unit_tests
 device/tests/galaxy: $(OUT)/tests/galaxy_unit_tests
 device/tests/emulation: $(OUT)/tests/emulation_unit_tests
+device/tests/misc: $(OUT)/tests/misc_unit_tests
+device/tests/benchmarks: $(OUT)/tests/device_benchmarks
 
 .PHONY: $(OUT)/tests/device_unit_tests
 $(OUT)/tests/device_unit_tests: $(DEVICE_UNIT_TESTS_DEPS)
@@ -73,3 +82,12 @@ $(OUT)/tests/emulation_unit_tests: $(DEVICE_UNIT_TESTS_DEPS)
 	@mkdir -p $(@D)
 	$(DEVICE_CXX) $(DEVICE_UNIT_TESTS_CFLAGS) $(CXXFLAGS) $(DEVICE_UNIT_TESTS_INCLUDES) $(EMULATION_UNIT_TESTS_SRCS) -o $@ $^ $(LDFLAGS) $(DEVICE_UNIT_TESTS_LDFLAGS)
 
+.PHONY: $(OUT)/tests/misc_unit_tests
+$(OUT)/tests/misc_unit_tests: $(DEVICE_UNIT_TESTS_DEPS)
+	@mkdir -p $(@D)
+	$(DEVICE_CXX) $(DEVICE_UNIT_TESTS_CFLAGS) $(CXXFLAGS) $(DEVICE_UNIT_TESTS_INCLUDES) $(MISC_UNIT_TESTS_SRCS) -o $@ $^ $(LDFLAGS) $(DEVICE_UNIT_TESTS_LDFLAGS)
+
+.PHONY: $(OUT)/tests/device_benchmarks
+$(OUT)/tests/device_benchmarks: $(DEVICE_UNIT_TESTS_DEPS)
+	@mkdir -p $(@D)
+	$(DEVICE_CXX) $(DEVICE_UNIT_TESTS_CFLAGS) $(CXXFLAGS) $(DEVICE_UNIT_TESTS_INCLUDES) $(DEVICE_BENCHMARKS_SRCS) -o $@ $^ $(LDFLAGS) $(DEVICE_BENCHMARKS_LDFLAGS)
@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "device/tt_arc_msg.h"
+
+namespace test_utils {
+
+// Stand-in for the ARC firmware of one chip when sending ARC messages without hardware.
+// Setting bit 16 of misc_cntl raises the firmware interrupt. The firmware replies response_latency later, through the
+// scratch registers, to messages that have an entry in replies, and with TT_ARC_MSG_ERROR_REPLY to any other message.
+// Each register read sleeps for read_latency, emulating a PCIe round trip without keeping the CPU busy.
+class arc_msg_model : public tt_arc_msg_io {
+    public:
+    struct reply {
+        std::uint32_t exit_code = 0;
+        std::uint32_t return_3 = 0;
+        std::uint32_t return_4 = 0;
+    };
+    struct message {
+        std::uint32_t msg_code;
+        std::uint32_t fw_arg;
+    };
+
+    static constexpr std::uint64_t SCRATCH = 0x1ff30060;
+    static constexpr std::uint64_t MISC_CNTL = 0x1ff30100;
+    static constexpr std::uint32_t FW_INT = 1 << 16;
+
+    std::chrono::microseconds response_latency = std::chrono::microseconds(0);
+    std::chrono::microseconds read_latency = std::chrono::microseconds(0);
+    // A hung firmware never replies
+    bool responds = true;
+    std::map<std::uint32_t, reply> replies = {};
+    // Marker shared by the mailboxes of the processes messaging this chip, if any
+    tt_arc_msg_in_flight_marker* in_flight_marker = nullptr;
+
+    std::vector<message> messages = {};
+    int num_reads = 0;
+    int num_flushes = 0;
+
+    tt_arc_msg_regs get_regs() const { return {SCRATCH, MISC_CNTL}; }
+
+    std::uint32_t read_reg(std::uint64_t address) override {
+        if (read_latency.count() > 0) {
+            std::this_thread::sleep_for(read_latency);
+        }
+        num_reads++;
+        respond_if_due();
+        return get_reg(address);
+    }
+
+    void write_reg(std::uint64_t address, std::uint32_t value) override {
+        const std::uint32_t previous = get_reg(address);
+        regs[address] = value;
+        if (address == MISC_CNTL && (value & FW_INT) && !(previous & FW_INT)) {
+            messages.push_back({get_reg(SCRATCH + 5 * 4), get_reg(SCRATCH + 3 * 4)});
+            pending = true;
+            response_time = std::chrono::steady_clock::now() + response_latency;
+        }
+    }
+
+    void flush_writes() override { num_flushes++; }
+    tt_arc_msg_in_flight_marker* get_in_flight_marker() override { return in_flight_marker; }
+
+    std::uint32_t get_reg(std::uint64_t address) const {
+        auto reg = regs.find(address);
+        return reg == regs.end() ? 0 : reg->second;
+    }
+    void set_reg(std::uint64_t address, std::uint32_t value) { regs[address] = value; }
+
+    private:
+    void respond_if_due() {
+        if (!pending || !responds || std::chrono::steady_clock::now() < response_time) {
+            return;
+        }
+        pending = false;
+        const std::uint32_t msg_code = messages.back().msg_code;
+        auto handled = replies.find(msg_code);
+        if (handled == replies.end()) {
+            regs[SCRATCH + 5 * 4] = TT_ARC_MSG_ERROR_REPLY;
+        } else {
+            regs[SCRATCH + 3 * 4] = handled->second.return_3;
+            regs[SCRATCH + 4 * 4] = handled->second.return_4;
+            regs[SCRATCH + 5 * 4] = (handled->second.exit_code << 16) | (msg_code & 0xff);
+        }
+        regs[MISC_CNTL] &= ~FW_INT;
+    }
+
+    std::map<std::uint64_t, std::uint32_t> regs = {};
+    bool pending = false;
+    std::chrono::steady_clock::time_point response_time = {};
+};
+
+}  // namespace test_utils
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tt_device.h"
+
+#include "tests/test_utils/rendezvous.hpp"
+
+namespace test_utils {
+
+// Stand-in for the ethernet command queues of the gateway (MMIO) chips of a cluster, when running broadcast plans
+// without hardware. Each gateway serializes the headers posted to it (like the NON_MMIO mutex), and each post sleeps for
+// the configured latency, emulating the time the gateway's queue is busy. Sleeping lets the latencies of different
+// gateways overlap on any number of CPUs.
+// If created with an expected concurrency, the first post to each gateway waits for that many gateways to be posting at
+// the same time, and all_gateways_posting is cleared if they weren't.
+class broadcast_queue_model : public tt_broadcast_io {
+    public:
+    std::chrono::nanoseconds post_latency = std::chrono::nanoseconds(0);
+    std::atomic<bool> all_gateways_posting = true;
+    std::atomic<int> num_direct_writes = 0;
+
+    explicit broadcast_queue_model(const std::vector<chip_id_t>& gateways, int expected_concurrency = 0) : expected_concurrency(expected_concurrency) {
+        for (const auto& gateway : gateways) {
+            gateway_mutex[gateway];
+            posted_headers[gateway] = {};
+        }
+        reset();
+    }
+
+    void write_ethernet_broadcast(chip_id_t mmio_chip, const std::vector<int>& header) override {
+        const std::lock_guard<std::mutex> lock(gateway_mutex.at(mmio_chip));
+        if (gateways_posting && posted_headers.at(mmio_chip).empty() && !gateways_posting->arrive_and_wait()) {
+            all_gateways_posting = false;
+        }
+        if (post_latency.count()) {
+            std::this_thread::sleep_for(post_latency);
+        }
+        posted_headers.at(mmio_chip).push_back(header);
+    }
+
+    void multicast_write(chip_id_t /*chip*/, const tt_xy_pair& /*start*/, const tt_xy_pair& /*end*/) override { num_direct_writes++; }
+    void write(chip_id_t /*chip*/, const tt_xy_pair& /*core*/) override { num_direct_writes++; }
+
+    const std::vector<std::vector<int>>& get_posted_headers(chip_id_t gateway) const { return posted_headers.at(gateway); }
+
+    // Forget the posted headers, to check the next broadcast on its own
+    void reset() {
+        for (auto& headers : posted_headers) {
+            headers.second.clear();
+        }
+        num_direct_writes = 0;
+        if (expected_concurrency > 0) {
+            gateways_posting = std::make_unique<rendezvous>(expected_concurrency);
+        }
+    }
+
+    private:
+    const int expected_concurrency;
+    std::map<chip_id_t, std::mutex> gateway_mutex = {};
+    std::map<chip_id_t, std::vector<std::vector<int>>> posted_headers = {};
+    std::unique_ptr<rendezvous> gateways_posting = nullptr;
+};
+
+// Broadcast plan of a galaxy like cluster: every gateway fans out to its shelf through a few ethernet broadcast headers.
+// Header i of gateway g is {g, i}.
+inline tt_broadcast_plan create_multi_gateway_plan(const std::vector<chip_id_t>& gateways, int headers_per_gateway) {
+    tt_broadcast_plan plan = {};
+    plan.ethernet_broadcasts.emplace_back();
+    for (const auto& gateway : gateways) {
+        plan.target_chips.insert(gateway);
+        for (int header = 0; header < headers_per_gateway; header++) {
+            plan.ethernet_broadcasts.back()[gateway].push_back({gateway, header});
+        }
+    }
+    return plan;
+}
+
+}  // namespace test_utils
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "tt_device.h"
+#include "device/tt_eth_queue.h"
+
+namespace test_utils {
+
+// Stand-in for the ethernet command queues of one MMIO chip and the ERISC firmware draining them into a remote core.
+// Host memory channel 0 holds the data blocks written by the host, and the remote core's memory is a flat buffer. The
+// firmware only handles commands the host published (through the wptr), one command each time the host polls a queue's
+// rptr, so queues fill up and the host has to wait for them. Host accesses are counted.
+class eth_queue_model : public tt_eth_queue_io {
+    public:
+    struct sysmem_write {
+        std::uint64_t address;
+        std::uint32_t size_in_bytes;
+    };
+
+    eth_queue_model(const tt_driver_eth_interface_params& eth_params, int num_queues) : eth_params(eth_params), queues(num_queues) {}
+
+    void read_queue(int queue, std::uint32_t address, void* data, std::uint32_t size_in_bytes) override {
+        if (address == get_rptr_address()) {
+            num_rptr_polls++;
+            drain(queue, 1);
+        }
+        auto& l1 = queues.at(queue).l1;
+        for (std::uint32_t i = 0; i < size_in_bytes; i++) {
+            static_cast<std::uint8_t*>(data)[i] = l1[address + i];
+        }
+    }
+    void write_queue(int queue, std::uint32_t address, const void* data, std::uint32_t size_in_bytes) override {
+        auto& l1 = queues.at(queue).l1;
+        for (std::uint32_t i = 0; i < size_in_bytes; i++) {
+            l1[address + i] = static_cast<const std::uint8_t*>(data)[i];
+        }
+        if (address == get_wptr_address()) {
+            num_wptr_publishes++;
+        } else {
+            num_commands++;
+        }
+    }
+    int get_next_queue(int queue) const override { return (queue + 1) % queues.size(); }
+    void write_sysmem(std::uint64_t address, const void* data, std::uint32_t size_in_bytes) override {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        sysmem[address] = std::vector<std::uint8_t>(bytes, bytes + size_in_bytes);
+        sysmem_writes.push_back({address, size_in_bytes});
+    }
+    std::uint64_t get_sys_addr(std::uint64_t address) const override { return address; }
+    std::uint16_t get_rack() const override { return 0; }
+
+    // Handle up to max_commands published commands of queue (all of them by default).
+    void drain(int queue, int max_commands = -1) {
+        std::uint32_t wptr = read_word(queue, get_wptr_address());
+        std::uint32_t rptr = read_word(queue, get_rptr_address());
+        for (int i = 0; rptr != wptr && i != max_commands; i++) {
+            routing_cmd_t cmd = {};
+            auto& l1 = queues.at(queue).l1;
+            const std::uint32_t cmd_address = eth_params.request_routing_cmd_queue_base + sizeof(routing_cmd_t) * (rptr & eth_params.cmd_buf_size_mask);
+            for (std::size_t b = 0; b < sizeof(cmd); b++) {
+                reinterpret_cast<std::uint8_t*>(&cmd)[b] = l1[cmd_address + b];
+            }
+            const std::vector<std::uint8_t>& block = sysmem.at(cmd.src_addr_tag);
+            remote_memory.resize(std::max<std::size_t>(remote_memory.size(), cmd.sys_addr + cmd.data));
+            std::memcpy(remote_memory.data() + cmd.sys_addr, block.data(), std::min<std::size_t>(block.size(), cmd.data));
+            rptr = (rptr + 1) & eth_params.cmd_buf_ptr_mask;
+            write_word(queue, get_rptr_address(), rptr);
+        }
+    }
+    void drain_all() {
+        for (std::size_t queue = 0; queue < queues.size(); queue++) {
+            drain(queue);
+        }
+    }
+
+    std::vector<std::uint8_t> remote_memory = {};
+    std::vector<sysmem_write> sysmem_writes = {};
+    int num_commands = 0;
+    int num_wptr_publishes = 0;
+    int num_rptr_polls = 0;
+
+    private:
+    struct queue_state {
+        std::map<std::uint32_t, std::uint8_t> l1 = {};
+    };
+
+    std::uint32_t get_wptr_address() const { return eth_params.request_cmd_queue_base + eth_params.cmd_counters_size_bytes; }
+    std::uint32_t get_rptr_address() const { return get_wptr_address() + eth_params.remote_update_ptr_size_bytes; }
+    std::uint32_t read_word(int queue, std::uint32_t address) {
+        std::uint32_t value = 0;
+        for (std::uint32_t b = 0; b < sizeof(value); b++) {
+            value |= std::uint32_t(queues.at(queue).l1[address + b]) << (8 * b);
+        }
+        return value;
+    }
+    void write_word(int queue, std::uint32_t address, std::uint32_t value) {
+        for (std::uint32_t b = 0; b < sizeof(value); b++) {
+            queues.at(queue).l1[address + b] = (value >> (8 * b)) & 0xff;
+        }
+    }
+
+    tt_driver_eth_interface_params eth_params;
+    std::vector<queue_state> queues;
+    // Data blocks by address
+    std::map<std::uint64_t, std::vector<std::uint8_t>> sysmem = {};
+};
+
+}  // namespace test_utils
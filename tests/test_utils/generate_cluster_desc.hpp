@@ -12,10 +12,28 @@
 
 namespace test_utils {
 
+// Root of the UMD checkout, found from the path this header was compiled with. CMake passes absolute paths. The Makefile
+// passes paths relative to the repo root, so the root is the closest directory (from the cwd up) that has this header.
+inline std::filesystem::path GetUMDRoot() {
+    const std::filesystem::path this_file = std::filesystem::path(__FILE__);
+    if (this_file.is_absolute()) {
+        return this_file.parent_path().parent_path().parent_path();
+    }
+    for (std::filesystem::path dir = std::filesystem::current_path(); ; dir = dir.parent_path()) {
+        if (std::filesystem::exists(dir / this_file)) {
+            return dir / this_file.parent_path().parent_path().parent_path();
+        }
+        if (dir == dir.parent_path()) {
+            break;
+        }
+    }
+    // Run from a directory next to a checkout named after the cwd (ex: a build dir holding the checkout)
+    std::filesystem::path umd_root_relative = std::filesystem::relative(this_file.parent_path().parent_path().parent_path(), "../");
+    return std::filesystem::canonical(umd_root_relative);
+}
+
 inline std::string GetAbsPath(std::string path_){
-    std::filesystem::path umd_root_relative = std::filesystem::relative(std::filesystem::path(__FILE__).parent_path().parent_path().parent_path(), "../");
-    std::filesystem::path umd_root = std::filesystem::canonical(umd_root_relative);
-    std::filesystem::path abs_path = umd_root / path_;
+    std::filesystem::path abs_path = GetUMDRoot() / path_;
     return abs_path.string();
 }
 
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "device/tt_hugepage_channel.h"
+
+namespace test_utils {
+
+// Stand-in for hugetlbfs and the kernel driver when backing host memory channels without hardware.
+// Channels are mapped from anonymous memory. The pages of a channel are laid out in physically contiguous runs of
+// physical_runs[i] pages, with a gap between runs. Contiguous pins succeed behind an IOMMU (which hands out contiguous
+// IOVAs), and otherwise only for ranges inside one run.
+class hugepage_model {
+    public:
+    struct pin_request {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    std::size_t page_size = 2 << 20;
+    bool has_mount = true;
+    bool iommu = false;
+    std::vector<std::uint64_t> physical_runs = {};
+
+    std::vector<pin_request> pins = {};
+    int num_maps = 0;
+    int num_unmaps = 0;
+
+    tt_hugepage_ops get_ops() {
+        tt_hugepage_ops ops = {};
+        ops.find_dir = [this] (std::size_t size) { return has_mount && size == page_size ? std::string("/dev/hugepages-test") : std::string(); };
+        ops.map = [this] (const std::string& dir, std::uint16_t channel, std::uint64_t size) -> void* {
+            void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapping == MAP_FAILED) {
+                return nullptr;
+            }
+            num_maps++;
+            base = static_cast<std::uint8_t*>(mapping);
+            return mapping;
+        };
+        ops.unmap = [this] (void* mapping, std::uint64_t size) {
+            num_unmaps++;
+            munmap(mapping, size);
+        };
+        ops.pin = [this] (std::uint16_t channel, void* address, std::uint64_t size, std::uint64_t& iova) {
+            const std::uint64_t offset = static_cast<std::uint8_t*>(address) - base;
+            pins.push_back({offset, size});
+            if (iommu) {
+                iova = next_iova;
+                next_iova += size;
+                return true;
+            }
+            std::uint64_t run_start = 0;
+            for (std::size_t run = 0; run < physical_runs.size(); run++) {
+                const std::uint64_t run_size = physical_runs[run] * page_size;
+                if (offset >= run_start && offset + size <= run_start + run_size) {
+                    iova = get_physical_address(run) + (offset - run_start);
+                    return true;
+                }
+                run_start += run_size;
+            }
+            return false;
+        };
+        return ops;
+    }
+
+    // Runs start 1GB apart, so consecutive runs are never physically contiguous.
+    static std::uint64_t get_physical_address(std::size_t run) { return 0x100000000 + run * (std::uint64_t(1) << 30); }
+
+    private:
+    std::uint8_t* base = nullptr;
+    std::uint64_t next_iova = 0xfff00000;
+};
+
+}  // namespace test_utils
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <hwloc.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace test_utils {
+
+// Synthetic hwloc topology of a host, to check CPU placement decisions without the host's real topology.
+// The machine has num_packages packages, each with its own NUMA node and num_l3_per_package L3 caches (or none, if 0,
+// in which case the cores are directly under the package). Each L3 has num_cores_per_l3 cores of num_pus_per_core PUs.
+// PU os indices are assigned in order, so the PUs of core c of package p are contiguous. Tenstorrent PCI devices are
+// attached behind a bridge of their package, or of the machine (package -1).
+class hwloc_topology_model {
+    public:
+    struct pci_device {
+        std::string bus_id; // ex: 0000:41:00.0
+        int package;
+    };
+
+    int num_packages = 1;
+    int num_l3_per_package = 1;
+    int num_cores_per_l3 = 1;
+    int num_pus_per_core = 1;
+    std::vector<pci_device> pci_devices = {};
+
+    hwloc_topology_model() = default;
+    ~hwloc_topology_model() { unload(); }
+    hwloc_topology_model(const hwloc_topology_model&) = delete;
+    hwloc_topology_model& operator=(const hwloc_topology_model&) = delete;
+
+    int get_num_cores_per_package() const { return std::max(num_l3_per_package, 1) * num_cores_per_l3; }
+    int get_num_pus_per_package() const { return get_num_cores_per_package() * num_pus_per_core; }
+    // os index of the first PU of a core, with cores numbered across the machine
+    int get_first_pu_of_core(int core) const { return core * num_pus_per_core; }
+
+    // Build the topology from the parameters above. The model owns it until it is destroyed or loaded again.
+    hwloc_topology_t load() {
+        unload();
+        const std::string xml = to_xml();
+        hwloc_topology_init(&topology);
+        hwloc_topology_set_type_filter(topology, HWLOC_OBJ_PCI_DEVICE, HWLOC_TYPE_FILTER_KEEP_ALL);
+        hwloc_topology_set_type_filter(topology, HWLOC_OBJ_BRIDGE, HWLOC_TYPE_FILTER_KEEP_ALL);
+        if (hwloc_topology_set_xmlbuffer(topology, xml.c_str(), xml.size() + 1) != 0 || hwloc_topology_load(topology) != 0) {
+            hwloc_topology_destroy(topology);
+            topology = nullptr;
+            throw std::runtime_error("Failed to load synthetic hwloc topology");
+        }
+        return topology;
+    }
+
+    hwloc_obj_t get_pci_device(const std::string& bus_id) const {
+        return hwloc_get_pcidev_by_busidstring(topology, bus_id.c_str());
+    }
+
+    std::string to_xml() const {
+        const int pus_per_package = get_num_pus_per_package();
+        std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<!DOCTYPE topology SYSTEM \"hwloc2.dtd\">\n<topology version=\"2.0\">\n";
+        xml += "<object type=\"Machine\" os_index=\"0\"" + sets(0, num_packages * pus_per_package, 0, num_packages) +
+               " allowed_cpuset=\"" + bitmap(0, num_packages * pus_per_package) + "\" allowed_nodeset=\"" + bitmap(0, num_packages) + "\">\n";
+        int pu = 0;
+        int core = 0;
+        for (int package = 0; package < num_packages; package++) {
+            const std::string node = sets(package * pus_per_package, pus_per_package, package, 1);
+            xml += "<object type=\"Package\" os_index=\"" + std::to_string(package) + "\"" + node + ">\n";
+            xml += "<object type=\"NUMANode\" os_index=\"" + std::to_string(package) + "\"" + node + " local_memory=\"1073741824\"/>\n";
+            for (int l3 = 0; l3 < std::max(num_l3_per_package, 1); l3++) {
+                if (num_l3_per_package > 0) {
+                    xml += "<object type=\"L3Cache\"" + sets(pu, num_cores_per_l3 * num_pus_per_core, package, 1) +
+                           " cache_size=\"16777216\" depth=\"3\" cache_linesize=\"64\" cache_associativity=\"0\" cache_type=\"0\">\n";
+                }
+                for (int c = 0; c < num_cores_per_l3; c++, core++) {
+                    xml += "<object type=\"Core\" os_index=\"" + std::to_string(core) + "\"" + sets(pu, num_pus_per_core, package, 1) + ">\n";
+                    for (int p = 0; p < num_pus_per_core; p++, pu++) {
+                        xml += "<object type=\"PU\" os_index=\"" + std::to_string(pu) + "\"" + sets(pu, 1, package, 1) + "/>\n";
+                    }
+                    xml += "</object>\n";
+                }
+                if (num_l3_per_package > 0) {
+                    xml += "</object>\n";
+                }
+            }
+            xml += pci_bridges(package);
+            xml += "</object>\n";
+        }
+        xml += pci_bridges(-1);
+        xml += "</object>\n</topology>\n";
+        return xml;
+    }
+
+    private:
+    static std::string bitmap(int first, int count) {
+        hwloc_bitmap_t set = hwloc_bitmap_alloc();
+        if (count > 0) {
+            hwloc_bitmap_set_range(set, first, first + count - 1);
+        }
+        char* str = nullptr;
+        hwloc_bitmap_asprintf(&str, set);
+        const std::string result = str;
+        std::free(str);
+        hwloc_bitmap_free(set);
+        return result;
+    }
+
+    static std::string sets(int first_pu, int num_pus, int first_node, int num_nodes) {
+        const std::string cpuset = bitmap(first_pu, num_pus);
+        const std::string nodeset = bitmap(first_node, num_nodes);
+        return " cpuset=\"" + cpuset + "\" complete_cpuset=\"" + cpuset + "\" nodeset=\"" + nodeset + "\" complete_nodeset=\"" + nodeset + "\"";
+    }
+
+    std::string pci_bridges(int package) const {
+        std::string xml = "";
+        for (const auto& device : pci_devices) {
+            if (device.package != package) {
+                continue;
+            }
+            // Host bridge to the device's bus: "0000:41:00.0" -> "0000:[41-41]"
+            const std::string bus = device.bus_id.substr(5, 2);
+            xml += "<object type=\"Bridge\" bridge_type=\"0-1\" depth=\"0\" bridge_pci=\"" + device.bus_id.substr(0, 5) + "[" + bus + "-" + bus + "]\">\n";
+            xml += "<object type=\"PCIDev\" pci_busid=\"" + device.bus_id + "\" pci_type=\"1200 [1e52:401e] [1e52:0035] 00\" pci_link_speed=\"0.000000\"/>\n";
+            xml += "</object>\n";
+        }
+        return xml;
+    }
+
+    void unload() {
+        if (topology) {
+            hwloc_topology_destroy(topology);
+            topology = nullptr;
+        }
+    }
+
+    hwloc_topology_t topology = nullptr;
+};
+
+}  // namespace test_utils
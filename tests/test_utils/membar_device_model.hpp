@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "device/tt_membar.h"
+
+namespace test_utils {
+
+// Stand-in for a chip when exercising memory barriers without hardware.
+// Writes become visible to reads of the same core after visibility_delay reads, emulating posted writes still in flight.
+// Multicast writes are supported for multicast_cores, and write every core in the rectangle, even ones outside that set.
+// Each access busy-waits for the configured latency, emulating a PCIe round trip.
+class membar_device_model : public tt_membar_io {
+    public:
+    struct access {
+        bool is_write;
+        tt_xy_pair core;
+        std::uint32_t address;
+    };
+
+    std::chrono::nanoseconds write_latency = std::chrono::nanoseconds(0);
+    std::chrono::nanoseconds read_latency = std::chrono::nanoseconds(0);
+    int visibility_delay = 0;
+    std::unordered_set<tt_xy_pair> multicast_cores = {};
+
+    std::vector<access> accesses = {};
+    int num_writes = 0;
+    int num_multicasts = 0;
+    int num_reads = 0;
+    int num_flushes = 0;
+    int num_fences = 0;
+
+    void write_word(const tt_xy_pair& core, std::uint32_t address, std::uint32_t value) override {
+        wait(write_latency);
+        num_writes++;
+        accesses.push_back({true, core, address});
+        in_flight[{core, address}] = {value, visibility_delay};
+    }
+
+    bool can_multicast_to(const tt_xy_pair& core) const override {
+        return multicast_cores.find(core) != multicast_cores.end();
+    }
+
+    void multicast_write_word(const tt_xy_pair& start, const tt_xy_pair& end, std::uint32_t address, std::uint32_t value) override {
+        wait(write_latency);
+        num_multicasts++;
+        for (std::size_t y = start.y; y <= end.y; y++) {
+            for (std::size_t x = start.x; x <= end.x; x++) {
+                accesses.push_back({true, tt_xy_pair(x, y), address});
+                in_flight[{tt_xy_pair(x, y), address}] = {value, visibility_delay};
+            }
+        }
+    }
+
+    std::uint32_t read_word(const tt_xy_pair& core, std::uint32_t address) override {
+        wait(read_latency);
+        num_reads++;
+        accesses.push_back({false, core, address});
+        auto write = in_flight.find({core, address});
+        if (write != in_flight.end()) {
+            if (write->second.second-- <= 0) {
+                memory[{core, address}] = write->second.first;
+                in_flight.erase(write);
+            }
+        }
+        auto word = memory.find({core, address});
+        return word == memory.end() ? 0 : word->second;
+    }
+
+    void flush_writes() override { num_flushes++; }
+    void fence() override { num_fences++; }
+
+    std::uint32_t get_word(const tt_xy_pair& core, std::uint32_t address) const {
+        auto word = memory.find({core, address});
+        return word == memory.end() ? 0 : word->second;
+    }
+
+    void reset_counters() {
+        accesses.clear();
+        num_writes = 0;
+        num_multicasts = 0;
+        num_reads = 0;
+        num_flushes = 0;
+        num_fences = 0;
+    }
+
+    private:
+    static void wait(std::chrono::nanoseconds latency) {
+        if (latency.count() == 0) {
+            return;
+        }
+        const auto end = std::chrono::steady_clock::now() + latency;
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+
+    std::map<std::pair<tt_xy_pair, std::uint32_t>, std::uint32_t> memory = {};
+    std::map<std::pair<tt_xy_pair, std::uint32_t>, std::pair<std::uint32_t, int>> in_flight = {};
+};
+
+}  // namespace test_utils
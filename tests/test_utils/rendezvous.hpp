@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace test_utils {
+
+// Checks that num_threads threads run at the same time, without relying on how long anything takes.
+// Each thread arrives and waits for the others. arrive_and_wait returns false if they didn't all arrive before the
+// timeout, which only happens if the threads were run one after the other.
+class rendezvous {
+    public:
+    explicit rendezvous(int num_threads) : num_threads(num_threads) {}
+
+    bool arrive_and_wait(std::chrono::milliseconds timeout = std::chrono::seconds(10)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        num_arrived++;
+        arrived.notify_all();
+        return arrived.wait_for(lock, timeout, [this] { return num_arrived >= num_threads; });
+    }
+
+    int get_num_arrived() {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return num_arrived;
+    }
+
+    private:
+    const int num_threads;
+    int num_arrived = 0;
+    std::mutex mutex;
+    std::condition_variable arrived;
+};
+
+}  // namespace test_utils
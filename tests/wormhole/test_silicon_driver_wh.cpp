@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: (c) 2023 Tenstorrent Inc.
 //
 // SPDX-License-Identifier: Apache-2.0
+#include <cstring>
 #include <thread>
 #include <memory>
 
@@ -581,6 +582,58 @@ TEST(SiliconDriverWH, BroadcastWrite) {
     device.close_device();    
 }
 
+TEST(SiliconDriverWH, BroadcastWriteWithPlan) {
+    // Create the tensix and dram broadcast plans once, and reuse them for every broadcast. Verify broadcasted data is read back correctly
+    std::set<chip_id_t> target_devices = get_target_devices();
+
+    std::unordered_map<std::string, std::int32_t> dynamic_tlb_config = {}; // Don't set any dynamic TLBs in this test
+    uint32_t num_host_mem_ch_per_mmio_device = 1;
+    
+    tt_SiliconDevice device = tt_SiliconDevice(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"), test_utils::GetClusterDescYAML(), target_devices, num_host_mem_ch_per_mmio_device, dynamic_tlb_config, false, true, true);
+    set_params_for_remote_txn(device);
+
+    tt_device_params default_params;
+    device.start_device(default_params);
+    device.deassert_risc_reset();
+    std::vector<uint32_t> broadcast_sizes = {1, 16, 256, 4096};
+    uint32_t address = l1_mem::address_map::DATA_BUFFER_SPACE_BASE;
+    std::set<uint32_t> rows_to_exclude = {0, 6};
+    const tt_broadcast_plan tensix_plan = device.create_broadcast_plan({}, rows_to_exclude, {0, 5});
+    const tt_broadcast_plan dram_plan = device.create_broadcast_plan({}, {}, {1, 2, 3, 4, 6, 7, 8, 9});
+    ASSERT_EQ(tensix_plan.target_chips, target_devices);
+
+    for(const auto& size : broadcast_sizes) {
+        std::vector<uint32_t> vector_to_write(size);
+        std::vector<uint32_t> zeros(size, 0);
+        std::vector<uint32_t> readback_vec = {};
+        for(int i = 0; i < size; i++) {
+            vector_to_write[i] = i;
+        }
+        device.broadcast_write_to_cluster(vector_to_write.data(), vector_to_write.size() * 4, address, tensix_plan, "LARGE_WRITE_TLB");
+        device.broadcast_write_to_cluster(vector_to_write.data(), vector_to_write.size() * 4, address, dram_plan, "LARGE_WRITE_TLB");
+        device.wait_for_non_mmio_flush();
+
+        for(const auto i : target_devices) {
+            for(const auto& core : device.get_virtual_soc_descriptors().at(i).workers) {
+                if(rows_to_exclude.find(core.y) != rows_to_exclude.end()) continue;
+                device.read_from_device(readback_vec, tt_cxy_pair(i, core), address, vector_to_write.size() * 4, "LARGE_READ_TLB");
+                ASSERT_EQ(vector_to_write, readback_vec) << "Vector read back from core " << core.x << "-" << core.y << "does not match what was broadcasted";
+                device.write_to_device(zeros, tt_cxy_pair(i, core), address, "LARGE_WRITE_TLB"); // Clear any written data
+                readback_vec = {};
+            }
+            for(int chan = 0; chan < device.get_virtual_soc_descriptors().at(i).get_num_dram_channels(); chan++) {
+                const auto& core = device.get_virtual_soc_descriptors().at(i).get_core_for_dram_channel(chan, 0);
+                device.read_from_device(readback_vec, tt_cxy_pair(i, core), address, vector_to_write.size() * 4, "LARGE_READ_TLB");
+                ASSERT_EQ(vector_to_write, readback_vec) << "Vector read back from DRAM core " << i << " " << core.x << "-" << core.y << " does not match what was broadcasted " << size;
+                device.write_to_device(zeros, tt_cxy_pair(i, core), address, "LARGE_WRITE_TLB"); // Clear any written data
+                readback_vec = {};
+            }
+        }
+        device.wait_for_non_mmio_flush();
+    }
+    device.close_device();
+}
+
 TEST(SiliconDriverWH, VirtualCoordinateBroadcast) {
     // Broadcast multiple vectors to tensix and dram grid. Verify broadcasted data is read back correctly
     std::set<chip_id_t> target_devices = get_target_devices();
@@ -644,3 +697,92 @@ TEST(SiliconDriverWH, VirtualCoordinateBroadcast) {
     }
     device.close_device();    
 }
+
+TEST(SiliconDriverWH, MapSysmemMatchesCopyAPIs) {
+    std::set<chip_id_t> target_devices = {0};
+    uint32_t num_host_mem_ch_per_mmio_device = 1;
+    tt_SiliconDevice device = tt_SiliconDevice(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"), test_utils::GetClusterDescYAML(), target_devices, num_host_mem_ch_per_mmio_device, {}, false, true, true);
+
+    std::vector<uint32_t> data = {1, 2, 3, 4, 5, 6, 7, 8};
+    device.write_to_sysmem(data, 0x1000, 0, 0);
+    const tt_sysmem_span view = device.map_sysmem(0, 0, 0x1000, data.size() * sizeof(uint32_t));
+    ASSERT_EQ(std::memcmp(view.data, data.data(), view.size), 0);
+
+    reinterpret_cast<uint32_t*>(view.data)[0] = 42;
+    std::vector<uint32_t> readback = {};
+    device.read_from_sysmem(readback, 0x1000, 0, data.size() * sizeof(uint32_t), 0);
+    ASSERT_EQ(readback.at(0), 42);
+    ASSERT_THROW(device.map_sysmem(0, 0, device.get_host_channel_size(0, 0), 4), std::runtime_error);
+    device.close_device();
+}
+
+TEST(SiliconDriverWH, AsyncIOMatchesBlockingAPIs) {
+    std::set<chip_id_t> target_devices = {0};
+    uint32_t num_host_mem_ch_per_mmio_device = 1;
+    std::unordered_map<std::string, std::int32_t> dynamic_tlb_config = {};
+    dynamic_tlb_config.insert({"SMALL_READ_WRITE_TLB", 157});
+    tt_SiliconDevice device = tt_SiliconDevice(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"), test_utils::GetClusterDescYAML(), target_devices, num_host_mem_ch_per_mmio_device, dynamic_tlb_config, false, true, true);
+    tt_device_params default_params;
+    device.start_device(default_params);
+    device.start_io_workers(2);
+    ASSERT_GE(device.get_num_io_workers(0), 1);
+
+    const std::uint32_t address = l1_mem::address_map::NCRISC_FIRMWARE_BASE;
+    const auto& workers = device.get_virtual_soc_descriptors().at(0).workers;
+    std::vector<std::vector<uint32_t>> data = {};
+    std::vector<tt_device_write> writes = {};
+    for (std::size_t i = 0; i < workers.size(); i++) {
+        data.push_back(std::vector<uint32_t>(8, i));
+    }
+    for (std::size_t i = 0; i < workers.size(); i++) {
+        writes.push_back({data.at(i).data(), static_cast<uint32_t>(data.at(i).size() * sizeof(uint32_t)), tt_cxy_pair(0, workers.at(i)), address});
+    }
+    device.write_to_device_async(writes, "SMALL_READ_WRITE_TLB").get();
+    device.l1_membar_async(0, "SMALL_READ_WRITE_TLB").get();
+    for (std::size_t i = 0; i < workers.size(); i++) {
+        std::vector<uint32_t> readback = std::vector<uint32_t>(data.at(i).size());
+        device.read_from_device_async(readback.data(), tt_cxy_pair(0, workers.at(i)), address, readback.size() * sizeof(uint32_t), "SMALL_READ_WRITE_TLB").get();
+        ASSERT_EQ(readback, data.at(i)) << "Core " << workers.at(i).str();
+    }
+
+    std::vector<uint32_t> staged = {1, 2, 3, 4, 5, 6, 7, 8};
+    device.write_to_sysmem_async(staged.data(), staged.size() * sizeof(uint32_t), 0x1000, 0, 0).get();
+    std::vector<uint32_t> readback = {};
+    device.read_from_sysmem(readback, 0x1000, 0, staged.size() * sizeof(uint32_t), 0);
+    ASSERT_EQ(readback, staged);
+    std::vector<uint32_t> readback_async = std::vector<uint32_t>(staged.size());
+    device.read_from_sysmem_async(readback_async.data(), 0x1000, 0, staged.size() * sizeof(uint32_t), 0).get();
+    ASSERT_EQ(readback_async, staged);
+    device.close_device();
+}
+
+TEST(SiliconDriverWH, NumaVectorsMatchStdVectorAPIs) {
+    std::set<chip_id_t> target_devices = {0};
+    uint32_t num_host_mem_ch_per_mmio_device = 1;
+    std::unordered_map<std::string, std::int32_t> dynamic_tlb_config = {};
+    dynamic_tlb_config.insert({"SMALL_READ_WRITE_TLB", 157});
+    tt_SiliconDevice device = tt_SiliconDevice(test_utils::GetAbsPath("tests/soc_descs/wormhole_b0_8x10.yaml"), test_utils::GetClusterDescYAML(), target_devices, num_host_mem_ch_per_mmio_device, dynamic_tlb_config, false, true, true);
+    tt_device_params default_params;
+    device.start_device(default_params);
+
+    const tt_cxy_pair core = tt_cxy_pair(0, device.get_virtual_soc_descriptors().at(0).workers.at(0));
+    const std::uint32_t address = l1_mem::address_map::NCRISC_FIRMWARE_BASE;
+    tt::numa_vector vec = tt::numa_vector({1, 2, 3, 4, 5, 6, 7, 8}, device.get_numa_allocator(0));
+    std::vector<uint32_t> readback = {};
+
+    device.write_to_device(vec, core, address, "SMALL_READ_WRITE_TLB");
+    device.read_from_device(readback, core, address, vec.size() * sizeof(uint32_t), "SMALL_READ_WRITE_TLB");
+    ASSERT_EQ(std::vector<uint32_t>(vec.begin(), vec.end()), readback);
+    tt::numa_vector numa_readback = tt::numa_vector(device.get_numa_allocator(0));
+    device.read_from_device(numa_readback, core, address, vec.size() * sizeof(uint32_t), "SMALL_READ_WRITE_TLB");
+    ASSERT_EQ(numa_readback, vec);
+
+    device.rolled_write_to_device(vec, 2, core, address, "SMALL_READ_WRITE_TLB");
+    device.read_from_device(numa_readback, core, address + vec.size() * sizeof(uint32_t), vec.size() * sizeof(uint32_t), "SMALL_READ_WRITE_TLB");
+    ASSERT_EQ(numa_readback, vec);
+
+    device.write_to_sysmem(vec, 0x1000, 0, 0);
+    device.read_from_sysmem(numa_readback, 0x1000, 0, vec.size() * sizeof(uint32_t), 0);
+    ASSERT_EQ(numa_readback, vec);
+    device.close_device();
+}